@@ -6,7 +6,6 @@
 #include <cstddef>
 #include <cassert>
 #include <array>
-#include <functional>
 
 #include <ExampleLexer.h>
 #include <ExampleParser.h>
@@ -69,10 +68,9 @@ int main(int argc, char* argv[]) {
     input.close();
     palex::ExampleLexer lexer(file_contents);
     ExampleASTBuilder builder{};
-    palex::ExampleParser parser(
+    palex::ExampleBasicParser<palex::ExampleLexer, palex::ExampleASTBuilderBase> parser(
         builder,
-        std::bind(&palex::ExampleLexer::next_unignored_token, &lexer),
-        std::bind(&palex::ExampleLexer::current_token, &lexer),
+        lexer,
         palex::make_default_parse_error_handler(input_file_path, file_contents)
     );
     try {
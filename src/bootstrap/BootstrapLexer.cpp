@@ -75,6 +75,16 @@ namespace bootstrap {
         if (this->try_ascii_constant("$S", TokenInfo::TokenType::ENTRY_PRODUCTION)) {
             return;
         }
+        if (
+            this->try_ascii_constant("%left", TokenInfo::TokenType::PRECEDENCE) || 
+            this->try_ascii_constant("%right", TokenInfo::TokenType::PRECEDENCE) || 
+            this->try_ascii_constant("%nonassoc", TokenInfo::TokenType::PRECEDENCE)
+        ) {
+            return;
+        }
+        if (this->try_ascii_constant("%transparent", TokenInfo::TokenType::TRANSPARENT)) {
+            return;
+        }
 
         const utf8::Codepoint_t next = utf8::get_next_codepoint(this->position, this->input.end());
         if (std::isspace((int)next)) {
@@ -2,7 +2,7 @@
 
 #include <array>
 
-const std::array<std::string_view, 11> TOKEN_TYPE_TO_STRING {
+const std::array<std::string_view, 14> TOKEN_TYPE_TO_STRING {
     "UNDEFINED",
     "END_OF_FILE",
     "IGNORE",
@@ -13,6 +13,9 @@ const std::array<std::string_view, 11> TOKEN_TYPE_TO_STRING {
     "TOKEN",
     "EQ",
     "EOL",
+    "PRODUCTION_TAG",
+    "PRECEDENCE",
+    "TRANSPARENT",
     "WSPACE"
 };
 
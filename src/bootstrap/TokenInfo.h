@@ -27,6 +27,8 @@ namespace bootstrap {
             EQ,
             EOL,
             PRODUCTION_TAG,
+            PRECEDENCE,
+            TRANSPARENT,
             WSPACE
         };
 
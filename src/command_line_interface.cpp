@@ -43,6 +43,9 @@ namespace cli {
             if (config.language == input::Language::NONE) {
                 throw palex_except::ValidationError("No target language supplied!");
             }
+            if (config.amalgamate && config.shard_count > 1) {
+                throw palex_except::ValidationError("The shards option can't be combined with the --amalgamate flag!");
+            }
             for (const std::string& rule_file_path : config.rule_files) {
                 std::cout << "Processing rule file '" << rule_file_path << "'..." << std::endl;
                 const std::optional<RuleFileInfo> rule_file_info = load_rule_file(rule_file_path);
@@ -72,14 +75,23 @@ void print_help_page(const std::string& program_name) {
               << "  -output-path <path>         Output folder for lexer and parser files (default: current directory).\n"
               << "  -util-path <path>           Output (and import) folder for util files (default: current directory).\n"
               << "  -lang <C++|CPP>             The target programming language (mandatory).\n"
-              << "  -parser-type <LR|LALR>      The type of the generated parsers (mandatory when --parser flag is set).\n"
+              << "  -parser-type <LR|LALR|PGM>  The type of the generated parsers (mandatory when --parser flag is set).\n"
               << "  -lookahead <uint>           Lookahead token count (integer >= 0).\n"
-              << "  -module-name <name>         The name of the module/namespace of the generated code (default: palex).\n\n"
+              << "  -module-name <name>         The name of the module/namespace of the generated code (default: palex).\n"
+              << "  -shards <uint>              Splits the generated lexer and parser states into this many source files (default: 1).\n"
+              << "  -stack-capacity <uint>      Parser stack entries that are stored inside the parser before it allocates (default: 64).\n"
+              << "  -stack-growth <uint>        Factor by which the parser stack grows once it is full (integer >= 2, default: 2).\n"
+              << "  -threads <uint>             Threads generating the parser table (default: 0, one per hardware thread).\n"
+              << "  -cache-path <path>          Folder for cached lexer automatons and parser tables (default: no caching).\n\n"
               << "Flags:\n"
               << "  --lexer                     Enable lexer generation.\n"
               << "  --parser                    Enable parser generation.\n"
               << "  --util                      Enable generation of utility files.\n"
               << "  --fallback                  Enables token fallback for lexers. \n"
+              << "  --counters                  Enables counter states for bounded repetitions in lexers.\n"
+              << "  --amalgamate                Generates the lexer and the parser as single, header-only files.\n"
+              << "  --table-driven              Generates parsers that interpret compressed action and goto tables.\n"
+              << "  --adaptive-lookahead        Generated parsers only test more lookahead tokens (up to -lookahead) in the states that need them.\n"
     ;         
 }
 
@@ -4,6 +4,7 @@
 #include <sstream>
 #include <string>
 #include <string_view>
+#include <set>
 #include <cassert>
 
 #include "util/palex_except.h"
@@ -11,6 +12,8 @@
 
 #include "regex/RegexParser.h"
 
+#include "parser_generator/validation.h"
+
 // helper functions
 std::string_view strip_ends(const std::string_view& to_strip);
 
@@ -27,9 +30,15 @@ namespace input {
 
     PalexRules PalexRuleParser::parse_all_rules() {
         std::vector<lexer_generator::TokenDefinition> token_definitions = this->parse_all_token_definitions(); // not const because of unique_ptr move
+        const parser_generator::PrecedenceTable_t precedence_table = this->parse_all_precedence_declarations();
+        std::set<std::string> token_names;
+        for (const lexer_generator::TokenDefinition& token_definition : token_definitions) {
+            token_names.insert(token_definition.name);
+        }
+        parser_generator::check_for_undefined_precedence_tokens(precedence_table, token_names); // a misspelled token would silently leave its conflicts unresolved
         const std::vector<parser_generator::Production> productions = this->parse_all_productions();
         assert(this->accept(bootstrap::TokenInfo::TokenType::END_OF_FILE) && "Bug: Parser didn't reach EOF after parsing finished!");
-        return PalexRules{std::move(token_definitions), productions};
+        return PalexRules{std::move(token_definitions), productions, precedence_table};
     }
 
     std::vector<lexer_generator::TokenDefinition> PalexRuleParser::parse_all_token_definitions() {
@@ -42,6 +51,15 @@ namespace input {
         return token_definitions;        
     }
 
+    parser_generator::PrecedenceTable_t PalexRuleParser::parse_all_precedence_declarations() {
+        parser_generator::PrecedenceTable_t precedence_table;
+        size_t level = 0; // later declarations bind tighter
+        while (this->try_parse_precedence_declaration(level, precedence_table)) {
+            level++;
+        }
+        return precedence_table;
+    }
+
     std::vector<parser_generator::Production> PalexRuleParser::parse_all_productions() {
         std::vector<parser_generator::Production> productions;
         std::optional<parser_generator::Production> next_production = this->try_parse_production();
@@ -56,7 +74,9 @@ namespace input {
         if (
             this->accept(bootstrap::TokenInfo::TokenType::END_OF_FILE) || 
             this->accept(bootstrap::TokenInfo::TokenType::PRODUCTION) || 
-            this->accept(bootstrap::TokenInfo::TokenType::ENTRY_PRODUCTION)
+            this->accept(bootstrap::TokenInfo::TokenType::ENTRY_PRODUCTION) ||
+            this->accept(bootstrap::TokenInfo::TokenType::PRECEDENCE) ||
+            this->accept(bootstrap::TokenInfo::TokenType::TRANSPARENT)
         ) {
             return std::nullopt;
         }
@@ -90,6 +110,28 @@ namespace input {
         return parsed;
     }
 
+    bool PalexRuleParser::try_parse_precedence_declaration(const size_t level, parser_generator::PrecedenceTable_t& target) {
+        using parser_generator::Associativity;
+
+        if (!this->accept(bootstrap::TokenInfo::TokenType::PRECEDENCE)) {
+            return false;
+        }
+        const std::string_view declaration = this->consume().identifier;
+        const Associativity associativity = declaration == "%left" ? Associativity::LEFT : (
+            declaration == "%right" ? Associativity::RIGHT : Associativity::NONASSOC
+        );
+        this->expect(bootstrap::TokenInfo::TokenType::TOKEN);
+        while (this->accept(bootstrap::TokenInfo::TokenType::TOKEN)) {
+            const std::string terminal(this->curr_token().identifier);
+            if (!target.insert({terminal, parser_generator::OperatorPrecedence{level, associativity}}).second) {
+                this->throw_error("The precedence of the token '" + terminal + "' is declared more than once!");
+            }
+            this->consume();
+        }
+        this->consume(bootstrap::TokenInfo::TokenType::EOL);
+        return true;
+    }
+
     std::optional<parser_generator::Production> PalexRuleParser::try_parse_production() {
         if (this->accept(bootstrap::TokenInfo::TokenType::END_OF_FILE)) {
             return std::nullopt;
@@ -104,7 +146,11 @@ namespace input {
                 " All token definitions have to stand before the first production."
             );
         }
+        if (this->accept(bootstrap::TokenInfo::TokenType::PRECEDENCE)) {
+            this->throw_error("Found a precedence declaration in the production block! All of them have to stand before the first production.");
+        }
         parser_generator::Production parsed{};
+        parsed.transparent = this->consume_if(bootstrap::TokenInfo::TokenType::TRANSPARENT);
         if (!this->accept(bootstrap::TokenInfo::TokenType::PRODUCTION) && !this->accept(bootstrap::TokenInfo::TokenType::ENTRY_PRODUCTION)) {
             this->expect(bootstrap::TokenInfo::TokenType::PRODUCTION); // error because no production was given
         }
@@ -5,6 +5,7 @@
 
 #include "lexer_generator/token_definition.h"
 #include "parser_generator/production_definition.h"
+#include "parser_generator/operator_precedence.h"
 
 #include "bootstrap/TokenInfo.h"
 
@@ -12,6 +13,7 @@ namespace input {
     struct PalexRules {
         std::vector<lexer_generator::TokenDefinition> token_definitions;
         std::vector<parser_generator::Production> productions;
+        parser_generator::PrecedenceTable_t precedence_table;
     };
 
     class PalexRuleParser {
@@ -22,8 +24,10 @@ namespace input {
             PalexRuleParser(NextTokenFunc_t next_token, CurrTokenFunc_t curr_token);
             PalexRules parse_all_rules();
             std::vector<lexer_generator::TokenDefinition> parse_all_token_definitions();
+            parser_generator::PrecedenceTable_t parse_all_precedence_declarations();
             std::vector<parser_generator::Production> parse_all_productions();
             std::optional<lexer_generator::TokenDefinition> try_parse_token_definition();
+            bool try_parse_precedence_declaration(const size_t level, parser_generator::PrecedenceTable_t& target);
             std::optional<parser_generator::Production> try_parse_production();
             ~PalexRuleParser();
         private:
@@ -18,6 +18,11 @@ namespace input {
     void parse_lang(const std::string& language, PalexConfig& target);
     void parse_parser_type(const std::string& parser_type, PalexConfig& target);
     void parse_lookahead(const std::string& lookahead, PalexConfig& target);
+    void parse_shard_count(const std::string& shard_count, PalexConfig& target);
+    void parse_stack_capacity(const std::string& stack_capacity, PalexConfig& target);
+    void parse_stack_growth_factor(const std::string& growth_factor, PalexConfig& target);
+    void parse_thread_count(const std::string& thread_count, PalexConfig& target);
+    size_t parse_number(const std::string& number, const std::string& option_name);
     void parse_module_name(const std::string& module_name, PalexConfig& target);
 
     std::vector<std::string> convert_args(const int argc, const char** argv) {
@@ -58,6 +63,14 @@ namespace input {
             target.generate_util = true;
         } else if (flag == "fallback") {
             target.lexer_fallback = true;
+        } else if (flag == "counters") {
+            target.lexer_counters = true;
+        } else if (flag == "amalgamate") {
+            target.amalgamate = true;
+        } else if (flag == "table-driven") {
+            target.table_driven_parser = true;
+        } else if (flag == "adaptive-lookahead") {
+            target.adaptive_lookahead = true;
         } else {
             throw palex_except::ParserError("Unknown flag '--" + flag + "' supplied!");
         }
@@ -76,6 +89,16 @@ namespace input {
             parse_lookahead(parameter, target);
         } else if (type == "module-name") {
             parse_module_name(parameter, target);
+        } else if (type == "shards") {
+            parse_shard_count(parameter, target);
+        } else if (type == "stack-capacity") {
+            parse_stack_capacity(parameter, target);
+        } else if (type == "stack-growth") {
+            parse_stack_growth_factor(parameter, target);
+        } else if (type == "threads") {
+            parse_thread_count(parameter, target);
+        } else if (type == "cache-path") {
+            target.cache_path = parameter;
         } else {
             throw palex_except::ParserError("Unknown option '-" + type + " " + parameter + "' supplied!");
         }
@@ -96,22 +119,51 @@ namespace input {
             target.parser_type = ParserType::LALR;
         } else if (parser_type_lowercase == "lr") {
             target.parser_type = ParserType::LR;
+        } else if (parser_type_lowercase == "pgm") {
+            target.parser_type = ParserType::PGM;
         } else {
             throw palex_except::ParserError("Unknown parser type '" + parser_type + "' supplied to parser type option!");
         }
     }
 
     void parse_lookahead(const std::string& lookahead, PalexConfig& target) {
-        if (!std::all_of(lookahead.begin(), lookahead.end(), [](const char to_check) -> bool { return std::isdigit(to_check); })) {
-            throw palex_except::ParserError("Invalid number '" + lookahead + "' supplied to lookahead option!");
+        target.lookahead = parse_number(lookahead, "lookahead");
+    }
+
+    void parse_shard_count(const std::string& shard_count, PalexConfig& target) {
+        target.shard_count = parse_number(shard_count, "shards");
+        if (target.shard_count == 0) {
+            throw palex_except::ParserError("The shards option requires at least one shard!");
+        }
+    }
+
+    void parse_stack_capacity(const std::string& stack_capacity, PalexConfig& target) {
+        target.stack_capacity = parse_number(stack_capacity, "stack capacity");
+    }
+
+    void parse_stack_growth_factor(const std::string& growth_factor, PalexConfig& target) {
+        target.stack_growth_factor = parse_number(growth_factor, "stack growth");
+        if (target.stack_growth_factor < 2) {
+            throw palex_except::ParserError("The stack growth option requires a factor of at least 2!");
+        }
+    }
+
+    void parse_thread_count(const std::string& thread_count, PalexConfig& target) {
+        target.thread_count = parse_number(thread_count, "threads");
+    }
+
+    size_t parse_number(const std::string& number, const std::string& option_name) {
+        if (!std::all_of(number.begin(), number.end(), [](const char to_check) -> bool { return std::isdigit(to_check); })) {
+            throw palex_except::ParserError("Invalid number '" + number + "' supplied to " + option_name + " option!");
         }
         try {
-            target.lookahead = std::stoull(lookahead);
+            return std::stoull(number);
         } catch (const std::invalid_argument& invalid_arg_err) {
             assert(false && "BUG: Validity check should already have occured before!");
         } catch (const std::out_of_range& out_of_range_err) {
-            throw palex_except::ParserError("Too big number '" + lookahead + "' supplied to lookahead option!");
+            throw palex_except::ParserError("Too big number '" + number + "' supplied to " + option_name + " option!");
         }
+        return 0;
     }
 
     void parse_module_name(const std::string& module_name, PalexConfig& target) {
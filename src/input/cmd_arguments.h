@@ -12,7 +12,8 @@ namespace input {
     enum class ParserType {
         NONE,
         LALR,
-        LR
+        LR,
+        PGM // canonical LR states, merged with Pager's weak compatibility test
     };
 
     struct PalexConfig {
@@ -20,14 +21,23 @@ namespace input {
         std::string output_path = ".";
         std::string util_output_path = ".";
         std::string module_name = "palex";
+        std::string cache_path; // empty when caching is disabled
         Language language = Language::NONE;  
         ParserType parser_type = ParserType::NONE;
         size_t lookahead = 0;
+        size_t shard_count = 1; // number of translation units the generated states are split into
+        size_t stack_capacity = 64; // parser stack entries that are stored without allocating
+        size_t stack_growth_factor = 2;
+        size_t thread_count = 0; // threads generating the parser table, 0 uses one per hardware thread
 
         bool generate_lexer = false;
         bool generate_util = false;
         bool generate_parser = false;
         bool lexer_fallback = false;
+        bool lexer_counters = false;
+        bool amalgamate = false;
+        bool table_driven_parser = false;
+        bool adaptive_lookahead = false; // the lookahead option is the maximum, states only test as many tokens as they need
     };
 
     PalexConfig parse_config_from_args(const int argc, const char** argv);
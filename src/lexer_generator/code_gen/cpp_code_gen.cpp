@@ -1,21 +1,25 @@
 #include "cpp_code_gen.h"
 
 #include <functional>
+#include <algorithm>
 #include <fstream>
 #include <vector>
 #include <cassert>
 #include <stdexcept>
 #include <iostream>
 #include <map>
+#include <set>
 #include <string_view>
 
 #include "templates/template_completion.h"
+#include "templates/amalgamation.h"
 
 #include "util/utf8.h"
 #include "util/stream_format.h"
 #include "util/palex_except.h"
 
 #include "cpp_lexer_source.h"
+#include "cpp_lexer_states_source.h"
 #include "cpp_lexer_header.h"
 #include "cpp_utf8_source.h"
 #include "cpp_utf8_header.h"
@@ -23,24 +27,27 @@
 #include "cpp_token_header.h"
 
 constexpr size_t RESERVED_TOKEN_COUNT = 2;
-const std::string RESTORE_FALLBACK_FUNC_COMPLETION = 
-R"(void %UNIT_NAME%Lexer::try_restore_fallback() {
+const templates::CompiledTemplate RESTORE_FALLBACK_FUNC_COMPLETION(
+R"(%INLINE%void %UNIT_NAME%Lexer::try_restore_fallback() {
     if (!this->fallback.has_value()) {
         return;
     }
     this->curr_token = this->fallback.value();
     this->position = this->current_token().identifier.end();
     this->file_position = this->current_token().end;
-})";
-const std::string STATE_COMPLETION =
+})"
+);
+const templates::CompiledTemplate STATE_COMPLETION(
 R"(case %STATE_ID%:
 %STATE_CONTENT%
-)";
-const std::string STATE_TRANSITION_COMPLETION = 
+)"
+);
+const templates::CompiledTemplate STATE_TRANSITION_COMPLETION(
 R"(switch (current_codepoint) {
 %STATE_TRANSITIONS%
 }
-)";
+)"
+);
 
 // helper functions
 void complete_type_enum(const code_gen::TokenInfos& tokens, std::ostream& output);
@@ -50,19 +57,34 @@ void complete_state(
     const std::string& unit_name,
     const lexer_generator::LexerAutomaton_t::StateID_t state_id, 
     const lexer_generator::LexerAutomaton_t& lexer_dfa, 
+    const lexer_generator::CountedRepetitions_t& repetitions,
     const input::PalexConfig& config, 
     std::ostream& output
 );
+void complete_states(
+    const std::string& unit_name,
+    const lexer_generator::LexerAutomaton_t::StateID_t first_state,
+    const lexer_generator::LexerAutomaton_t::StateID_t end_state,
+    const lexer_generator::LexerAutomaton_t& lexer_dfa, 
+    const lexer_generator::CountedRepetitions_t& repetitions,
+    const input::PalexConfig& config, 
+    std::ostream& output
+);
+void complete_state_shard_dispatch(const std::string& unit_name, const size_t state_count, const input::PalexConfig& config, std::ostream& output);
+void complete_lexer_shard_declarations(const std::string& unit_name, const input::PalexConfig& config, std::ostream& output);
+size_t get_lexer_states_per_shard(const size_t state_count, const input::PalexConfig& config);
 void complete_error_state(const std::string& unit_name, const input::PalexConfig& config, std::ostream& output);
 void complete_state_transition_table(
     const std::string& unit_name,
     const lexer_generator::LexerAutomaton_t::StateID_t state_id,
     const lexer_generator::LexerAutomaton_t& lexer_dfa,
+    const lexer_generator::CountedRepetitions_t& repetitions,
     std::ostream& output
 );
 void complete_state_transition(
     const lexer_generator::LexerAutomaton_t::ConnectionID_t connection,
     const lexer_generator::LexerAutomaton_t& lexer_dfa,
+    const lexer_generator::CountedRepetitions_t& repetitions,
     std::ostream& output
 );
 void complete_state_default_transition(
@@ -71,14 +93,53 @@ void complete_state_default_transition(
     const lexer_generator::LexerAutomaton_t& lexer_dfa,
     std::ostream& output
 );
+void complete_default_transition_body(
+    const std::string& unit_name,
+    const lexer_generator::LexerAutomaton_t::StateID_t state_id,
+    const lexer_generator::LexerAutomaton_t& lexer_dfa,
+    std::ostream& output
+);
+void complete_counted_transition(
+    const std::string& unit_name,
+    const lexer_generator::CountedRepetition& repetition,
+    const lexer_generator::LexerAutomaton_t& lexer_dfa,
+    const lexer_generator::CountedRepetitions_t& repetitions,
+    std::ostream& output
+);
+void complete_transition_cases(const regex::CharRangeSet& chars, std::ostream& output);
+void complete_transition_target(
+    const lexer_generator::LexerAutomaton_t::StateID_t target, 
+    const lexer_generator::CountedRepetitions_t& repetitions, 
+    std::ostream& output
+);
 void complete_state_content(
     const std::string& unit_name,
     const lexer_generator::LexerAutomaton_t::StateID_t state_id,
     const lexer_generator::LexerAutomaton_t& lexer_dfa,
+    const lexer_generator::CountedRepetitions_t& repetitions,
     const input::PalexConfig& config,
     std::ostream& output
 );
 
+lexer_generator::CountedRepetitions_t get_counted_repetitions(const lexer_generator::LexerAutomaton_t& lexer_dfa, const input::PalexConfig& config);
+std::map<std::string_view, templates::TemplateCompleter_t> create_lexer_header_completers(const std::string& unit_name, const input::PalexConfig& config);
+std::map<std::string_view, templates::TemplateCompleter_t> create_lexer_source_completers(
+    const lexer_generator::LexerAutomaton_t& lexer_dfa,
+    const lexer_generator::CountedRepetitions_t& repetitions,
+    const std::string& unit_name, 
+    const input::PalexConfig& config
+);
+std::map<std::string_view, templates::TemplateCompleter_t> create_token_header_completers(
+    const std::string& unit_name, 
+    const input::PalexConfig& config, 
+    const code_gen::TokenInfos& tokens
+);
+std::map<std::string_view, templates::TemplateCompleter_t> create_token_source_completers(
+    const std::string& unit_name, 
+    const input::PalexConfig& config, 
+    const code_gen::TokenInfos& tokens
+);
+
 void complete_type_enum(const code_gen::TokenInfos& tokens, std::ostream& output) {
     output << sfmt::Indentation{3}; 
     output << "UNDEFINED,\n"
@@ -93,7 +154,7 @@ void complete_type_enum(const code_gen::TokenInfos& tokens, std::ostream& output
 }
 
 void complete_token_type_strings(const code_gen::TokenInfos& tokens, std::ostream& output) {
-    output << sfmt::Indentation{1}; 
+    output << sfmt::Indentation{2}; 
     output << "\"UNDEFINED\",\n"
            << "\"END_OF_FILE\"";
     for (const std::string& token : tokens.tokens) {
@@ -102,21 +163,23 @@ void complete_token_type_strings(const code_gen::TokenInfos& tokens, std::ostrea
     for (const std::string& ignored_token : tokens.ignored_tokens) {
         output << ",\n\"" << ignored_token << '"';
     }
-    output << sfmt::Indentation{-1}; 
+    output << sfmt::Indentation{-2}; 
 }
 
 void complete_restore_token_fallback_function(const std::string& unit_name, const input::PalexConfig& config, std::ostream& output) {
     const std::map<std::string_view, templates::TemplateCompleter_t> completers = {
+        {"INLINE", templates::conditional_completer(config.amalgamate, "inline ")},
         {"MODULE_NAMESPACE", templates::constant_completer(config.module_name)},
         {"UNIT_NAME", templates::constant_completer(unit_name)}
     };
-    templates::write_template_to_stream(RESTORE_FALLBACK_FUNC_COMPLETION.c_str(), output, completers);
+    templates::write_template_to_stream(RESTORE_FALLBACK_FUNC_COMPLETION, output, completers);
 }
 
 void complete_state(
     const std::string& unit_name,
     const lexer_generator::LexerAutomaton_t::StateID_t state_id, 
     const lexer_generator::LexerAutomaton_t& lexer_dfa, 
+    const lexer_generator::CountedRepetitions_t& repetitions,
     const input::PalexConfig& config, 
     std::ostream& output
 ) {
@@ -126,19 +189,74 @@ void complete_state(
             "STATE_CONTENT",
             [&](std::ostream& output) {
                 output << sfmt::Indentation{1};
-                complete_state_content(unit_name, state_id, lexer_dfa, config, output);
+                complete_state_content(unit_name, state_id, lexer_dfa, repetitions, config, output);
                 output << sfmt::Indentation{-1};
             }
         }
     };
+    templates::write_template_to_stream(STATE_COMPLETION, output, completers);
+}
+
+void complete_states(
+    const std::string& unit_name,
+    const lexer_generator::LexerAutomaton_t::StateID_t first_state,
+    const lexer_generator::LexerAutomaton_t::StateID_t end_state,
+    const lexer_generator::LexerAutomaton_t& lexer_dfa, 
+    const lexer_generator::CountedRepetitions_t& repetitions,
+    const input::PalexConfig& config, 
+    std::ostream& output
+) {
+    std::set<lexer_generator::LexerAutomaton_t::StateID_t> counted_states; // replaced by the counter of the first state in their chain
+    for (const auto& [_, repetition] : repetitions) {
+        counted_states.insert(repetition.states.begin() + 1, repetition.states.end());
+    }
+    for (auto state = lexer_dfa.get_states().lower_bound(first_state); state != lexer_dfa.get_states().end() && state->first < end_state; state++) {
+        if (counted_states.count(state->first) == 0) {
+            complete_state(unit_name, state->first, lexer_dfa, repetitions, config, output);
+        }
+    }
+}
+
+void complete_state_shard_dispatch(const std::string& unit_name, const size_t state_count, const input::PalexConfig& config, std::ostream& output) {
+    const size_t states_per_shard = get_lexer_states_per_shard(state_count, config);
     output << sfmt::Indentation{4};
-    templates::write_template_to_stream(STATE_COMPLETION.c_str(), output, completers);
+    for (size_t shard = 0; shard < config.shard_count && shard * states_per_shard < state_count; shard++) {
+        output << "case " << shard * states_per_shard << " ... " << (shard + 1) * states_per_shard - 1 << ":\n";
+        output << sfmt::Indentation{1};
+        output << "if (const std::optional<" << unit_name << "Token::TokenType> token_type = this->lex_states_" << shard 
+               << "(state, repetition_counter, current_codepoint, identifier_begin, token_file_position)) {\n"
+                  "    return token_type.value();\n"
+                  "}\n"
+                  "break;\n";
+        output << sfmt::Indentation{-1};
+    }
     output << sfmt::Indentation{-4};
 }
 
+void complete_lexer_shard_declarations(const std::string& unit_name, const input::PalexConfig& config, std::ostream& output) {
+    if (config.shard_count <= 1) {
+        return;
+    }
+    output << sfmt::Indentation{3};
+    for (size_t shard = 0; shard < config.shard_count; shard++) {
+        output << "std::optional<" << unit_name << "Token::TokenType> lex_states_" << shard << "(\n"
+                  "    size_t& state, \n"
+                  "    size_t& repetition_counter, \n"
+                  "    const utf8::Codepoint_t current_codepoint, \n"
+                  "    const char* const identifier_begin, \n"
+                  "    const FilePosition& token_file_position\n"
+                  ");\n";
+    }
+    output << sfmt::Indentation{-3};
+}
+
+size_t get_lexer_states_per_shard(const size_t state_count, const input::PalexConfig& config) {
+    return std::max((state_count + config.shard_count - 1) / config.shard_count, (size_t)1);
+}
+
 void complete_error_state(const std::string& unit_name, const input::PalexConfig& config, std::ostream& output) {
     output << sfmt::Indentation{3};
-    output << "case ERROR_STATE:\n";
+    output << "case " << unit_name << "_detail::ERROR_STATE:\n";
     output << sfmt::Indentation{1};
     output << "this->curr_token = create_token(" << unit_name << "Token::TokenType::UNDEFINED);\n";
     if (config.lexer_fallback) {
@@ -153,6 +271,7 @@ void complete_state_transition_table(
     const std::string& unit_name,
     const lexer_generator::LexerAutomaton_t::StateID_t state_id,
     const lexer_generator::LexerAutomaton_t& lexer_dfa,
+    const lexer_generator::CountedRepetitions_t& repetitions,
     std::ostream& output
 ) {
     const std::map<std::string_view, templates::TemplateCompleter_t> completers = {
@@ -160,34 +279,87 @@ void complete_state_transition_table(
             "STATE_TRANSITIONS", 
             [&](std::ostream& output) {
                 output << sfmt::Indentation{1};
+                const auto repetition = repetitions.find(state_id);
                 for (const lexer_generator::LexerAutomaton_t::ConnectionID_t connection : lexer_dfa.get_outgoing_connection_ids(state_id)) {
-                    complete_state_transition(connection, lexer_dfa, output);
+                    if (repetition != repetitions.end() && lexer_dfa.get_connection(connection).target == repetition->second.states[1]) {
+                        complete_counted_transition(unit_name, repetition->second, lexer_dfa, repetitions, output);
+                    } else {
+                        complete_state_transition(connection, lexer_dfa, repetitions, output);
+                    }
                 }
                 complete_state_default_transition(unit_name, state_id, lexer_dfa, output);
                 output << sfmt::Indentation{-1};
             }
         }
     };    
-    templates::write_template_to_stream(STATE_TRANSITION_COMPLETION.c_str(), output, completers);
+    templates::write_template_to_stream(STATE_TRANSITION_COMPLETION, output, completers);
 }
 
 void complete_state_transition(
     const lexer_generator::LexerAutomaton_t::ConnectionID_t connection,
     const lexer_generator::LexerAutomaton_t& lexer_dfa,
+    const lexer_generator::CountedRepetitions_t& repetitions,
     std::ostream& output
 ) {
     assert(lexer_dfa.get_connection(connection).value.has_value() && "BUG: Found epsilon connection in DFA!");
-    for (const regex::CharRange& range : lexer_dfa.get_connection(connection).value.value().get_ranges()) {
+    complete_transition_cases(lexer_dfa.get_connection(connection).value.value(), output);
+    output << sfmt::Indentation{1};
+    complete_transition_target(lexer_dfa.get_connection(connection).target, repetitions, output);
+    output << "break;\n";
+    output << sfmt::Indentation{-1};
+}
+
+void complete_counted_transition(
+    const std::string& unit_name,
+    const lexer_generator::CountedRepetition& repetition,
+    const lexer_generator::LexerAutomaton_t& lexer_dfa,
+    const lexer_generator::CountedRepetitions_t& repetitions,
+    std::ostream& output
+) {
+    const lexer_generator::LexerAutomaton_t::StateID_t last_state = repetition.states.back();
+
+    complete_transition_cases(repetition.counted_chars, output);
+    output << sfmt::Indentation{1};
+    output << "if (repetition_counter == " << repetition.states.size() - 1 << ") {\n";
+    output << sfmt::Indentation{1};
+    // the counter is exhausted, so the counted chars are handled like in the last state of the chain
+    bool has_exit_transition = false;
+    for (const lexer_generator::LexerAutomaton_t::ConnectionID_t connection : lexer_dfa.get_outgoing_connection_ids(last_state)) {
+        if (lexer_dfa.get_connection(connection).value.value() == repetition.counted_chars) {
+            complete_transition_target(lexer_dfa.get_connection(connection).target, repetitions, output);
+            output << "break;";
+            has_exit_transition = true;
+        }
+    }
+    if (!has_exit_transition) {
+        complete_default_transition_body(unit_name, last_state, lexer_dfa, output);
+    }
+    output << sfmt::Indentation{-1};
+    output << "\n}\n";
+    output << "repetition_counter++;\n";
+    output << "break;\n";
+    output << sfmt::Indentation{-1};
+}
+
+void complete_transition_cases(const regex::CharRangeSet& chars, std::ostream& output) {
+    for (const regex::CharRange& range : chars.get_ranges()) {
         output << "case " << (size_t)range.start;
         if (!range.is_single_char()) {
             output << " ... " << (size_t)range.end;
         }
         output << ":\n";
     }
-    output << sfmt::Indentation{1};
-    output << "state = " << lexer_dfa.get_connection(connection).target << ";\n";
-    output << "break;\n";
-    output << sfmt::Indentation{-1};
+}
+
+void complete_transition_target(
+    const lexer_generator::LexerAutomaton_t::StateID_t target, 
+    const lexer_generator::CountedRepetitions_t& repetitions, 
+    std::ostream& output
+) {
+    if (repetitions.count(target) != 0) {
+        output << "repetition_counter = 0;\n";
+    }
+    output << "state = " << target << ";\n";
 }
 
 void complete_state_default_transition(
@@ -198,20 +370,30 @@ void complete_state_default_transition(
 ) {
     output << "default:\n";
     output << sfmt::Indentation{1};
+    complete_default_transition_body(unit_name, state_id, lexer_dfa, output);
+    output << sfmt::Indentation{-1};
+}
+
+void complete_default_transition_body(
+    const std::string& unit_name,
+    const lexer_generator::LexerAutomaton_t::StateID_t state_id,
+    const lexer_generator::LexerAutomaton_t& lexer_dfa,
+    std::ostream& output
+) {
     if (lexer_dfa.get_state(state_id).empty()) {
-        output << "state = ERROR_STATE;\n"
+        output << "state = " << unit_name << "_detail::ERROR_STATE;\n"
                 << "break;";
     } else {
         output << "this->curr_token = create_token(" << unit_name << "Token::TokenType::" << lexer_dfa.get_state(state_id)<< ");\n"
                << "return this->current_token().type;";
     }
-    output << sfmt::Indentation{-1};
 }
 
 void complete_state_content(
     const std::string& unit_name,
     const lexer_generator::LexerAutomaton_t::StateID_t state_id,
     const lexer_generator::LexerAutomaton_t& lexer_dfa,
+    const lexer_generator::CountedRepetitions_t& repetitions,
     const input::PalexConfig& config,
     std::ostream& output
 ) {
@@ -225,66 +407,51 @@ void complete_state_content(
     if (config.lexer_fallback && !lexer_dfa.get_state(state_id).empty()) {
         output << "this->fallback = create_token(" << unit_name << "Token::TokenType::" << lexer_dfa.get_state(state_id) << ");\n";
     }
-    complete_state_transition_table(unit_name, state_id, lexer_dfa, output);
+    complete_state_transition_table(unit_name, state_id, lexer_dfa, repetitions, output);
     output << "break;";
 }
 
-bool code_gen::cpp::generate_lexer_files(
-    const std::vector<lexer_generator::TokenDefinition>& token_definitions,
-    const lexer_generator::LexerAutomaton_t& lexer_dfa, 
-    const std::string& unit_name, 
-    const input::PalexConfig& config
-) {
-    const TokenInfos& tokens = code_gen::conv_rules_to_generation_info(token_definitions);
-    try {
-        generate_lexer_header(unit_name, config, tokens);
-        generate_lexer_source(tokens, lexer_dfa, unit_name, config);
-        generate_token_header(unit_name, config, tokens);
-        generate_token_source(unit_name, config, tokens);
-        if (config.generate_util) {
-            generate_utf8_lib(config);
-        }
-    } catch(const std::exception& e) {
-        std::cerr << "Failed to generate (some) lexer files: " << e.what() << std::endl;
-        return false;
-    }
-    return true;
+lexer_generator::CountedRepetitions_t get_counted_repetitions(const lexer_generator::LexerAutomaton_t& lexer_dfa, const input::PalexConfig& config) {
+    return config.lexer_counters ? lexer_generator::find_counted_repetitions(lexer_dfa) : lexer_generator::CountedRepetitions_t{};
 }
 
-void code_gen::cpp::generate_lexer_header(const std::string& unit_name, const input::PalexConfig& config, const TokenInfos& tokens) {
+std::map<std::string_view, templates::TemplateCompleter_t> create_lexer_header_completers(const std::string& unit_name, const input::PalexConfig& config) {
     using namespace std::placeholders;
 
-    const std::string header_file_path = config.output_path + "/" + unit_name + "Lexer.h";
-    const std::map<std::string_view, templates::TemplateCompleter_t> completers = {
-        {"FALLBACK_INCLUDES", templates::conditional_completer(config.lexer_fallback, "\n#include <optional>")},
+    return {
+        {"OPTIONAL_INCLUDE", templates::conditional_completer(config.lexer_fallback || config.shard_count > 1, "\n#include <optional>")},
         {"MODULE_NAME", templates::constant_completer(config.module_name)},
         {"UNIT_NAME", templates::constant_completer(unit_name)},
         {"FALLBACK_FUNCTION", templates::conditional_completer(config.lexer_fallback, "void try_restore_fallback();\n")},
-        {"FALLBACK_CACHE", templates::conditional_completer(config.lexer_fallback, "std::optional<" + unit_name + "Token> fallback;")}
+        {"FALLBACK_CACHE", templates::conditional_completer(config.lexer_fallback, "std::optional<" + unit_name + "Token> fallback;")},
+        {"STATE_SHARD_FUNCTIONS", std::bind(complete_lexer_shard_declarations, unit_name, config, _1)}
     };
-    std::cout << "Generating file " << header_file_path << "..." << std::endl;
-    templates::write_template_to_file(cpp_lexer_header, header_file_path, completers);
 }
 
-void code_gen::cpp::generate_lexer_source(
-    const TokenInfos& tokens, 
+std::map<std::string_view, templates::TemplateCompleter_t> create_lexer_source_completers(
     const lexer_generator::LexerAutomaton_t& lexer_dfa,
+    const lexer_generator::CountedRepetitions_t& repetitions,
     const std::string& unit_name, 
     const input::PalexConfig& config
 ) {
     using namespace std::placeholders;
 
-    const std::string source_file_path = config.output_path + "/" + unit_name + "Lexer.cpp";
-    const std::map<std::string_view, templates::TemplateCompleter_t> completers = {
+    return {
+        {"INLINE", templates::conditional_completer(config.amalgamate, "inline ")},
         {"UNIT_NAME", templates::constant_completer(unit_name)},
         {"MODULE_NAME", templates::constant_completer(config.module_name)},
         {"FALLBACK_CLEAR", templates::conditional_completer(config.lexer_fallback, "this->fallback = std::nullopt;")},
+        {"REPETITION_COUNTER", templates::conditional_completer(!repetitions.empty() || config.shard_count > 1, "size_t repetition_counter = 0;")},
         {
             "STATES", 
-            [&](std::ostream& output) {
-                for (const auto& [state_id, _] : lexer_dfa.get_states()) {
-                    complete_state(unit_name, state_id, lexer_dfa, config, output);
+            [&lexer_dfa, &repetitions, &unit_name, &config](std::ostream& output) {
+                if (config.shard_count > 1) {
+                    complete_state_shard_dispatch(unit_name, lexer_dfa.get_states().size(), config, output);
+                    return;
                 }
+                output << sfmt::Indentation{4};
+                complete_states(unit_name, 0, lexer_dfa.get_states().size(), lexer_dfa, repetitions, config, output);
+                output << sfmt::Indentation{-4};
             }
         },
         {"ERROR_STATE", std::bind(complete_error_state, unit_name, config, _1)},
@@ -294,40 +461,155 @@ void code_gen::cpp::generate_lexer_source(
                                   : templates::EMPTY_COMPLETER
         }
     };
-    std::cout << "Generating file " << source_file_path << "..." << std::endl;
-    templates::write_template_to_file(cpp_lexer_source, source_file_path, completers);
 }
 
-void code_gen::cpp::generate_token_header(const std::string& unit_name, const input::PalexConfig& config, const TokenInfos& tokens) {
+std::map<std::string_view, templates::TemplateCompleter_t> create_token_header_completers(
+    const std::string& unit_name, 
+    const input::PalexConfig& config, 
+    const code_gen::TokenInfos& tokens
+) {
     using namespace std::placeholders;
 
-    const std::string header_file_path = config.output_path + "/" + unit_name + "Token.h";
-    const std::map<std::string_view, templates::TemplateCompleter_t> completers = {
+    return {
         {"UNIT_NAME", templates::constant_completer(unit_name)},
         {"MODULE_NAME", templates::constant_completer(config.module_name)},
         {"TOKEN_TYPE_ENUM", std::bind(complete_type_enum, tokens, _1)}
     };
-    templates::write_template_to_file(cpp_token_header, header_file_path, completers);
 }
 
-void code_gen::cpp::generate_token_source(const std::string& unit_name, const input::PalexConfig& config, const TokenInfos& tokens) {
+std::map<std::string_view, templates::TemplateCompleter_t> create_token_source_completers(
+    const std::string& unit_name, 
+    const input::PalexConfig& config, 
+    const code_gen::TokenInfos& tokens
+) {
     using namespace std::placeholders;
-   
-    const std::string source_file_path = config.output_path + "/" + unit_name + "Token.cpp";
-    const std::map<std::string_view, templates::TemplateCompleter_t> completers = {
+
+    return {
+        {"INLINE", templates::conditional_completer(config.amalgamate, "inline ")},
         {"UNIT_NAME", templates::constant_completer(unit_name)},
         {"MODULE_NAME", templates::constant_completer(config.module_name)},
         {"LAST_NORMAL_TOKEN", templates::constant_completer(tokens.tokens.empty() ? "END_OF_FILE" : tokens.tokens.back())},
         {"TOKEN_COUNT", templates::constant_completer(std::to_string(tokens.tokens.size() + tokens.ignored_tokens.size() + RESERVED_TOKEN_COUNT))},
         {"TOKEN_STRINGS", std::bind(complete_token_type_strings, tokens, _1)},
     };
-    templates::write_template_to_file(cpp_token_source, source_file_path, completers);
+}
+
+bool code_gen::cpp::generate_lexer_files(
+    const std::vector<lexer_generator::TokenDefinition>& token_definitions,
+    const lexer_generator::LexerAutomaton_t& lexer_dfa, 
+    const std::string& unit_name, 
+    const input::PalexConfig& config
+) {
+    const TokenInfos& tokens = code_gen::conv_rules_to_generation_info(token_definitions);
+    try {
+        if (config.amalgamate) {
+            generate_amalgamated_lexer(tokens, lexer_dfa, unit_name, config);
+            return true;
+        }
+        generate_lexer_header(unit_name, config, tokens);
+        generate_lexer_source(tokens, lexer_dfa, unit_name, config);
+        generate_token_header(unit_name, config, tokens);
+        generate_token_source(unit_name, config, tokens);
+        if (config.generate_util) {
+            generate_utf8_lib(config);
+        }
+    } catch(const std::exception& e) {
+        std::cerr << "Failed to generate (some) lexer files: " << e.what() << std::endl;
+        return false;
+    }
+    return true;
+}
+
+void code_gen::cpp::generate_lexer_header(const std::string& unit_name, const input::PalexConfig& config, const TokenInfos& tokens) {
+    const std::string header_file_path = config.output_path + "/" + unit_name + "Lexer.h";
+    std::cout << "Generating file " << header_file_path << "..." << std::endl;
+    templates::write_template_to_file(cpp_lexer_header, header_file_path, create_lexer_header_completers(unit_name, config));
+}
+
+void code_gen::cpp::generate_lexer_source(
+    const TokenInfos& tokens, 
+    const lexer_generator::LexerAutomaton_t& lexer_dfa,
+    const std::string& unit_name, 
+    const input::PalexConfig& config
+) {
+    const std::string source_file_path = config.output_path + "/" + unit_name + "Lexer.cpp";
+    const lexer_generator::CountedRepetitions_t repetitions = get_counted_repetitions(lexer_dfa, config);
+    std::cout << "Generating file " << source_file_path << "..." << std::endl;
+    templates::write_template_to_file(cpp_lexer_source, source_file_path, create_lexer_source_completers(lexer_dfa, repetitions, unit_name, config));
+    if (config.shard_count > 1) {
+        generate_lexer_states_sources(lexer_dfa, repetitions, unit_name, config);
+    }
+}
+
+void code_gen::cpp::generate_lexer_states_sources(
+    const lexer_generator::LexerAutomaton_t& lexer_dfa,
+    const lexer_generator::CountedRepetitions_t& repetitions,
+    const std::string& unit_name, 
+    const input::PalexConfig& config
+) {
+    const size_t states_per_shard = get_lexer_states_per_shard(lexer_dfa.get_states().size(), config);
+    for (size_t shard = 0; shard < config.shard_count; shard++) {
+        const std::string source_file_path = config.output_path + "/" + unit_name + "LexerStates" + std::to_string(shard) + ".cpp";
+        const std::map<std::string_view, templates::TemplateCompleter_t> completers = {
+            {"UNIT_NAME", templates::constant_completer(unit_name)},
+            {"MODULE_NAME", templates::constant_completer(config.module_name)},
+            {"SHARD_ID", templates::constant_completer(std::to_string(shard))},
+            {
+                "STATES", 
+                [&](std::ostream& output) {
+                    output << sfmt::Indentation{3};
+                    complete_states(unit_name, shard * states_per_shard, (shard + 1) * states_per_shard, lexer_dfa, repetitions, config, output);
+                    output << sfmt::Indentation{-3};
+                }
+            }
+        };
+        std::cout << "Generating file " << source_file_path << "..." << std::endl;
+        templates::write_template_to_file(cpp_lexer_states_source, source_file_path, completers);
+    }
+}
+
+void code_gen::cpp::generate_token_header(const std::string& unit_name, const input::PalexConfig& config, const TokenInfos& tokens) {
+    const std::string header_file_path = config.output_path + "/" + unit_name + "Token.h";
+    templates::write_template_to_file(cpp_token_header, header_file_path, create_token_header_completers(unit_name, config, tokens));
+}
+
+void code_gen::cpp::generate_token_source(const std::string& unit_name, const input::PalexConfig& config, const TokenInfos& tokens) {
+    const std::string source_file_path = config.output_path + "/" + unit_name + "Token.cpp";
+    templates::write_template_to_file(cpp_token_source, source_file_path, create_token_source_completers(unit_name, config, tokens));
 }
 
 void code_gen::cpp::generate_utf8_lib(const input::PalexConfig& config) { // TODO: move to extra generator for lib files?
     const std::string utf8_path = config.util_output_path + "/utf8";
     std::cout << "Generating file " << utf8_path << ".cpp..." << std::endl;
-    templates::write_template_to_file(cpp_utf8_source, utf8_path + ".cpp", {});
+    templates::write_template_to_file(cpp_utf8_source, utf8_path + ".cpp", {{"INLINE", templates::EMPTY_COMPLETER}});
     std::cout << "Generating file " << utf8_path << ".h..." << std::endl;
     templates::write_template_to_file(cpp_utf8_header, utf8_path + ".h", {});
+}
+
+void code_gen::cpp::generate_amalgamated_lexer(
+    const TokenInfos& tokens, 
+    const lexer_generator::LexerAutomaton_t& lexer_dfa,
+    const std::string& unit_name, 
+    const input::PalexConfig& config
+) {
+    const std::string header_file_path = config.output_path + "/" + unit_name + "Lexer.h";
+    const lexer_generator::CountedRepetitions_t repetitions = get_counted_repetitions(lexer_dfa, config);
+    const std::map<std::string_view, templates::TemplateCompleter_t> utf8_completers = {
+        {"INLINE", templates::constant_completer("inline ")}
+    };
+    const std::string amalgamation = templates::amalgamate_sources(
+        {
+            "#ifndef PALEX_UTF8_AMALGAMATED // the utf8 helpers are shared by all amalgamated lexers\n#define PALEX_UTF8_AMALGAMATED",
+            templates::render_template(cpp_utf8_header, {}),
+            templates::render_template(cpp_utf8_source, utf8_completers),
+            "#endif",
+            templates::render_template(cpp_token_header, create_token_header_completers(unit_name, config, tokens)),
+            templates::render_template(cpp_token_source, create_token_source_completers(unit_name, config, tokens)),
+            templates::render_template(cpp_lexer_header, create_lexer_header_completers(unit_name, config)),
+            templates::render_template(cpp_lexer_source, create_lexer_source_completers(lexer_dfa, repetitions, unit_name, config))
+        },
+        {{"utf8.h", ""}, {unit_name + "Token.h", ""}, {unit_name + "Lexer.h", ""}}
+    );
+    std::cout << "Generating file " << header_file_path << "..." << std::endl;
+    templates::write_string_to_file(amalgamation, header_file_path);
 }
\ No newline at end of file
@@ -26,8 +26,20 @@ namespace code_gen {
             const std::string& unit_name, 
             const input::PalexConfig& config
         );
+        void generate_lexer_states_sources( // only used when the states are split into multiple shards
+            const lexer_generator::LexerAutomaton_t& lexer_dfa,
+            const lexer_generator::CountedRepetitions_t& repetitions,
+            const std::string& unit_name, 
+            const input::PalexConfig& config
+        );
         void generate_token_header(const std::string& unit_name, const input::PalexConfig& config, const TokenInfos& tokens);
         void generate_token_source(const std::string& unit_name, const input::PalexConfig& config, const TokenInfos& tokens);
         void generate_utf8_lib(const input::PalexConfig& config);
+        void generate_amalgamated_lexer( // writes the lexer, its tokens and the utf8 helpers as a single header
+            const TokenInfos& tokens, 
+            const lexer_generator::LexerAutomaton_t& lexer_dfa,
+            const std::string& unit_name, 
+            const input::PalexConfig& config
+        );
     }
 }
\ No newline at end of file
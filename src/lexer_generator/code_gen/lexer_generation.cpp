@@ -5,14 +5,21 @@
 #include <filesystem>
 #include <cassert>
 #include <cstddef>
+#include <sstream>
+#include <optional>
 
 #include "lexer_generator/token_definition.h"
 #include "lexer_generator/validation.h"
+#include "lexer_generator/rule_optimization.h"
 
 #include "util/palex_except.h"
+#include "util/binary_cache.h"
 
 #include "cpp_code_gen.h"
 
+constexpr uint64_t DFA_CACHE_VERSION = 1;
+const std::string DFA_CACHE_CATEGORY = "lexer";
+
 const std::vector<code_gen::LexerCodeGenerator_t> code_gen::LANGUAGE_CODE_GENERATORS = {
     code_gen::EMPTY_LEXER_GENERATOR,
     code_gen::cpp::generate_lexer_files
@@ -20,22 +27,101 @@ const std::vector<code_gen::LexerCodeGenerator_t> code_gen::LANGUAGE_CODE_GENERA
 
 // helper functions
 lexer_generator::LexerAutomaton_t generate_dfa_from_rules(const std::vector<lexer_generator::TokenDefinition>& lexer_rules);
+lexer_generator::LexerAutomaton_t load_or_generate_dfa(const std::vector<lexer_generator::TokenDefinition>& lexer_rules, const input::PalexConfig& config);
+std::string create_dfa_cache_key(const std::vector<lexer_generator::TokenDefinition>& lexer_rules);
+void write_regex_cache_key(std::ostream& output, const regex::RegexBase* const regex);
 
 lexer_generator::LexerAutomaton_t generate_dfa_from_rules(const std::vector<lexer_generator::TokenDefinition>& lexer_rules) {
     using namespace std::placeholders;
     
     lexer_generator::LexerAutomaton_t lexer_nfa{};
     const lexer_generator::LexerAutomaton_t::StateID_t root_state = lexer_nfa.add_state("");
-    for (const lexer_generator::TokenDefinition& rule : lexer_rules) {
-        lexer_generator::insert_rule_in_nfa(lexer_nfa, root_state, rule);
-    }
+    lexer_generator::insert_rules_in_position_nfa(lexer_nfa, root_state, lexer_generator::optimize_rules(lexer_rules));
     std::map<std::string, size_t> token_priorities = lexer_generator::get_token_priorities(lexer_rules);
     auto merge_states = std::bind(lexer_generator::merge_states_by_priority, token_priorities, _1);
-    return lexer_nfa.convert_to_dfa<std::string>(
+    return lexer_generator::minimize_dfa(lexer_nfa.convert_to_dfa<std::string>(
         root_state,
         merge_states,
         lexer_generator::resolve_connection_collisions
-    );
+    ));
+}
+
+lexer_generator::LexerAutomaton_t load_or_generate_dfa(const std::vector<lexer_generator::TokenDefinition>& lexer_rules, const input::PalexConfig& config) {
+    if (config.cache_path.empty()) {
+        return generate_dfa_from_rules(lexer_rules);
+    }
+    const std::string cache_key = create_dfa_cache_key(lexer_rules);
+    const std::optional<std::string> cached_dfa = bcache::load_entry(config.cache_path, DFA_CACHE_CATEGORY, cache_key);
+    if (cached_dfa.has_value()) {
+        try {
+            std::istringstream cached_dfa_stream(cached_dfa.value());
+            lexer_generator::LexerAutomaton_t lexer_dfa = lexer_generator::read_dfa(cached_dfa_stream);
+            std::cout << "Using cached lexer automaton..." << std::endl;
+            return lexer_dfa;
+        } catch (const std::runtime_error& err) {
+            std::cerr << "Ignored damaged cache entry: " << err.what() << std::endl;
+        }
+    }
+
+    const lexer_generator::LexerAutomaton_t lexer_dfa = generate_dfa_from_rules(lexer_rules);
+    try {
+        std::ostringstream serialized_dfa;
+        lexer_generator::write_dfa(serialized_dfa, lexer_dfa);
+        bcache::store_entry(config.cache_path, DFA_CACHE_CATEGORY, cache_key, serialized_dfa.str());
+    } catch (const std::exception& err) { // the cache is only an optimization, so generation continues without it
+        std::cerr << "Failed to cache lexer automaton: " << err.what() << std::endl;
+    }
+    return lexer_dfa;
+}
+
+std::string create_dfa_cache_key(const std::vector<lexer_generator::TokenDefinition>& lexer_rules) {
+    std::ostringstream cache_key;
+    bcache::write_uint(cache_key, DFA_CACHE_VERSION);
+    bcache::write_uint(cache_key, lexer_rules.size());
+    for (const lexer_generator::TokenDefinition& rule : lexer_rules) {
+        bcache::write_string(cache_key, rule.name);
+        bcache::write_uint(cache_key, rule.ignore_token);
+        bcache::write_uint(cache_key, rule.priority);
+        write_regex_cache_key(cache_key, rule.token_regex.get());
+    }
+    return cache_key.str();
+}
+
+void write_regex_cache_key(std::ostream& output, const regex::RegexBase* const regex) {
+    enum class RegexNodeType {
+        ALTERNATION,
+        SEQUENCE,
+        QUANTIFIER,
+        CHAR_SET
+    };
+
+    if (const regex::RegexAlternation* const alternation = dynamic_cast<const regex::RegexAlternation*>(regex)) {
+        bcache::write_uint(output, (uint64_t)RegexNodeType::ALTERNATION);
+        bcache::write_uint(output, alternation->get_branches().size());
+        for (const std::unique_ptr<regex::RegexBase>& branch : alternation->get_branches()) {
+            write_regex_cache_key(output, branch.get());
+        }
+    } else if (const regex::RegexSequence* const sequence = dynamic_cast<const regex::RegexSequence*>(regex)) {
+        bcache::write_uint(output, (uint64_t)RegexNodeType::SEQUENCE);
+        bcache::write_uint(output, sequence->get_elements().size());
+        for (const std::unique_ptr<regex::RegexBase>& element : sequence->get_elements()) {
+            write_regex_cache_key(output, element.get());
+        }
+    } else if (const regex::RegexQuantifier* const quantifier = dynamic_cast<const regex::RegexQuantifier*>(regex)) {
+        bcache::write_uint(output, (uint64_t)RegexNodeType::QUANTIFIER);
+        bcache::write_uint(output, quantifier->get_min());
+        bcache::write_uint(output, quantifier->get_max());
+        write_regex_cache_key(output, quantifier->get_operand().get());
+    } else if (const regex::RegexCharSet* const char_set = dynamic_cast<const regex::RegexCharSet*>(regex)) {
+        bcache::write_uint(output, (uint64_t)RegexNodeType::CHAR_SET);
+        bcache::write_uint(output, char_set->get_range_set().get_ranges().size());
+        for (const regex::CharRange& range : char_set->get_range_set().get_ranges()) {
+            bcache::write_uint(output, range.start);
+            bcache::write_uint(output, range.end);
+        }
+    } else {
+        throw std::runtime_error("Tried to create cache key for unknown regex type!");
+    }
 }
 
 bool code_gen::generate_lexer(const std::string& lexer_name, const std::vector<lexer_generator::TokenDefinition>& token_definitions, const input::PalexConfig& config) {
@@ -44,7 +130,7 @@ bool code_gen::generate_lexer(const std::string& lexer_name, const std::vector<l
         return false;
     }
     lexer_generator::validate_rules(token_definitions);
-    lexer_generator::LexerAutomaton_t lexer_dfa = generate_dfa_from_rules(token_definitions);
+    const lexer_generator::LexerAutomaton_t lexer_dfa = load_or_generate_dfa(token_definitions, config);
     assert(LANGUAGE_CODE_GENERATORS.size() > (size_t)config.language && "BUG: Supplied language has no generator associated with it!");
     return LANGUAGE_CODE_GENERATORS[(size_t)config.language](token_definitions, lexer_dfa, lexer_name, config);
 }
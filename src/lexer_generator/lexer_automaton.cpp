@@ -4,15 +4,42 @@
 #include <vector>
 #include <algorithm>
 #include <sstream>
+#include <optional>
 
 #include "util/utf8.h"
 
 #include "util/palex_except.h"
+#include "util/binary_cache.h"
 
 #include "regex/RegexParser.h"
 
+constexpr size_t MIN_COUNTED_REPETITIONS = 2;
+
 // helper functions
 void throw_ambiguous_priority_err(const std::vector<std::string>& ambiguous_tokens, const size_t priority);
+lexer_generator::RegexPositions empty_positions();
+lexer_generator::RegexPositions concat_positions(
+    lexer_generator::LexerAutomaton_t& nfa, 
+    const lexer_generator::RegexPositions& head, 
+    const lexer_generator::RegexPositions& tail
+);
+lexer_generator::RegexPositions optional_positions(lexer_generator::RegexPositions to_extend);
+lexer_generator::RegexPositions repeat_positions(lexer_generator::LexerAutomaton_t& nfa, lexer_generator::RegexPositions to_repeat);
+std::vector<const regex::RegexBase*> get_sequence_elements(const regex::RegexBase* const regex);
+std::optional<utf8::Codepoint_t> get_literal_codepoint(const regex::RegexBase* const regex);
+std::map<size_t, regex::CharRangeSet> get_grouped_transitions(
+    const lexer_generator::LexerAutomaton_t& dfa, 
+    const lexer_generator::LexerAutomaton_t::StateID_t state,
+    const std::map<lexer_generator::LexerAutomaton_t::StateID_t, size_t>& groups,
+    const std::optional<regex::CharRangeSet>& excluded_chars
+);
+std::map<lexer_generator::LexerAutomaton_t::StateID_t, size_t> identity_groups(const lexer_generator::LexerAutomaton_t& dfa);
+std::optional<lexer_generator::LexerAutomaton_t::ConnectionID_t> find_counted_connection(
+    const lexer_generator::LexerAutomaton_t& dfa, 
+    const lexer_generator::LexerAutomaton_t::StateID_t state,
+    const std::map<lexer_generator::LexerAutomaton_t::StateID_t, size_t>& groups
+);
+bool has_partial_transition(const lexer_generator::LexerAutomaton_t& dfa, const lexer_generator::LexerAutomaton_t::StateID_t state, const regex::CharRangeSet& chars);
 
 void throw_ambiguous_priority_err(const std::vector<std::string>& ambiguous_tokens, const size_t priority) {
     std::stringstream err_msg{};
@@ -30,6 +57,124 @@ void throw_ambiguous_priority_err(const std::vector<std::string>& ambiguous_toke
     throw palex_except::ValidationError(err_msg.str());
 }
 
+lexer_generator::RegexPositions empty_positions() {
+    return lexer_generator::RegexPositions{true, {}, {}, {}};
+}
+
+lexer_generator::RegexPositions concat_positions(
+    lexer_generator::LexerAutomaton_t& nfa, 
+    const lexer_generator::RegexPositions& head, 
+    const lexer_generator::RegexPositions& tail
+) {
+    lexer_generator::connect_positions(nfa, head.last, tail);
+
+    lexer_generator::RegexPositions concatenated{head.nullable && tail.nullable, head.first, tail.last, head.positions};
+    concatenated.positions.insert(concatenated.positions.end(), tail.positions.begin(), tail.positions.end());
+    if (head.nullable) {
+        concatenated.first.insert(concatenated.first.end(), tail.first.begin(), tail.first.end());
+    }
+    if (tail.nullable) {
+        concatenated.last.insert(concatenated.last.end(), head.last.begin(), head.last.end());
+    }
+
+    return concatenated;
+}
+
+lexer_generator::RegexPositions optional_positions(lexer_generator::RegexPositions to_extend) {
+    to_extend.nullable = true;
+    return to_extend;
+}
+
+lexer_generator::RegexPositions repeat_positions(lexer_generator::LexerAutomaton_t& nfa, lexer_generator::RegexPositions to_repeat) {
+    lexer_generator::connect_positions(nfa, to_repeat.last, to_repeat);
+    return to_repeat;
+}
+
+std::vector<const regex::RegexBase*> get_sequence_elements(const regex::RegexBase* const regex) {
+    const regex::RegexSequence* const sequence = dynamic_cast<const regex::RegexSequence*>(regex);
+    if (!sequence) {
+        return {regex};
+    }
+
+    std::vector<const regex::RegexBase*> elements;
+    for (const std::unique_ptr<regex::RegexBase>& element : sequence->get_elements()) {
+        elements.push_back(element.get());
+    }
+
+    return elements;
+}
+
+std::optional<utf8::Codepoint_t> get_literal_codepoint(const regex::RegexBase* const regex) {
+    const regex::RegexCharSet* const char_set = dynamic_cast<const regex::RegexCharSet*>(regex);
+    if (!char_set || char_set->get_range_set().get_ranges().size() != 1) {
+        return std::nullopt;
+    }
+    const regex::CharRange& range = char_set->get_range_set().get_ranges().front();
+
+    return (range.start == range.end) ? std::optional<utf8::Codepoint_t>{range.start} : std::nullopt;
+}
+
+std::map<size_t, regex::CharRangeSet> get_grouped_transitions(
+    const lexer_generator::LexerAutomaton_t& dfa, 
+    const lexer_generator::LexerAutomaton_t::StateID_t state,
+    const std::map<lexer_generator::LexerAutomaton_t::StateID_t, size_t>& groups,
+    const std::optional<regex::CharRangeSet>& excluded_chars
+) {
+    std::map<size_t, regex::CharRangeSet> grouped_transitions;
+
+    for (const lexer_generator::LexerAutomaton_t::ConnectionID_t connection_id : dfa.get_outgoing_connection_ids(state)) {
+        const lexer_generator::LexerAutomaton_t::Connection& connection = dfa.get_connection(connection_id);
+        if (excluded_chars.has_value() && connection.value.value() == excluded_chars.value()) {
+            continue;
+        }
+        regex::CharRangeSet& group_chars = grouped_transitions[groups.at(connection.target)];
+        group_chars = group_chars + connection.value.value();
+    }
+
+    return grouped_transitions;
+}
+
+std::map<lexer_generator::LexerAutomaton_t::StateID_t, size_t> identity_groups(const lexer_generator::LexerAutomaton_t& dfa) {
+    std::map<lexer_generator::LexerAutomaton_t::StateID_t, size_t> groups;
+    for (const auto& [state, _] : dfa.get_states()) {
+        groups[state] = state;
+    }
+    return groups;
+}
+
+std::optional<lexer_generator::LexerAutomaton_t::ConnectionID_t> find_counted_connection(
+    const lexer_generator::LexerAutomaton_t& dfa, 
+    const lexer_generator::LexerAutomaton_t::StateID_t state,
+    const std::map<lexer_generator::LexerAutomaton_t::StateID_t, size_t>& groups
+) {
+    for (const lexer_generator::LexerAutomaton_t::ConnectionID_t connection_id : dfa.get_outgoing_connection_ids(state)) {
+        const lexer_generator::LexerAutomaton_t::Connection& connection = dfa.get_connection(connection_id);
+        // the successor may only be entered through the counted connection, otherwise the counter value would be unknown
+        if (connection.target == state || dfa.get_incoming_connection_ids(connection.target).size() != 1) {
+            continue;
+        }
+        if (dfa.get_state(connection.target) != dfa.get_state(state)) {
+            continue;
+        }
+        if (get_grouped_transitions(dfa, state, groups, connection.value) == get_grouped_transitions(dfa, connection.target, groups, connection.value)) {
+            return connection_id;
+        }
+    }
+
+    return std::nullopt;
+}
+
+bool has_partial_transition(const lexer_generator::LexerAutomaton_t& dfa, const lexer_generator::LexerAutomaton_t::StateID_t state, const regex::CharRangeSet& chars) {
+    for (const lexer_generator::LexerAutomaton_t::ConnectionID_t connection_id : dfa.get_outgoing_connection_ids(state)) {
+        const regex::CharRangeSet& connection_chars = dfa.get_connection(connection_id).value.value();
+        if (connection_chars != chars && !connection_chars.get_intersection(chars).empty()) {
+            return true;
+        }
+    }
+
+    return false;
+}
+
 void lexer_generator::resolve_connection_collisions(
     const LexerAutomaton_t::Connection& to_add, 
     std::vector<std::pair<regex::CharRangeSet, std::set<LexerAutomaton_t::StateID_t>>>& dfa_connections
@@ -77,8 +222,8 @@ std::string lexer_generator::merge_states_by_priority(const std::map<std::string
             if (hp_tokens.empty() || token_priority > highest_priority) {
                 highest_priority = token_priority;
                 hp_tokens = {token};
-            } else if (token_priority == highest_priority) {
-                hp_tokens.push_back(token);
+            } else if (token_priority == highest_priority && std::find(hp_tokens.begin(), hp_tokens.end(), token) == hp_tokens.end()) {
+                hp_tokens.push_back(token); // several last positions of the same rule can end up in the same state
             }
         }
     }
@@ -189,3 +334,315 @@ lexer_generator::LexerAutomaton_t::StateID_t lexer_generator::insert_regex_seque
 
     return curr_root;
 }
+
+bool lexer_generator::insert_rule_in_position_nfa(LexerAutomaton_t& nfa, const LexerAutomaton_t::StateID_t root_state, const TokenDefinition& to_insert) {
+    const RegexPositions positions = insert_regex_ast_in_position_nfa(nfa, to_insert.token_regex.get());
+    
+    connect_positions(nfa, {root_state}, positions);
+    for (const LexerAutomaton_t::StateID_t leaf_state : positions.last) {
+        nfa.get_state(leaf_state) = to_insert.name;
+    }
+
+    return positions.nullable;
+}
+
+void lexer_generator::insert_rules_in_position_nfa(
+    LexerAutomaton_t& nfa, 
+    const LexerAutomaton_t::StateID_t root_state, 
+    const std::vector<TokenDefinition>& to_insert
+) {
+    const std::map<std::string, size_t> token_priorities = get_token_priorities(to_insert);
+    std::map<std::pair<LexerAutomaton_t::StateID_t, utf8::Codepoint_t>, LexerAutomaton_t::StateID_t> prefix_states;
+
+    for (const TokenDefinition& rule : to_insert) {
+        const std::vector<const regex::RegexBase*> elements = get_sequence_elements(rule.token_regex.get());
+        LexerAutomaton_t::StateID_t prefix_state = root_state;
+        size_t element_index = 0;
+
+        // leading literals are only reachable from their predecessor, so they can be shared between rules like a trie
+        for (; element_index < elements.size(); element_index++) {
+            const std::optional<utf8::Codepoint_t> literal = get_literal_codepoint(elements[element_index]);
+            if (!literal.has_value()) {
+                break;
+            }
+
+            auto prefix_iter = prefix_states.find(std::make_pair(prefix_state, literal.value()));
+            if (prefix_iter == prefix_states.end()) {
+                const LexerAutomaton_t::StateID_t literal_state = nfa.add_state("");
+                nfa.connect_states(prefix_state, literal_state, regex::CharRangeSet{}.insert_char_range(regex::CharRange{literal.value(), literal.value()}));
+                prefix_iter = prefix_states.insert(std::make_pair(std::make_pair(prefix_state, literal.value()), literal_state)).first;
+            }
+            prefix_state = prefix_iter->second;
+        }
+
+        RegexPositions remaining = empty_positions();
+        for (; element_index < elements.size(); element_index++) {
+            remaining = concat_positions(nfa, remaining, insert_regex_ast_in_position_nfa(nfa, elements[element_index]));
+        }
+
+        connect_positions(nfa, {prefix_state}, remaining);
+        for (const LexerAutomaton_t::StateID_t leaf_state : remaining.last) {
+            nfa.get_state(leaf_state) = rule.name;
+        }
+        if (remaining.nullable) {
+            nfa.get_state(prefix_state) = merge_states_by_priority(token_priorities, {nfa.get_state(prefix_state), rule.name});
+        }
+    }
+}
+
+void lexer_generator::connect_positions(LexerAutomaton_t& nfa, const std::vector<LexerAutomaton_t::StateID_t>& sources, const RegexPositions& targets) {
+    for (const LexerAutomaton_t::StateID_t source : sources) {
+        for (const auto& [target, value] : targets.first) {
+            nfa.connect_states(source, target, value);
+        }
+    }
+}
+
+lexer_generator::RegexPositions lexer_generator::clone_positions(LexerAutomaton_t& nfa, const RegexPositions& to_clone) {
+    std::map<LexerAutomaton_t::StateID_t, LexerAutomaton_t::StateID_t> clone_mappings;
+    for (const LexerAutomaton_t::StateID_t position : to_clone.positions) {
+        clone_mappings[position] = nfa.add_state(nfa.get_state(position));
+    }
+
+    RegexPositions clone{to_clone.nullable, {}, {}, {}};
+    for (const LexerAutomaton_t::StateID_t position : to_clone.positions) {
+        for (const LexerAutomaton_t::ConnectionID_t connection_id : nfa.get_outgoing_connection_ids(position)) {
+            const LexerAutomaton_t::Connection connection = nfa.get_connection(connection_id);
+            nfa.connect_states(clone_mappings.at(position), clone_mappings.at(connection.target), connection.value.value());
+        }
+        clone.positions.push_back(clone_mappings.at(position));
+    }
+    for (const auto& [position, value] : to_clone.first) {
+        clone.first.push_back(std::make_pair(clone_mappings.at(position), value));
+    }
+    for (const LexerAutomaton_t::StateID_t position : to_clone.last) {
+        clone.last.push_back(clone_mappings.at(position));
+    }
+
+    return clone;
+}
+
+lexer_generator::RegexPositions lexer_generator::insert_regex_ast_in_position_nfa(LexerAutomaton_t& nfa, const regex::RegexBase* const to_insert) {
+    if (dynamic_cast<const regex::RegexAlternation*>(to_insert)) {
+        return insert_regex_branch_in_position_nfa(nfa, dynamic_cast<const regex::RegexAlternation*>(to_insert));
+    } 
+    if (dynamic_cast<const regex::RegexCharSet*>(to_insert)) {
+        return insert_regex_char_set_in_position_nfa(nfa, dynamic_cast<const regex::RegexCharSet*>(to_insert));
+    }
+    if (dynamic_cast<const regex::RegexQuantifier*>(to_insert)) {
+        return insert_regex_quantifier_in_position_nfa(nfa, dynamic_cast<const regex::RegexQuantifier*>(to_insert));
+    }
+    if (dynamic_cast<const regex::RegexSequence*>(to_insert)) {
+        return insert_regex_sequence_in_position_nfa(nfa, dynamic_cast<const regex::RegexSequence*>(to_insert));
+    }
+
+    throw std::runtime_error("Tried to insert unknown regex type into NFA!");
+}
+
+lexer_generator::RegexPositions lexer_generator::insert_regex_branch_in_position_nfa(LexerAutomaton_t& nfa, const regex::RegexAlternation* const to_insert) {
+    RegexPositions alternation{false, {}, {}, {}};
+
+    for (const std::unique_ptr<regex::RegexBase>& branch : to_insert->get_branches()) {
+        const RegexPositions branch_positions = insert_regex_ast_in_position_nfa(nfa, branch.get());
+
+        alternation.nullable = alternation.nullable || branch_positions.nullable;
+        alternation.first.insert(alternation.first.end(), branch_positions.first.begin(), branch_positions.first.end());
+        alternation.last.insert(alternation.last.end(), branch_positions.last.begin(), branch_positions.last.end());
+        alternation.positions.insert(alternation.positions.end(), branch_positions.positions.begin(), branch_positions.positions.end());
+    }
+
+    return alternation;
+}
+
+lexer_generator::RegexPositions lexer_generator::insert_regex_char_set_in_position_nfa(LexerAutomaton_t& nfa, const regex::RegexCharSet* const to_insert) {
+    if (to_insert->get_range_set().empty()) { // can never be matched, so there is no position to enter
+        return RegexPositions{false, {}, {}, {}};
+    }
+    const LexerAutomaton_t::StateID_t position_state = nfa.add_state("");
+
+    return RegexPositions{false, {std::make_pair(position_state, to_insert->get_range_set())}, {position_state}, {position_state}};
+}
+
+lexer_generator::RegexPositions lexer_generator::insert_regex_quantifier_in_position_nfa(LexerAutomaton_t& nfa, const regex::RegexQuantifier* const to_insert) {
+    if (to_insert->get_max() == 0) {
+        return empty_positions();
+    }
+    const size_t copy_count = to_insert->get_min() + ((to_insert->get_max() == regex::RegexQuantifier::INFINITE) ? 1 : to_insert->get_max() - to_insert->get_min());
+
+    // the operand gets inserted only once, all other copies are cloned before any of them is connected
+    std::vector<RegexPositions> copies = {insert_regex_ast_in_position_nfa(nfa, to_insert->get_operand().get())};
+    copies.reserve(copy_count);
+    while (copies.size() < copy_count) {
+        copies.push_back(clone_positions(nfa, copies.front()));
+    }
+
+    RegexPositions quantifier = empty_positions();
+    for (size_t i = 0; i < to_insert->get_min(); i++) {
+        quantifier = concat_positions(nfa, quantifier, copies[i]);
+    }
+
+    if (to_insert->get_max() == regex::RegexQuantifier::INFINITE) {
+        return concat_positions(nfa, quantifier, optional_positions(repeat_positions(nfa, copies.back())));
+    }
+
+    // optional repetitions get nested (x(x(x)?)?)? so that the connection count grows linearly
+    RegexPositions optional_tail = empty_positions();
+    for (size_t i = to_insert->get_min(); i < copy_count; i++) {
+        optional_tail = optional_positions(concat_positions(nfa, copies[i], optional_tail));
+    }
+
+    return concat_positions(nfa, quantifier, optional_tail);
+}
+
+lexer_generator::RegexPositions lexer_generator::insert_regex_sequence_in_position_nfa(LexerAutomaton_t& nfa, const regex::RegexSequence* const to_insert) {
+    RegexPositions sequence = empty_positions();
+
+    for (const std::unique_ptr<regex::RegexBase>& element : to_insert->get_elements()) {
+        sequence = concat_positions(nfa, sequence, insert_regex_ast_in_position_nfa(nfa, element.get()));
+    }
+
+    return sequence;
+}
+
+lexer_generator::LexerAutomaton_t lexer_generator::minimize_dfa(const LexerAutomaton_t& to_minimize) {
+    using Signature_t = std::pair<size_t, std::vector<std::pair<size_t, std::vector<std::pair<utf8::Codepoint_t, utf8::Codepoint_t>>>>>;
+
+    std::map<LexerAutomaton_t::StateID_t, size_t> blocks;
+    std::map<std::string, size_t> accepting_blocks;
+    for (const auto& [state, value] : to_minimize.get_states()) {
+        blocks[state] = accepting_blocks.insert(std::make_pair(value, accepting_blocks.size())).first->second;
+    }
+
+    size_t block_count = accepting_blocks.size();
+    while (true) {
+        std::map<Signature_t, size_t> signatures;
+        std::map<LexerAutomaton_t::StateID_t, size_t> refined_blocks;
+
+        for (const auto& [state, _] : to_minimize.get_states()) {
+            Signature_t signature{blocks.at(state), {}};
+            for (const auto& [target_block, chars] : get_grouped_transitions(to_minimize, state, blocks, std::nullopt)) {
+                std::vector<std::pair<utf8::Codepoint_t, utf8::Codepoint_t>> ranges;
+                for (const regex::CharRange& range : chars.get_ranges()) {
+                    ranges.push_back(std::make_pair(range.start, range.end));
+                }
+                signature.second.push_back(std::make_pair(target_block, ranges));
+            }
+            refined_blocks[state] = signatures.insert(std::make_pair(signature, signatures.size())).first->second;
+        }
+
+        blocks = refined_blocks;
+        if (signatures.size() == block_count) {
+            break;
+        }
+        block_count = signatures.size();
+    }
+
+    // blocks are numbered in order of their first state, so the new state ids match the block ids
+    LexerAutomaton_t minimized{};
+    std::map<size_t, LexerAutomaton_t::StateID_t> representatives;
+    for (const auto& [state, value] : to_minimize.get_states()) {
+        if (representatives.insert(std::make_pair(blocks.at(state), state)).second) {
+            const LexerAutomaton_t::StateID_t minimized_state = minimized.add_state(value);
+            assert(minimized_state == blocks.at(state) && "BUG: Minimized dfa state ids don't match their blocks!");
+        }
+    }
+    for (const auto& [block, state] : representatives) {
+        for (const auto& [target_block, chars] : get_grouped_transitions(to_minimize, state, blocks, std::nullopt)) {
+            minimized.connect_states(block, target_block, chars);
+        }
+    }
+
+    return minimized;
+}
+
+lexer_generator::CountedRepetitions_t lexer_generator::find_counted_repetitions(const LexerAutomaton_t& dfa) {
+    const std::map<LexerAutomaton_t::StateID_t, size_t> groups = identity_groups(dfa);
+    std::map<LexerAutomaton_t::StateID_t, LexerAutomaton_t::ConnectionID_t> counted_connections;
+    std::set<LexerAutomaton_t::StateID_t> successors;
+
+    for (const auto& [state, _] : dfa.get_states()) {
+        const std::optional<LexerAutomaton_t::ConnectionID_t> counted_connection = find_counted_connection(dfa, state, groups);
+        if (counted_connection.has_value()) {
+            counted_connections[state] = counted_connection.value();
+            successors.insert(dfa.get_connection(counted_connection.value()).target);
+        }
+    }
+
+    CountedRepetitions_t repetitions;
+    for (const auto& [head, head_connection] : counted_connections) {
+        if (successors.count(head) != 0) {
+            continue;
+        }
+        CountedRepetition repetition{{head}, dfa.get_connection(head_connection).value.value()};
+
+        auto connection_iter = counted_connections.find(head);
+        while (connection_iter != counted_connections.end() && dfa.get_connection(connection_iter->second).value.value() == repetition.counted_chars) {
+            repetition.states.push_back(dfa.get_connection(connection_iter->second).target);
+            connection_iter = counted_connections.find(repetition.states.back());
+            if (repetition.states.size() > dfa.get_states().size()) {
+                throw std::runtime_error("BUG: Found cyclic chain of counted states!");
+            }
+        }
+        // the last state has to handle the counted chars either completely by a single transition or not at all
+        while (!repetition.states.empty() && has_partial_transition(dfa, repetition.states.back(), repetition.counted_chars)) {
+            repetition.states.pop_back();
+        }
+
+        if (repetition.states.size() > MIN_COUNTED_REPETITIONS) {
+            repetitions.insert(std::make_pair(head, repetition));
+        }
+    }
+
+    return repetitions;
+}
+
+void lexer_generator::write_dfa(std::ostream& output, const LexerAutomaton_t& dfa) {
+    std::vector<LexerAutomaton_t::ConnectionID_t> connections;
+
+    bcache::write_uint(output, dfa.get_states().size());
+    for (const auto& [state, value] : dfa.get_states()) {
+        assert(state < dfa.get_states().size() && "BUG: Tried to serialize dfa with non contiguous state ids!");
+        bcache::write_string(output, value);
+        const std::vector<LexerAutomaton_t::ConnectionID_t> outgoing_connections = dfa.get_outgoing_connection_ids(state);
+        connections.insert(connections.end(), outgoing_connections.begin(), outgoing_connections.end());
+    }
+
+    bcache::write_uint(output, connections.size());
+    for (const LexerAutomaton_t::ConnectionID_t connection_id : connections) {
+        const LexerAutomaton_t::Connection& connection = dfa.get_connection(connection_id);
+        bcache::write_uint(output, connection.source);
+        bcache::write_uint(output, connection.target);
+        bcache::write_uint(output, connection.value.value().get_ranges().size());
+        for (const regex::CharRange& range : connection.value.value().get_ranges()) {
+            bcache::write_uint(output, range.start);
+            bcache::write_uint(output, range.end);
+        }
+    }
+}
+
+lexer_generator::LexerAutomaton_t lexer_generator::read_dfa(std::istream& input) {
+    LexerAutomaton_t dfa{};
+
+    const uint64_t state_count = bcache::read_uint(input);
+    for (uint64_t i = 0; i < state_count; i++) {
+        dfa.add_state(bcache::read_string(input));
+    }
+
+    const uint64_t connection_count = bcache::read_uint(input);
+    for (uint64_t i = 0; i < connection_count; i++) {
+        const uint64_t source = bcache::read_uint(input);
+        const uint64_t target = bcache::read_uint(input);
+        if (source >= state_count || target >= state_count) {
+            throw std::runtime_error("Invalid dfa connection in cache entry!");
+        }
+        regex::CharRangeSet value{};
+        const uint64_t range_count = bcache::read_uint(input);
+        for (uint64_t range = 0; range < range_count; range++) {
+            const utf8::Codepoint_t start = (utf8::Codepoint_t)bcache::read_uint(input);
+            value.insert_char_range(regex::CharRange{start, (utf8::Codepoint_t)bcache::read_uint(input)});
+        }
+        dfa.connect_states(source, target, value);
+    }
+
+    return dfa;
+}
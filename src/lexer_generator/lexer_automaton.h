@@ -3,6 +3,7 @@
 #include <memory>
 #include <list>
 #include <ostream>
+#include <istream>
 #include <vector>
 #include <map>
 #include <set>
@@ -16,6 +17,19 @@
 namespace lexer_generator {
     typedef sm::Automaton<std::string, regex::CharRangeSet> LexerAutomaton_t;
 
+    struct RegexPositions { // first/last sets of a position (glushkov) automaton fragment
+        bool nullable;
+        std::vector<std::pair<LexerAutomaton_t::StateID_t, regex::CharRangeSet>> first; // entry positions with their incoming value
+        std::vector<LexerAutomaton_t::StateID_t> last;
+        std::vector<LexerAutomaton_t::StateID_t> positions; // all states of the fragment, needed for cloning
+    };
+
+    struct CountedRepetition { // chain of states that only differ in how many counted chars they still accept
+        std::vector<LexerAutomaton_t::StateID_t> states;
+        regex::CharRangeSet counted_chars;
+    };
+    typedef std::map<LexerAutomaton_t::StateID_t, CountedRepetition> CountedRepetitions_t; // indexed by the first state of the chain
+
     void resolve_connection_collisions(
         const LexerAutomaton_t::Connection& to_add, 
         std::vector<std::pair<regex::CharRangeSet, std::set<LexerAutomaton_t::StateID_t>>>& dfa_connections
@@ -51,4 +65,27 @@ namespace lexer_generator {
         const LexerAutomaton_t::StateID_t root_state, 
         const regex::RegexSequence* const to_insert
     );
+
+    // epsilon-free construction with one state per char set occurrence; returns whether the rule matches the empty input
+    bool insert_rule_in_position_nfa(LexerAutomaton_t& nfa, const LexerAutomaton_t::StateID_t root_state, const TokenDefinition& to_insert);
+    // inserts all rules, leading literals shared by multiple rules get a single position; the root value gets resolved for empty matching rules
+    void insert_rules_in_position_nfa(LexerAutomaton_t& nfa, const LexerAutomaton_t::StateID_t root_state, const std::vector<TokenDefinition>& to_insert);
+    void connect_positions(LexerAutomaton_t& nfa, const std::vector<LexerAutomaton_t::StateID_t>& sources, const RegexPositions& targets);
+    // copies the fragment with all of its inner connections, the fragment mustn't be connected to other states yet
+    RegexPositions clone_positions(LexerAutomaton_t& nfa, const RegexPositions& to_clone);
+
+    RegexPositions insert_regex_ast_in_position_nfa(LexerAutomaton_t& nfa, const regex::RegexBase* const to_insert);
+    RegexPositions insert_regex_branch_in_position_nfa(LexerAutomaton_t& nfa, const regex::RegexAlternation* const to_insert);
+    RegexPositions insert_regex_char_set_in_position_nfa(LexerAutomaton_t& nfa, const regex::RegexCharSet* const to_insert);
+    RegexPositions insert_regex_quantifier_in_position_nfa(LexerAutomaton_t& nfa, const regex::RegexQuantifier* const to_insert);
+    RegexPositions insert_regex_sequence_in_position_nfa(LexerAutomaton_t& nfa, const regex::RegexSequence* const to_insert);
+
+    // merges equivalent states (moore refinement), the root state keeps the id 0
+    LexerAutomaton_t minimize_dfa(const LexerAutomaton_t& to_minimize);
+    // chains like the ones generated by [0-9]{1,64} which can be implemented as a single state with a counter
+    CountedRepetitions_t find_counted_repetitions(const LexerAutomaton_t& dfa);
+
+    // compact binary format used by the generation cache, the state ids have to be contiguous and start at 0
+    void write_dfa(std::ostream& output, const LexerAutomaton_t& dfa);
+    LexerAutomaton_t read_dfa(std::istream& input);
 }
\ No newline at end of file
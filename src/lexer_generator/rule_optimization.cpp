@@ -0,0 +1,14 @@
+#include "rule_optimization.h"
+
+#include "regex/regex_simplification.h"
+
+std::vector<lexer_generator::TokenDefinition> lexer_generator::optimize_rules(const std::vector<TokenDefinition>& to_optimize) {
+    std::vector<TokenDefinition> optimized;
+    optimized.reserve(to_optimize.size());
+
+    for (const TokenDefinition& rule : to_optimize) {
+        optimized.push_back(TokenDefinition{rule.ignore_token, rule.priority, rule.name, regex::simplify_regex(rule.token_regex.get())});
+    }
+
+    return optimized;
+}
@@ -0,0 +1,10 @@
+#pragma once
+
+#include <vector>
+
+#include "token_definition.h"
+
+namespace lexer_generator {
+    // simplifies the regex of every rule; names, ignore flags and priorities are kept as they are
+    std::vector<TokenDefinition> optimize_rules(const std::vector<TokenDefinition>& to_optimize);
+}
@@ -33,7 +33,12 @@ bool process_rule_file(const std::string_view& module_name, const std::string_vi
             code_gen::generate_lexer(std::string(module_name), palex_rules.token_definitions, config);
         }
         if (config.generate_parser) {
-            parser_generator::shift_reduce_parsers::code_gen::generate_parser(std::string(module_name), palex_rules.productions, config);
+            parser_generator::shift_reduce_parsers::code_gen::generate_parser(
+                std::string(module_name), 
+                palex_rules.productions, 
+                palex_rules.precedence_table, 
+                config
+            );
         }
     } catch (const std::exception& err) {
         std::cerr << "Error: " << err.what() << std::endl;
@@ -0,0 +1,179 @@
+#include "grammar_reduction.h"
+
+#include <cstddef>
+#include <map>
+#include <algorithm>
+#include <optional>
+
+#include "util/palex_except.h"
+
+namespace parser_generator {
+    // helper functions
+    bool is_productive(const Production& production, const std::set<std::string>& productive_nonterminals);
+    std::vector<Production> remove_nonterminals(const std::vector<Production>& productions, const std::set<std::string>& to_remove);
+    std::map<std::string, size_t> count_nonterminal_uses(const std::vector<Production>& productions);
+    std::optional<std::vector<Production>> try_inline_nonterminal(const std::vector<Production>& productions, const std::string& to_inline);
+    void report_nonterminals(std::ostream& output, const std::set<std::string>& nonterminals, const std::string& description);
+
+    bool is_productive(const Production& production, const std::set<std::string>& productive_nonterminals) {
+        return std::all_of(production.symbols.begin(), production.symbols.end(), [&](const Symbol& symbol) -> bool {
+            return symbol.type == Symbol::SymbolType::TERMINAL || productive_nonterminals.find(symbol.identifier) != productive_nonterminals.end();
+        });
+    }
+
+    std::vector<Production> remove_nonterminals(const std::vector<Production>& productions, const std::set<std::string>& to_remove) {
+        std::vector<Production> remaining_productions;
+        for (const Production& production : productions) {
+            const bool uses_removed = std::any_of(production.symbols.begin(), production.symbols.end(), [&](const Symbol& symbol) -> bool {
+                return symbol.type == Symbol::SymbolType::NONTERMINAL && to_remove.find(symbol.identifier) != to_remove.end();
+            });
+            if (!uses_removed && to_remove.find(production.name) == to_remove.end()) {
+                remaining_productions.push_back(production);
+            }
+        }
+        return remaining_productions;
+    }
+
+    std::map<std::string, size_t> count_nonterminal_uses(const std::vector<Production>& productions) {
+        std::map<std::string, size_t> use_counts;
+        for (const Production& production : productions) {
+            for (const Symbol& symbol : production.symbols) {
+                if (symbol.type == Symbol::SymbolType::NONTERMINAL) {
+                    use_counts[symbol.identifier]++;
+                }
+            }
+        }
+        return use_counts;
+    }
+
+    std::optional<std::vector<Production>> try_inline_nonterminal(const std::vector<Production>& productions, const std::string& to_inline) {
+        std::vector<Production> inlined_productions;
+        for (const Production& production : productions) {
+            if (production.name == to_inline) {
+                if (!production.transparent) { // the AST builder observes the nonterminal
+                    return std::nullopt;
+                }
+                inlined_productions.push_back(production);
+            }
+        }
+        const auto user = std::find_if(productions.begin(), productions.end(), [&](const Production& production) -> bool {
+            return std::find(production.symbols.begin(), production.symbols.end(), Symbol{Symbol::SymbolType::NONTERMINAL, to_inline}) != production.symbols.end();
+        });
+        if (inlined_productions.empty() || user == productions.end() || user->name == to_inline) {
+            return std::nullopt;
+        }
+
+        // each transparent production only forwards a single nonterminal, so its value stands in for the inlined one
+        const auto inlined_position = std::find(user->symbols.begin(), user->symbols.end(), Symbol{Symbol::SymbolType::NONTERMINAL, to_inline});
+        std::vector<Production> expanded_productions;
+        for (const Production& inlined_production : inlined_productions) {
+            Production expanded = *user;
+            expanded.symbols[inlined_position - user->symbols.begin()] = inlined_production.symbols.front();
+            const bool is_cycle = expanded.symbols.size() == 1 && expanded.symbols.front() == Symbol{Symbol::SymbolType::NONTERMINAL, expanded.name};
+            if (is_cycle || std::find(productions.begin(), productions.end(), expanded) != productions.end()) {
+                return std::nullopt; // the grammar is ambiguous, so the conflicts are left to the table generation
+            }
+            expanded_productions.push_back(expanded);
+        }
+
+        std::vector<Production> result;
+        for (auto production = productions.begin(); production != productions.end(); production++) {
+            if (production == user) {
+                result.insert(result.end(), expanded_productions.begin(), expanded_productions.end());
+            } else if (production->name != to_inline) {
+                result.push_back(*production);
+            }
+        }
+        return result;
+    }
+
+    void report_nonterminals(std::ostream& output, const std::set<std::string>& nonterminals, const std::string& description) {
+        for (const std::string& nonterminal : nonterminals) {
+            output << description << " '" << nonterminal << "'\n";
+        }
+    }
+
+    GrammarReduction reduce_grammar(const std::vector<Production>& productions) {
+        GrammarReduction reduction{productions, {}, {}, {}};
+
+        // unproductive nonterminals have to go first, as removing their productions can make other nonterminals unreachable
+        const std::set<std::string> productive_nonterminals = collect_productive_nonterminals(reduction.productions);
+        if (productive_nonterminals.find(ENTRY_PRODUCTION_NAME) == productive_nonterminals.end()) {
+            throw palex_except::ValidationError("The entry production can't derive any sequence of tokens!");
+        }
+        for (const Production& production : reduction.productions) {
+            if (productive_nonterminals.find(production.name) == productive_nonterminals.end()) {
+                reduction.unproductive_nonterminals.insert(production.name);
+            }
+        }
+        reduction.productions = remove_nonterminals(reduction.productions, reduction.unproductive_nonterminals);
+
+        const std::set<std::string> reachable_nonterminals = collect_reachable_nonterminals(reduction.productions);
+        for (const Production& production : reduction.productions) {
+            if (reachable_nonterminals.find(production.name) == reachable_nonterminals.end()) {
+                reduction.unreachable_nonterminals.insert(production.name);
+            }
+        }
+        reduction.productions = remove_nonterminals(reduction.productions, reduction.unreachable_nonterminals);
+
+        bool inlined = true;
+        while (inlined) { // inlining can leave the user of a nonterminal as the only user of another one
+            inlined = false;
+            for (const auto& [nonterminal, use_count] : count_nonterminal_uses(reduction.productions)) {
+                if (use_count != 1) {
+                    continue;
+                }
+                const std::optional<std::vector<Production>> inlined_productions = try_inline_nonterminal(reduction.productions, nonterminal);
+                if (inlined_productions.has_value()) {
+                    reduction.productions = inlined_productions.value();
+                    reduction.inlined_nonterminals.insert(nonterminal);
+                    inlined = true;
+                    break;
+                }
+            }
+        }
+        return reduction;
+    }
+
+    std::set<std::string> collect_productive_nonterminals(const std::vector<Production>& productions) {
+        std::set<std::string> productive_nonterminals;
+        bool changed = true;
+        while (changed) {
+            changed = false;
+            for (const Production& production : productions) {
+                if (productive_nonterminals.find(production.name) == productive_nonterminals.end() && is_productive(production, productive_nonterminals)) {
+                    productive_nonterminals.insert(production.name);
+                    changed = true;
+                }
+            }
+        }
+        return productive_nonterminals;
+    }
+
+    std::set<std::string> collect_reachable_nonterminals(const std::vector<Production>& productions) {
+        std::set<std::string> reachable_nonterminals = {ENTRY_PRODUCTION_NAME};
+        std::vector<std::string> to_visit = {ENTRY_PRODUCTION_NAME};
+        while (!to_visit.empty()) {
+            const std::string nonterminal = to_visit.back();
+            to_visit.pop_back();
+            for (const Production& production : productions) {
+                if (production.name != nonterminal) {
+                    continue;
+                }
+                for (const Symbol& symbol : production.symbols) {
+                    if (symbol.type == Symbol::SymbolType::NONTERMINAL && reachable_nonterminals.insert(symbol.identifier).second) {
+                        to_visit.push_back(symbol.identifier);
+                    }
+                }
+            }
+        }
+        return reachable_nonterminals;
+    }
+
+    std::ostream& operator<<(std::ostream& output, const GrammarReduction& to_print) {
+        report_nonterminals(output, to_print.unproductive_nonterminals, "Removed the unproductive nonterminal");
+        report_nonterminals(output, to_print.unreachable_nonterminals, "Removed the unreachable nonterminal");
+        report_nonterminals(output, to_print.inlined_nonterminals, "Inlined the nonterminal");
+        return output;
+    }
+}
@@ -0,0 +1,25 @@
+#pragma once
+
+#include <vector>
+#include <set>
+#include <string>
+#include <ostream>
+
+#include "production_definition.h"
+
+namespace parser_generator {
+    struct GrammarReduction {
+        std::vector<Production> productions;
+        std::set<std::string> unproductive_nonterminals; // can't derive any sequence of tokens
+        std::set<std::string> unreachable_nonterminals; // can't be derived from the entry production
+        std::set<std::string> inlined_nonterminals; // used once and only produced by transparent productions
+    };
+
+    // Removes the useless nonterminals and inlines the ones the AST builder doesn't observe, the productions have to be valid.
+    // The remaining productions keep their order.
+    GrammarReduction reduce_grammar(const std::vector<Production>& productions);
+    std::set<std::string> collect_productive_nonterminals(const std::vector<Production>& productions);
+    std::set<std::string> collect_reachable_nonterminals(const std::vector<Production>& productions);
+
+    std::ostream& operator<<(std::ostream& output, const GrammarReduction& to_print); // reports the removed nonterminals
+}
@@ -0,0 +1,44 @@
+#include "operator_precedence.h"
+
+namespace parser_generator {
+    std::optional<OperatorPrecedence> get_production_precedence(const Production& production, const PrecedenceTable_t& precedence_table) {
+        for (auto symbol = production.symbols.rbegin(); symbol != production.symbols.rend(); symbol++) {
+            if (symbol->type != Symbol::SymbolType::TERMINAL) {
+                continue;
+            }
+            const auto precedence = precedence_table.find(symbol->identifier);
+            if (precedence != precedence_table.end()) {
+                return precedence->second;
+            }
+        }
+        return std::nullopt;
+    }
+
+    ConflictResolution resolve_shift_reduce_conflict(
+        const Production& to_reduce, 
+        const std::string& shifted_terminal, 
+        const PrecedenceTable_t& precedence_table
+    ) {
+        const std::optional<OperatorPrecedence> production_precedence = get_production_precedence(to_reduce, precedence_table);
+        const auto terminal_precedence = precedence_table.find(shifted_terminal);
+        if (!production_precedence.has_value() || terminal_precedence == precedence_table.end()) {
+            return ConflictResolution::UNRESOLVED;
+        }
+        if (production_precedence.value().level != terminal_precedence->second.level) {
+            return production_precedence.value().level > terminal_precedence->second.level ? ConflictResolution::REDUCE : ConflictResolution::SHIFT;
+        }
+        switch (terminal_precedence->second.associativity) { // terminals of the same level share their associativity
+            case Associativity::LEFT:
+                return ConflictResolution::REDUCE;
+            case Associativity::RIGHT:
+                return ConflictResolution::SHIFT;
+            case Associativity::NONASSOC:
+            default:
+                return ConflictResolution::SYNTAX_ERROR;
+        }
+    }
+
+    bool operator==(const OperatorPrecedence& first, const OperatorPrecedence& second) {
+        return first.level == second.level && first.associativity == second.associativity;
+    }
+}
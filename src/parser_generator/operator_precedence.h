@@ -0,0 +1,40 @@
+#pragma once
+
+#include <cstddef>
+#include <string>
+#include <map>
+#include <optional>
+
+#include "production_definition.h"
+
+namespace parser_generator {
+    enum class Associativity {
+        LEFT,
+        RIGHT,
+        NONASSOC
+    };
+
+    struct OperatorPrecedence {
+        size_t level; // later declarations get higher levels and bind tighter
+        Associativity associativity;
+    };
+
+    using PrecedenceTable_t = std::map<std::string, OperatorPrecedence>; // terminal name -> its precedence
+
+    enum class ConflictResolution {
+        UNRESOLVED, // the production or the terminal has no precedence, so the conflict stays an error of the grammar
+        SHIFT,
+        REDUCE,
+        SYNTAX_ERROR // non-associative operators of the same level must not follow each other
+    };
+
+    // the precedence of a production is the one of its last terminal that has a precedence
+    std::optional<OperatorPrecedence> get_production_precedence(const Production& production, const PrecedenceTable_t& precedence_table);
+    ConflictResolution resolve_shift_reduce_conflict(
+        const Production& to_reduce, 
+        const std::string& shifted_terminal, 
+        const PrecedenceTable_t& precedence_table
+    );
+
+    bool operator==(const OperatorPrecedence& first, const OperatorPrecedence& second);
+}
@@ -21,6 +21,7 @@ namespace parser_generator {
         std::string name;
         std::vector<Symbol> symbols;
         std::string tag;
+        bool transparent = false; // a unit production that is reduced without notifying the AST builder
 
         bool is_entry() const;
         std::string get_representation() const;
@@ -9,54 +9,140 @@
 #include <set>
 #include <variant>
 #include <algorithm>
+#include <optional>
+#include <cstdint>
 
 #include "templates/template_completion.h"
+#include "templates/amalgamation.h"
 
 #include "util/stream_format.h"
 #include "util/Visitor.h"
 
 #include "parser_generator/shift_reduce_parsers/parser_state.h"
+#include "parser_generator/shift_reduce_parsers/table_compression.h"
 
 #include "cpp_parser_header.h"
 #include "cpp_parser_source.h"
+#include "cpp_parser_states_source.h"
 #include "cpp_types_header.h"
 #include "cpp_types_source.h"
 #include "cpp_ast_builder_header.h"
 
-const std::string LOOKAHEAD_FUNCTION_COMPLETION = 
-R"(size_t %MODULE_NAMESPACE%::%UNIT_NAME%Parser::get_lookahead_id() const {
-    const static std::map<std::array<%UNIT_NAME%Token::TokenType, LOOKAHEAD>, size_t> lookahead_mappings = {
-%LOOKAHEAD_MAPPINGS%    };
-
-    std::array<%UNIT_NAME%Token::TokenType, LOOKAHEAD> lookahead_key;
-    size_t i = 0;
-    for (auto iter = this->lookahead.begin(); iter != this->lookahead.end(); iter++) {
-        lookahead_key[i++] = iter->type;
-    }
-    const auto mapping = lookahead_mappings.find(lookahead_key);
-    return (mapping == lookahead_mappings.end()) ? ERROR_STATE : mapping->second; 
-})";
-
 // helper functions
-void complete_lookahead_function_declaration(const input::PalexConfig& config, std::ostream& output);
+void complete_lookahead_function_declaration(const std::string& unit_name, const input::PalexConfig& config, std::ostream& output);
 void complete_nonterminal_enum(const std::vector<parser_generator::Production>& productions, std::ostream& output);
-void complete_init_lookahead(const input::PalexConfig& config, std::ostream& output);
-void complete_shift_function(const input::PalexConfig& config, std::ostream& output);
+void complete_fetch_lookahead(const input::PalexConfig& config, std::ostream& output);
+void complete_shift_function(const std::string& unit_name, const input::PalexConfig& config, std::ostream& output);
+void complete_call_error_handler(const std::string& unit_name, const input::PalexConfig& config, std::ostream& output);
 void complete_lookahead_function(
     const parser_generator::shift_reduce_parsers::ParserTable& parser_table, 
     const std::string& unit_name, 
     const input::PalexConfig& config, 
     std::ostream& output
 );
-void complete_lookahead_mappings(const parser_generator::shift_reduce_parsers::ParserTable& parser_table, const std::string& unit_name, std::ostream& output);
-void complete_goto_states(const parser_generator::shift_reduce_parsers::ParserTable& parser_table, const std::string& unit_name, std::ostream& output);
-void complete_parser_table(const parser_generator::shift_reduce_parsers::ParserTable& parser_table, const std::string& unit_name, const input::PalexConfig& config, std::ostream& output);
-void complete_lookahead_switch(const input::PalexConfig& config, std::ostream& output);
-void complete_lookahead_case(
-    const parser_generator::shift_reduce_parsers::Lookahead_t& lookahead, 
+void complete_lookahead_id_decision(
+    const std::vector<std::pair<parser_generator::shift_reduce_parsers::Lookahead_t, size_t>>& candidates,
+    const size_t depth,
     const std::string& unit_name,
-    const std::map<parser_generator::shift_reduce_parsers::Lookahead_t, size_t>& mappings,
-    std::ostream& output);
+    const input::PalexConfig& config,
+    std::ostream& output
+);
+void complete_goto_states(
+    const parser_generator::shift_reduce_parsers::ParserTable& parser_table, 
+    const std::string& unit_name, 
+    const input::PalexConfig& config, 
+    std::ostream& output
+);
+void complete_goto_state_cases(
+    const parser_generator::shift_reduce_parsers::ParserTable& parser_table, 
+    const std::string& unit_name, 
+    const size_t first_state,
+    const size_t end_state,
+    std::ostream& output
+);
+void complete_parser_table(const parser_generator::shift_reduce_parsers::ParserTable& parser_table, const std::string& unit_name, const input::PalexConfig& config, std::ostream& output);
+void complete_parser_states(
+    const parser_generator::shift_reduce_parsers::ParserTable& parser_table, 
+    const std::string& unit_name, 
+    const input::PalexConfig& config, 
+    const size_t first_state,
+    const size_t end_state,
+    std::ostream& output
+);
+void complete_token_switch(
+    const parser_generator::shift_reduce_parsers::ParserTable& parser_table, 
+    const parser_generator::shift_reduce_parsers::ParserStateID_t state_id,
+    const std::string& unit_name, 
+    const input::PalexConfig& config, 
+    std::ostream& output
+);
+void complete_lookahead_decision(
+    const parser_generator::shift_reduce_parsers::ParserTable& parser_table, 
+    const parser_generator::shift_reduce_parsers::ParserStateID_t state_id,
+    const std::vector<const parser_generator::shift_reduce_parsers::Action*>& candidates,
+    const size_t depth,
+    const std::string& unit_name, 
+    const input::PalexConfig& config, 
+    std::ostream& output
+);
+void complete_action(
+    const parser_generator::shift_reduce_parsers::Action& action, 
+    const parser_generator::shift_reduce_parsers::ParserTable& parser_table, 
+    const std::string& unit_name, 
+    const input::PalexConfig& config, 
+    std::ostream& output
+);
+void complete_lookahead_error(
+    const parser_generator::shift_reduce_parsers::ParserTable& parser_table, 
+    const parser_generator::shift_reduce_parsers::ParserStateID_t state_id,
+    const std::string& unit_name, 
+    const input::PalexConfig& config, 
+    std::ostream& output
+);
+void complete_reduction(const parser_generator::Production& to_reduce, const std::string& unit_name, const input::PalexConfig& config, std::ostream& output);
+void complete_parse_function(
+    const parser_generator::shift_reduce_parsers::ParserTable& parser_table, 
+    const std::vector<parser_generator::Production>& productions,
+    const std::string& unit_name, 
+    const input::PalexConfig& config, 
+    std::ostream& output
+);
+void complete_goto_function(const parser_generator::shift_reduce_parsers::ParserTable& parser_table, const std::string& unit_name, const input::PalexConfig& config, std::ostream& output);
+void complete_parser_tables(
+    const parser_generator::shift_reduce_parsers::ParserTable& parser_table, 
+    const std::vector<parser_generator::Production>& productions,
+    const std::string& unit_name, 
+    const input::PalexConfig& config, 
+    std::ostream& output
+);
+void complete_table_array(const std::string& name, const std::string& type, const std::vector<std::string>& values, std::ostream& output);
+void complete_terminal_column_function(const std::map<parser_generator::shift_reduce_parsers::Lookahead_t, size_t>& columns, const std::string& unit_name, std::ostream& output);
+void complete_table_reductions(const std::vector<parser_generator::Production>& reduced_productions, std::ostream& output);
+std::map<parser_generator::shift_reduce_parsers::Lookahead_t, size_t> create_lookahead_columns(
+    const parser_generator::shift_reduce_parsers::ParserTable& parser_table, 
+    const input::PalexConfig& config
+);
+std::vector<parser_generator::Production> collect_reduced_productions(const parser_generator::shift_reduce_parsers::ParserTable& parser_table);
+std::string get_smallest_uint_type(const size_t max_value);
+std::vector<std::string> to_string_vector(const std::vector<size_t>& to_convert);
+void complete_parser_shard_declarations(const std::string& unit_name, const input::PalexConfig& config, std::ostream& output);
+void complete_state_error_function(
+    const parser_generator::shift_reduce_parsers::ParserTable& parser_table, 
+    const std::string& unit_name, 
+    const input::PalexConfig& config, 
+    std::ostream& output
+);
+size_t get_parser_states_per_shard(const size_t state_count, const input::PalexConfig& config);
+bool has_parser_shards(const input::PalexConfig& config);
+bool uses_state_error_function(const input::PalexConfig& config);
+std::vector<std::string> get_parser_instantiations(const std::string& unit_name, const input::PalexConfig& config);
+void complete_parser_instantiations(const std::string& unit_name, const input::PalexConfig& config, std::ostream& output);
+void complete_parser_shard_instantiations(const std::string& unit_name, const size_t shard, const input::PalexConfig& config, std::ostream& output);
+bool has_default_action(const parser_generator::shift_reduce_parsers::ParserState& state);
+const parser_generator::shift_reduce_parsers::Action* find_default_action(const parser_generator::shift_reduce_parsers::ParserState& state);
+const parser_generator::shift_reduce_parsers::Lookahead_t* get_action_lookahead(const parser_generator::shift_reduce_parsers::Action& action);
+bool performs_same_operation(const parser_generator::shift_reduce_parsers::Action& first, const parser_generator::shift_reduce_parsers::Action& second);
+void complete_lookahead_case(const parser_generator::shift_reduce_parsers::Lookahead_t& lookahead, const std::string& unit_name, std::ostream& output);
 void complete_lookahead_printer(const input::PalexConfig& config, std::ostream& output);
 void complete_position_printer(const input::PalexConfig& config, std::ostream& output);
 std::string upper_case_str(const std::string& to_convert);
@@ -67,13 +153,37 @@ std::map<parser_generator::shift_reduce_parsers::Lookahead_t, size_t> create_loo
 std::string create_state_error_message(const parser_generator::shift_reduce_parsers::ParserState& state);
 std::string expected_tokens_to_string(const parser_generator::shift_reduce_parsers::ParserState& state, const std::string& unit_name);
 void complete_reduce_methods(const std::vector<parser_generator::Production>& productions, std::ostream& output);
+void complete_static_reduce_methods(const std::vector<parser_generator::Production>& productions, std::ostream& output);
 void complete_lookahead_to_string(const input::PalexConfig& config, std::ostream& output);
 
-void complete_lookahead_function_declaration(const input::PalexConfig& config, std::ostream& output) {
+std::map<std::string_view, templates::TemplateCompleter_t> create_parser_header_completers(
+    const std::string& unit_name,
+    const std::vector<parser_generator::Production>& productions,
+    const parser_generator::shift_reduce_parsers::ParserTable& parser_table,
+    const input::PalexConfig& config
+);
+std::map<std::string_view, templates::TemplateCompleter_t> create_parser_source_completers(
+    const std::string& unit_name,
+    const std::vector<parser_generator::Production>& productions,
+    const parser_generator::shift_reduce_parsers::ParserTable& parser_table,
+    const input::PalexConfig& config
+);
+std::map<std::string_view, templates::TemplateCompleter_t> create_ast_builder_header_completers(
+    const std::string& unit_name,
+    const std::vector<parser_generator::Production>& productions,
+    const input::PalexConfig& config
+);
+
+void complete_lookahead_function_declaration(const std::string& unit_name, const input::PalexConfig& config, std::ostream& output) {
     if (config.lookahead <= 1) {
         return;
     }
-    output << "size_t get_lookahead_id() const;";
+    output << "const " << unit_name << "Token& peek_lookahead(const size_t offset) const;";
+    if (config.table_driven_parser) {
+        output << sfmt::Indentation{3};
+        output << "\nsize_t get_lookahead_id() const;";
+        output << sfmt::Indentation{-3};
+    }
 }
 
 void complete_nonterminal_enum(const std::vector<parser_generator::Production>& productions, std::ostream& output) {
@@ -89,35 +199,54 @@ void complete_nonterminal_enum(const std::vector<parser_generator::Production>&
     output << sfmt::Indentation{-2};
 }
 
-void complete_init_lookahead(const input::PalexConfig& config, std::ostream& output) {
+void complete_fetch_lookahead(const input::PalexConfig& config, std::ostream& output) {
     output << sfmt::Indentation{2};
     if (config.lookahead <= 1) {
-        output << "this->next_token();\n"
-                  "this->lookahead = this->current_token();";
+        output << "if (this->lookahead_consumed) {\n"
+                  "    this->lexer.next_unignored_token();\n"
+                  "    this->lookahead_consumed = false;\n"
+                  "}";
     } else {
-        output << "while (this->lookahead.size() < LOOKAHEAD) {\n"
-                  "    this->next_token();\n"
-                  "    this->lookahead.push_back(this->current_token());\n"
+        output << "while (this->lookahead_count < token_count) { // states that decide early don't need the whole buffer\n"
+                  "    this->lexer.next_unignored_token();\n"
+                  "    this->lookahead_buffer[(this->lookahead_begin + this->lookahead_count++) % LOOKAHEAD] = this->lexer.current_token();\n"
                   "}";
     }
     output << sfmt::Indentation{-2};
 }
 
-void complete_shift_function(const input::PalexConfig& config, std::ostream& output) {
+void complete_shift_function(const std::string& unit_name, const input::PalexConfig& config, std::ostream& output) {
     output << sfmt::Indentation{2};
     if (config.lookahead <= 1) {
-        output << "this->parser_stack.push(ParserStackInfo{next_state, ((size_t)this->lookahead.type << 1) | TERMINAL_SYMBOL_TYPE_FLAG});\n"
-                  "this->ast_builder.shift_token(this->lookahead);\n"
-                  "this->next_token();\n"
-                  "this->lookahead = this->current_token();";
+        output << "this->parser_stack.push(ParserStackInfo{(StackStateID_t)next_state, (SymbolType_t)(((size_t)this->lexer.current_token().type << 1) | " << unit_name << "_detail::TERMINAL_SYMBOL_TYPE_FLAG)});\n"
+                  "this->ast_builder.shift_token(this->lexer.current_token());\n"
+                  "this->lookahead_consumed = true; // the next token is only read once a state needs it";
     } else {
-        output << "this->parser_stack.push(ParserStackInfo{next_state, ((size_t)this->lookahead.front().type << 1) | TERMINAL_SYMBOL_TYPE_FLAG});\n"
-                  "this->ast_builder.shift_token(this->lookahead.front());\n"
-                  "this->lookahead.pop_front();\n"
-                  "if (this->lookahead.size() < LOOKAHEAD) {\n"
-                  "    this->next_token();\n"
-                  "    this->lookahead.push_back(this->current_token());\n"
-                  "}";
+        output << "this->parser_stack.push(ParserStackInfo{(StackStateID_t)next_state, (SymbolType_t)(((size_t)this->peek_lookahead(0).type << 1) | " << unit_name << "_detail::TERMINAL_SYMBOL_TYPE_FLAG)});\n"
+                  "this->ast_builder.shift_token(this->peek_lookahead(0));\n"
+                  "this->lookahead_begin = (this->lookahead_begin + 1) % LOOKAHEAD;\n"
+                  "this->lookahead_count--; // refilled by fetch_lookahead() once a state needs it";
+    }
+    output << sfmt::Indentation{-2};
+}
+
+void complete_call_error_handler(const std::string& unit_name, const input::PalexConfig& config, std::ostream& output) {
+    output << sfmt::Indentation{2};
+    if (config.lookahead <= 1) { // the lookahead is read from the lexer directly, so the handler gets a copy of it
+        output << unit_name << "Token lookahead = this->lexer.current_token();\n"
+                  "this->handle_parse_error(\"Received '\" + " << unit_name << "_detail::lookahead_to_string(lookahead) + \"', \" + std::string(error_message), expected_tokens, lookahead);";
+    } else {
+        output << "std::deque<" << unit_name << "Token> lookahead;\n"
+                  "for (size_t i = 0; i < this->lookahead_count; i++) {\n"
+                  "    lookahead.push_back(this->peek_lookahead(i));\n"
+                  "}\n"
+                  "this->handle_parse_error(\"Received '\" + " << unit_name << "_detail::lookahead_to_string(lookahead) + \"', \" + std::string(error_message), expected_tokens, lookahead);\n"
+                  "this->lookahead_begin = 0; // the error handler may have consumed or replaced tokens\n"
+                  "this->lookahead_count = 0;\n"
+                  "for (auto token = lookahead.begin(); token != lookahead.end() && this->lookahead_count < LOOKAHEAD; token++) {\n"
+                  "    this->lookahead_buffer[this->lookahead_count++] = *token;\n"
+                  "}\n"
+                  "this->fetch_lookahead();";
     }
     output << sfmt::Indentation{-2};
 }
@@ -128,39 +257,93 @@ void complete_lookahead_function(
     const input::PalexConfig& config, 
     std::ostream& output
 ) {
-    using namespace std::placeholders;
-
     if (config.lookahead <= 1) {
         return;
     }
-    const std::map<std::string_view, templates::TemplateCompleter_t> completers = { 
-        {"UNIT_NAME", templates::constant_completer(unit_name)},
-        {"MODULE_NAMESPACE", templates::constant_completer(config.module_name)},
-        {"LOOKAHEAD_MAPPINGS", std::bind(complete_lookahead_mappings, parser_table, unit_name, _1)}
-    };
-    templates::write_template_to_stream(LOOKAHEAD_FUNCTION_COMPLETION.c_str(), output, completers);
+    output << sfmt::Indentation{1};
+    output << "template<class Lexer_t, class ASTBuilder_t>\n"
+              "const " << unit_name << "Token& " << unit_name << "BasicParser<Lexer_t, ASTBuilder_t>::peek_lookahead(const size_t offset) const {\n"
+              "    return this->lookahead_buffer[(this->lookahead_begin + offset) % LOOKAHEAD];\n"
+              "}";
+    if (config.table_driven_parser) {
+        std::vector<std::pair<parser_generator::shift_reduce_parsers::Lookahead_t, size_t>> candidates;
+        for (const auto& [lookahead, id] : create_lookahead_mappings(parser_table)) {
+            if (lookahead.size() == config.lookahead) {
+                candidates.push_back({lookahead, id});
+            }
+        }
+        output << "\n\n"
+                  "template<class Lexer_t, class ASTBuilder_t>\n"
+                  "size_t " << unit_name << "BasicParser<Lexer_t, ASTBuilder_t>::get_lookahead_id() const {\n";
+        output << sfmt::Indentation{1};
+        complete_lookahead_id_decision(candidates, 0, unit_name, config, output);
+        output << "return " << unit_name << "_detail::ERROR_STATE;\n";
+        output << sfmt::Indentation{-1};
+        output << "}";
+    }
+    output << sfmt::Indentation{-1};
 }
 
-void complete_lookahead_mappings(const parser_generator::shift_reduce_parsers::ParserTable& parser_table, const std::string& unit_name, std::ostream& output) {
-    output << sfmt::Indentation{2};
-    for (const auto& [lookahead, id] : create_lookahead_mappings(parser_table)) {
-        output << "{{";
-        for (size_t i = 0; i < lookahead.size(); i++) {
-            if (i != 0) {
-                output << ", ";
-            }
-            output << unit_name << "Token::TokenType::" << lookahead[i].identifier;
+void complete_lookahead_id_decision(
+    const std::vector<std::pair<parser_generator::shift_reduce_parsers::Lookahead_t, size_t>>& candidates,
+    const size_t depth,
+    const std::string& unit_name,
+    const input::PalexConfig& config,
+    std::ostream& output
+) {
+    std::map<std::string, std::vector<std::pair<parser_generator::shift_reduce_parsers::Lookahead_t, size_t>>> branches;
+    for (const auto& candidate : candidates) {
+        branches[candidate.first[depth].identifier].push_back(candidate);
+    }
+    output << "switch (this->peek_lookahead(" << depth << ").type) {\n";
+    output << sfmt::Indentation{1};
+    for (const auto& [token, branch] : branches) {
+        output << "case " << unit_name << "Token::TokenType::" << token << ":\n";
+        output << sfmt::Indentation{1};
+        if (depth + 1 == config.lookahead) {
+            output << "return " << branch.front().second << ";\n";
+        } else {
+            complete_lookahead_id_decision(branch, depth + 1, unit_name, config, output);
+            output << "break;\n";
         }
-        output << "}, " << id << "},\n";
+        output << sfmt::Indentation{-1};
     }
-    output << sfmt::Indentation{-2};
+    output << "default:\n"
+              "    break;\n";
+    output << sfmt::Indentation{-1};
+    output << "}\n";
 }
 
-void complete_goto_states(const parser_generator::shift_reduce_parsers::ParserTable& parser_table, const std::string& unit_name, std::ostream& output) {
+void complete_goto_states(
+    const parser_generator::shift_reduce_parsers::ParserTable& parser_table, 
+    const std::string& unit_name, 
+    const input::PalexConfig& config, 
+    std::ostream& output
+) {
+    const size_t state_count = parser_table.get_states().size();
+    output << sfmt::Indentation{3};
+    if (!has_parser_shards(config)) {
+        complete_goto_state_cases(parser_table, unit_name, 0, state_count, output);
+    } else {
+        const size_t states_per_shard = get_parser_states_per_shard(state_count, config);
+        for (size_t shard = 0; shard < config.shard_count && shard * states_per_shard < state_count; shard++) {
+            output << "case " << shard * states_per_shard << " ... " << (shard + 1) * states_per_shard - 1 << ":\n"
+                      "    return this->get_goto_state_" << shard << "(reduced_production);\n";
+        }
+    }
+    output << sfmt::Indentation{-3};
+}
+
+void complete_goto_state_cases(
+    const parser_generator::shift_reduce_parsers::ParserTable& parser_table, 
+    const std::string& unit_name, 
+    const size_t first_state,
+    const size_t end_state,
+    std::ostream& output
+) {
     using namespace parser_generator::shift_reduce_parsers;
 
-    output << sfmt::Indentation{3};
-    for (size_t id = 0; id < parser_table.get_states().size(); id++) {
+    for (size_t id = first_state; id < std::min(end_state, parser_table.get_states().size()); id++) {
         output << "case " << id << ":\n";
         output << sfmt::Indentation{1};
         output << "switch (reduced_production) {\n";
@@ -179,97 +362,682 @@ void complete_goto_states(const parser_generator::shift_reduce_parsers::ParserTa
             );
         }
         output << "default:\n"
-                  "    return ERROR_STATE;\n";
+                  "    return " << unit_name << "_detail::ERROR_STATE;\n";
         output << sfmt::Indentation{-1};
         output << "}\n";
         output << sfmt::Indentation{-1};
     }
-    output << sfmt::Indentation{-3};
 }
 
 void complete_parser_table(const parser_generator::shift_reduce_parsers::ParserTable& parser_table, const std::string& unit_name, const input::PalexConfig& config, std::ostream& output) {
+    const size_t state_count = parser_table.get_states().size();
+    output << sfmt::Indentation{4};
+    if (!has_parser_shards(config)) {
+        complete_parser_states(parser_table, unit_name, config, 0, state_count, output);
+    } else {
+        const size_t states_per_shard = get_parser_states_per_shard(state_count, config);
+        for (size_t shard = 0; shard < config.shard_count && shard * states_per_shard < state_count; shard++) {
+            output << "case " << shard * states_per_shard << " ... " << (shard + 1) * states_per_shard - 1 << ":\n"
+                      "    if (this->parse_states_" << shard << "()) {\n"
+                      "        return;\n"
+                      "    }\n"
+                      "    break;\n";
+        }
+    }
+    output << sfmt::Indentation{-4};
+}
+
+void complete_parser_states(
+    const parser_generator::shift_reduce_parsers::ParserTable& parser_table, 
+    const std::string& unit_name, 
+    const input::PalexConfig& config, 
+    const size_t first_state,
+    const size_t end_state,
+    std::ostream& output
+) {
     using namespace parser_generator::shift_reduce_parsers;
    
-    output << sfmt::Indentation{4};
-    const std::map<parser_generator::shift_reduce_parsers::Lookahead_t, size_t> mappings = create_lookahead_mappings(parser_table);
-    for (size_t id = 0; id < parser_table.get_states().size(); id++) {
+    for (size_t id = first_state; id < std::min(end_state, parser_table.get_states().size()); id++) {
         output << "case " << id << ":\n";
         output << sfmt::Indentation{1};
-        output << "switch (";
-        complete_lookahead_switch(config, output);
-        output << ") {\n";
+        const std::optional<parser_generator::Production> default_reduction = parser_table.get_default_reduction(id);
+        if (default_reduction.has_value()) {
+            complete_reduction(default_reduction.value(), unit_name, config, output);
+            output << (default_reduction.value().is_entry() ? "" : "break;\n");
+            output << sfmt::Indentation{-1};
+            continue;
+        }
+        if (config.lookahead <= 1) {
+            output << "this->fetch_lookahead();\n";
+            complete_token_switch(parser_table, id, unit_name, config, output);
+        } else {
+            const size_t lookahead_depth = parser_table.get_lookahead_depth(id);
+            output << "this->fetch_lookahead(" << (lookahead_depth < config.lookahead ? std::to_string(lookahead_depth) : "") << ");\n";
+            std::vector<const Action*> candidates;
+            for (const Action& action : parser_table.get_states()[id].get_actions()) {
+                const Lookahead_t* lookahead = get_action_lookahead(action);
+                if (lookahead && !lookahead->empty()) {
+                    candidates.push_back(&action);
+                }
+            }
+            complete_lookahead_decision(parser_table, id, candidates, 0, unit_name, config, output);
+        }
+        output << "break;\n";
+        output << sfmt::Indentation{-1};
+    }
+}
+
+void complete_token_switch(
+    const parser_generator::shift_reduce_parsers::ParserTable& parser_table, 
+    const parser_generator::shift_reduce_parsers::ParserStateID_t state_id,
+    const std::string& unit_name, 
+    const input::PalexConfig& config, 
+    std::ostream& output
+) {
+    using namespace parser_generator::shift_reduce_parsers;
+
+    output << "switch (this->lexer.current_token().type) {\n";
+    output << sfmt::Indentation{1};
+    for (const Action& action : parser_table.get_states()[state_id].get_actions()) {
+        const Lookahead_t* lookahead = get_action_lookahead(action);
+        if (!lookahead) {
+            continue;
+        }
+        complete_lookahead_case(*lookahead, unit_name, output);
+        output << "\n";
+        output << sfmt::Indentation{1};
+        complete_action(action, parser_table, unit_name, config, output);
+        output << sfmt::Indentation{-1};
+    }
+    if (!has_default_action(parser_table.get_states()[state_id])) {
+        output << "default:\n";
         output << sfmt::Indentation{1};
-        bool already_has_default_action = false;
-        for (const Action& action : parser_table.get_states()[id].get_actions()) {
+        complete_lookahead_error(parser_table, state_id, unit_name, config, output);
+        output << "break;\n";
+        output << sfmt::Indentation{-1};
+    }
+    output << sfmt::Indentation{-1};
+    output << "}\n";
+}
+
+void complete_lookahead_decision( // only inspects as many lookahead tokens as are needed to choose the action
+    const parser_generator::shift_reduce_parsers::ParserTable& parser_table, 
+    const parser_generator::shift_reduce_parsers::ParserStateID_t state_id,
+    const std::vector<const parser_generator::shift_reduce_parsers::Action*>& candidates,
+    const size_t depth,
+    const std::string& unit_name, 
+    const input::PalexConfig& config, 
+    std::ostream& output
+) {
+    using namespace parser_generator::shift_reduce_parsers;
+
+    const Action* default_action = find_default_action(parser_table.get_states()[state_id]);
+    std::map<std::string, std::vector<const Action*>> branches;
+    for (const Action* candidate : candidates) {
+        branches[get_action_lookahead(*candidate)->at(depth).identifier].push_back(candidate);
+    }
+    output << "switch (this->peek_lookahead(" << depth << ").type) {\n";
+    output << sfmt::Indentation{1};
+    for (const auto& [token, branch] : branches) {
+        output << "case " << unit_name << "Token::TokenType::" << token << ":\n";
+        output << sfmt::Indentation{1};
+        const bool is_decided = depth + 1 == get_action_lookahead(*branch.front())->size() || (
+            std::all_of(
+                branch.begin(), 
+                branch.end(), 
+                [&](const Action* action) -> bool { return performs_same_operation(*action, *branch.front()); }
+            ) 
+            && (!default_action || performs_same_operation(*default_action, *branch.front()))
+        );
+        if (is_decided) {
+            complete_action(*branch.front(), parser_table, unit_name, config, output);
+        } else {
+            complete_lookahead_decision(parser_table, state_id, branch, depth + 1, unit_name, config, output);
+            output << "break;\n";
+        }
+        output << sfmt::Indentation{-1};
+    }
+    output << "default:\n";
+    output << sfmt::Indentation{1};
+    if (default_action) {
+        complete_action(*default_action, parser_table, unit_name, config, output);
+    } else {
+        complete_lookahead_error(parser_table, state_id, unit_name, config, output);
+        output << "break;\n";
+    }
+    output << sfmt::Indentation{-1};
+    output << sfmt::Indentation{-1};
+    output << "}\n";
+}
+
+void complete_action(
+    const parser_generator::shift_reduce_parsers::Action& action, 
+    const parser_generator::shift_reduce_parsers::ParserTable& parser_table, 
+    const std::string& unit_name, 
+    const input::PalexConfig& config, 
+    std::ostream& output
+) {
+    using namespace parser_generator::shift_reduce_parsers;
+
+    std::visit(
+        Visitor{
+            [](const Action::GotoParameters& goto_action) {},
+            [&](const Action::ReduceParameters& reduce_action) {
+                complete_reduction(reduce_action.to_reduce, unit_name, config, output);
+                output << (reduce_action.to_reduce.is_entry() ? "" : "break;\n");
+            },
+            [&](const Action::ShiftParameters& shift_action) {
+                output << "this->shift(" << shift_action.next_state << ");\n";
+                // fuses the shift with the reduction of the next state, if it doesn't depend on the lookahead
+                const std::optional<parser_generator::Production> next_reduction = parser_table.get_default_reduction(shift_action.next_state);
+                if (next_reduction.has_value()) {
+                    complete_reduction(next_reduction.value(), unit_name, config, output);
+                }
+                output << (next_reduction.has_value() && next_reduction.value().is_entry() ? "" : "break;\n");
+            }
+        },
+        action.parameters
+    );
+}
+
+void complete_lookahead_error(
+    const parser_generator::shift_reduce_parsers::ParserTable& parser_table, 
+    const parser_generator::shift_reduce_parsers::ParserStateID_t state_id,
+    const std::string& unit_name, 
+    const input::PalexConfig& config, 
+    std::ostream& output
+) {
+    if (uses_state_error_function(config)) {
+        output << "this->report_unexpected_lookahead();\n";
+        return;
+    }
+    output << "this->call_error_handler(" << create_state_error_message(parser_table.get_states()[state_id]) << ", " 
+           << expected_tokens_to_string(parser_table.get_states()[state_id], unit_name) << ");\n";
+}
+
+void complete_reduction(const parser_generator::Production& to_reduce, const std::string& unit_name, const input::PalexConfig& config, std::ostream& output) {
+    const size_t symbol_count = to_reduce.symbols.size(); 
+    if (!to_reduce.is_entry()) { // the AST builder comes first, so that it can access the reduced stack entries
+        if (!to_reduce.transparent) {
+            output << "this->ast_builder.reduce_" << to_reduce.get_representation() << "(" << symbol_count << ");\n";
+        }
+        output << "this->reduce_stack(" << unit_name << "NonterminalType::" << upper_case_str(to_reduce.name) << ", " << symbol_count << ");\n";
+    } else {
+        output << "this->pop_many(" << symbol_count << ");\n"
+               << (has_parser_shards(config) ? "return true;\n" : "return;\n");
+    }
+}
+
+void complete_parse_function(
+    const parser_generator::shift_reduce_parsers::ParserTable& parser_table, 
+    const std::vector<parser_generator::Production>& productions,
+    const std::string& unit_name, 
+    const input::PalexConfig& config, 
+    std::ostream& output
+) {
+    if (!config.table_driven_parser) {
+        output << sfmt::Indentation{2};
+        output << "while (true) {\n"
+                  "    switch(this->get_current_state()) {\n";
+        output << sfmt::Indentation{-2};
+        complete_parser_table(parser_table, unit_name, config, output);
+        output << sfmt::Indentation{2};
+        output << "\n"
+                  "        case " << unit_name << "_detail::ERROR_STATE:\n"
+                  "        default:\n"
+                  "            assert(false && \"Invalid parser state. This is (probably) a bug. Please create an issue on GitHub.\");\n"
+                  "            break;\n"
+                  "    }\n"
+                  "}";
+        output << sfmt::Indentation{-2};
+        return;
+    }
+    const std::string tables = unit_name + "ParserTables";
+    output << sfmt::Indentation{2};
+    output << "while (true) {\n";
+    output << sfmt::Indentation{1};
+    output << "const StateID_t state = this->get_current_state();\n"
+              "assert(state < " << tables << "::STATE_COUNT && \"Invalid parser state. This is (probably) a bug. Please create an issue on GitHub.\");\n"
+              << tables << "::Action_t action = " << tables << "::DEFAULT_ACTIONS[state];\n"
+              "if (" << tables << "::READS_LOOKAHEAD[state]) {\n"
+              "    this->fetch_lookahead();\n"
+              "    action = " << tables << "::get_action(state, ";
+    if (config.lookahead <= 1) {
+        output << tables << "::get_terminal_column(this->lexer.current_token().type)";
+    } else {
+        output << "this->get_lookahead_id()";
+    }
+    output << ");\n"
+              "}\n"
+              "if (action == " << tables << "::ERROR_ACTION) {\n"
+              "    this->report_unexpected_lookahead();\n"
+              "} else if (action < " << tables << "::FIRST_REDUCE_ACTION) {\n"
+              "    this->shift(action - " << tables << "::FIRST_SHIFT_ACTION);\n"
+              "} else if (action < " << tables << "::FIRST_ACCEPT_ACTION) {\n";
+    output << sfmt::Indentation{1};
+    output << "const size_t production = action - " << tables << "::FIRST_REDUCE_ACTION;\n";
+    complete_table_reductions(collect_reduced_productions(parser_table), output);
+    output << "this->reduce_stack(" << tables << "::REDUCE_NONTERMINALS[production], " << tables << "::REDUCE_LENGTHS[production]);\n";
+    output << sfmt::Indentation{-1};
+    output << "} else {\n"
+              "    this->pop_many(" << tables << "::REDUCE_LENGTHS[action - " << tables << "::FIRST_REDUCE_ACTION]);\n"
+              "    return;\n"
+              "}\n";
+    output << sfmt::Indentation{-1};
+    output << "}";
+    output << sfmt::Indentation{-2};
+}
+
+void complete_goto_function(const parser_generator::shift_reduce_parsers::ParserTable& parser_table, const std::string& unit_name, const input::PalexConfig& config, std::ostream& output) {
+    output << sfmt::Indentation{2};
+    if (config.table_driven_parser) {
+        output << "return " << unit_name << "ParserTables::get_goto_state(this->get_current_state(), (size_t)reduced_production);";
+        output << sfmt::Indentation{-2};
+        return;
+    }
+    output << "switch (this->get_current_state()) {\n";
+    output << sfmt::Indentation{-2};
+    complete_goto_states(parser_table, unit_name, config, output);
+    output << sfmt::Indentation{2};
+    output << "    default:\n"
+              "        return " << unit_name << "_detail::ERROR_STATE;\n"
+              "}\n"
+              "return " << unit_name << "_detail::ERROR_STATE;";
+    output << sfmt::Indentation{-2};
+}
+
+void complete_parser_tables(
+    const parser_generator::shift_reduce_parsers::ParserTable& parser_table, 
+    const std::vector<parser_generator::Production>& productions,
+    const std::string& unit_name, 
+    const input::PalexConfig& config, 
+    std::ostream& output
+) {
+    using namespace parser_generator::shift_reduce_parsers;
+
+    if (!config.table_driven_parser) {
+        return;
+    }
+    const std::vector<ParserState>& states = parser_table.get_states();
+    const std::map<Lookahead_t, size_t> columns = create_lookahead_columns(parser_table, config);
+    const std::vector<parser_generator::Production> reduced_productions = collect_reduced_productions(parser_table);
+    std::map<parser_generator::Production, size_t> production_ids;
+    size_t entry_production_begin = reduced_productions.size();
+    for (size_t id = 0; id < reduced_productions.size(); id++) {
+        production_ids[reduced_productions[id]] = id;
+        if (reduced_productions[id].is_entry()) {
+            entry_production_begin = std::min(entry_production_begin, id);
+        }
+    }
+    std::map<std::string, size_t> nonterminal_ids;
+    for (const std::string& nonterminal : collect_nonterminal_names(productions)) {
+        nonterminal_ids.insert({nonterminal, nonterminal_ids.size()}); // same order as the nonterminal enum
+    }
+
+    // action encoding: 0 = error, then one value per shift target state, followed by one per reduced production
+    const size_t first_reduce_action = 1 + states.size();
+    std::vector<size_t> default_actions(states.size(), 0);
+    std::vector<TableRow_t> action_rows(states.size());
+    std::vector<TableRow_t> goto_rows(states.size());
+    for (size_t state = 0; state < states.size(); state++) {
+        for (const Action& action : states[state].get_actions()) {
             std::visit(
                 Visitor{
-                    [](const Action::GotoParameters& goto_action) {},
+                    [&](const Action::GotoParameters& goto_action) {
+                        goto_rows[state][nonterminal_ids.at(goto_action.reduced_symbol.identifier)] = goto_action.next_state;
+                    },
                     [&](const Action::ReduceParameters& reduce_action) {
+                        const size_t encoded = first_reduce_action + production_ids.at(reduce_action.to_reduce);
                         if (reduce_action.lookahead.empty()) {
-                            already_has_default_action = true;
-                        }
-                        complete_lookahead_case(reduce_action.lookahead, unit_name, mappings, output);
-                        output << "\n";
-                        output << sfmt::Indentation{1};
-                        if (!reduce_action.to_reduce.is_entry()) {
-                            const size_t symbol_count = reduce_action.to_reduce.symbols.size(); 
-                            output << "this->reduce_stack(" << unit_name << "NonterminalType::" << upper_case_str(reduce_action.to_reduce.name)
-                                   << ", " << symbol_count << ");\n"
-                                   << "this->ast_builder.reduce_" << reduce_action.to_reduce.get_representation() << "(" << symbol_count << ");\n"
-                                   << "break;\n";
+                            default_actions[state] = encoded;
                         } else {
-                            output << "this->pop_many(" << reduce_action.to_reduce.symbols.size() << ");\n"
-                                   << "return;\n";
+                            action_rows[state][columns.at(reduce_action.lookahead)] = encoded;
                         }
-                        output << sfmt::Indentation{-1};
                     },
                     [&](const Action::ShiftParameters& shift_action) {
+                        const size_t encoded = 1 + shift_action.next_state;
                         if (shift_action.lookahead.empty()) {
-                            already_has_default_action = true;
+                            default_actions[state] = encoded;
+                        } else {
+                            action_rows[state][columns.at(shift_action.lookahead)] = encoded;
                         }
-                        complete_lookahead_case(shift_action.lookahead, unit_name, mappings, output);
-                        output << "\n    this->shift(" << shift_action.next_state << ");\n"
-                                  "    break;\n"; 
                     }
                 },
                 action.parameters
             );
         }
-        if (!already_has_default_action) {
-            output << "default:\n"
-                      "    this->call_error_handler(" << create_state_error_message(parser_table.get_states()[id]) << ", " 
-                   << expected_tokens_to_string(parser_table.get_states()[id], unit_name) << ");\n";
-            output << "    break;\n";
+    }
+    std::vector<std::string> reads_lookahead(states.size(), "true");
+    for (size_t state = 0; state < states.size(); state++) {
+        const std::optional<parser_generator::Production> default_reduction = parser_table.get_default_reduction(state);
+        if (default_reduction.has_value()) {
+            default_actions[state] = first_reduce_action + production_ids.at(default_reduction.value());
+            action_rows[state].clear();
+            reads_lookahead[state] = "false";
         }
-        output << sfmt::Indentation{-1};
-        output << "}\n"
-                  "break;\n";
+    }
+    const CompressedTable compressed_actions = compress_table(action_rows, columns.size());
+    const CompressedTable compressed_gotos = compress_table(goto_rows, nonterminal_ids.size());
+    const std::string check_type = get_smallest_uint_type(states.size());
 
-        output << sfmt::Indentation{-1};
+    std::vector<size_t> reduce_lengths;
+    std::vector<std::string> reduce_nonterminals;
+    for (const parser_generator::Production& production : reduced_productions) {
+        reduce_lengths.push_back(production.symbols.size());
+        if (!production.is_entry()) {
+            reduce_nonterminals.push_back(unit_name + "NonterminalType::" + upper_case_str(production.name));
+        }
     }
-    output << sfmt::Indentation{-4};
+    
+    output << "\n";
+    output << sfmt::Indentation{1};
+    output << "struct " << unit_name << "ParserTables {\n";
+    output << sfmt::Indentation{1};
+    output << "using Action_t = " << get_smallest_uint_type(first_reduce_action + reduced_productions.size()) << ";\n\n"
+              "static constexpr size_t STATE_COUNT = " << states.size() << ";\n"
+              "static constexpr size_t COLUMN_COUNT = " << columns.size() << ";\n"
+              "static constexpr Action_t ERROR_ACTION = 0;\n"
+              "static constexpr Action_t FIRST_SHIFT_ACTION = 1;\n"
+              "static constexpr Action_t FIRST_REDUCE_ACTION = " << first_reduce_action << ";\n"
+              "static constexpr Action_t FIRST_ACCEPT_ACTION = " << first_reduce_action + entry_production_begin << ";\n\n";
+    complete_table_array("DEFAULT_ACTIONS", "Action_t", to_string_vector(default_actions), output);
+    complete_table_array("READS_LOOKAHEAD", "bool", reads_lookahead, output);
+    complete_table_array("ACTION_OFFSETS", get_smallest_uint_type(compressed_actions.values.size()), to_string_vector(compressed_actions.row_offsets), output);
+    complete_table_array("ACTION_VALUES", "Action_t", to_string_vector(compressed_actions.values), output);
+    complete_table_array("ACTION_CHECKS", check_type, to_string_vector(compressed_actions.checks), output);
+    complete_table_array("GOTO_OFFSETS", get_smallest_uint_type(compressed_gotos.values.size()), to_string_vector(compressed_gotos.row_offsets), output);
+    complete_table_array("GOTO_VALUES", get_smallest_uint_type(states.size()), to_string_vector(compressed_gotos.values), output);
+    complete_table_array("GOTO_CHECKS", check_type, to_string_vector(compressed_gotos.checks), output);
+    complete_table_array(
+        "REDUCE_LENGTHS", 
+        get_smallest_uint_type(
+            reduce_lengths.empty() ? 0 : *std::max_element(reduce_lengths.begin(), reduce_lengths.end())
+        ), 
+        to_string_vector(reduce_lengths), 
+        output
+    );
+    complete_table_array("REDUCE_NONTERMINALS", unit_name + "NonterminalType", reduce_nonterminals, output);
+    output << "\n";
+    if (config.lookahead <= 1) {
+        complete_terminal_column_function(columns, unit_name, output);
+    }
+    output << "static constexpr Action_t get_action(const size_t state, const size_t column) {\n"
+              "    if (column < COLUMN_COUNT && ACTION_CHECKS[ACTION_OFFSETS[state] + column] == state) {\n"
+              "        return ACTION_VALUES[ACTION_OFFSETS[state] + column];\n"
+              "    }\n"
+              "    return DEFAULT_ACTIONS[state];\n"
+              "}\n\n"
+              "static constexpr size_t get_goto_state(const size_t state, const size_t nonterminal) {\n"
+              "    if (GOTO_CHECKS[GOTO_OFFSETS[state] + nonterminal] == state) {\n"
+              "        return GOTO_VALUES[GOTO_OFFSETS[state] + nonterminal];\n"
+              "    }\n"
+              "    return " << unit_name << "_detail::ERROR_STATE;\n"
+              "}\n";
+    output << sfmt::Indentation{-1};
+    output << "};\n";
+    output << sfmt::Indentation{-1};
 }
 
-void complete_lookahead_switch(const input::PalexConfig& config, std::ostream& output) {
-    if (config.lookahead <= 1) {
-        output << "this->lookahead.type";
-    } else {
-        output << "this->get_lookahead_id()";
+void complete_table_array(const std::string& name, const std::string& type, const std::vector<std::string>& values, std::ostream& output) {
+    constexpr size_t MAX_LINE_LENGTH = 100;
+
+    output << "static constexpr std::array<" << type << ", " << values.size() << "> " << name << " = {";
+    output << sfmt::Indentation{1};
+    size_t line_length = MAX_LINE_LENGTH;
+    for (size_t i = 0; i < values.size(); i++) {
+        if (line_length + values[i].size() + 2 > MAX_LINE_LENGTH) {
+            output << "\n";
+            line_length = 0;
+        } else {
+            output << " ";
+        }
+        output << values[i];
+        line_length += values[i].size() + 2;
+        if (i + 1 != values.size()) {
+            output << ",";
+        }
     }
+    output << sfmt::Indentation{-1};
+    output << (values.empty() ? "};\n" : "\n};\n");
 }
 
-void complete_lookahead_case(
-    const parser_generator::shift_reduce_parsers::Lookahead_t& lookahead, 
-    const std::string& unit_name,
-    const std::map<parser_generator::shift_reduce_parsers::Lookahead_t, size_t>& mappings,
+void complete_terminal_column_function(const std::map<parser_generator::shift_reduce_parsers::Lookahead_t, size_t>& columns, const std::string& unit_name, std::ostream& output) {
+    output << "static constexpr size_t get_terminal_column(const " << unit_name << "Token::TokenType type) {\n";
+    output << sfmt::Indentation{1};
+    output << "switch (type) {\n";
+    output << sfmt::Indentation{1};
+    for (const auto& [lookahead, column] : columns) {
+        output << "case " << unit_name << "Token::TokenType::" << lookahead.front().identifier << ":\n"
+                  "    return " << column << ";\n";
+    }
+    output << "default:\n"
+              "    return COLUMN_COUNT;\n";
+    output << sfmt::Indentation{-1};
+    output << "}\n";
+    output << sfmt::Indentation{-1};
+    output << "}\n\n";
+}
+
+void complete_table_reductions(const std::vector<parser_generator::Production>& reduced_productions, std::ostream& output) {
+    output << "switch (production) {\n";
+    output << sfmt::Indentation{1};
+    for (size_t id = 0; id < reduced_productions.size() && !reduced_productions[id].is_entry(); id++) {
+        if (reduced_productions[id].transparent) { // transparent productions have no reduce method
+            continue;
+        }
+        output << "case " << id << ":\n"
+                  "    this->ast_builder.reduce_" << reduced_productions[id].get_representation() << "(" << reduced_productions[id].symbols.size() << ");\n"
+                  "    break;\n";
+    }
+    output << "default:\n"
+              "    break;\n";
+    output << sfmt::Indentation{-1};
+    output << "}\n";
+}
+
+std::map<parser_generator::shift_reduce_parsers::Lookahead_t, size_t> create_lookahead_columns(
+    const parser_generator::shift_reduce_parsers::ParserTable& parser_table, 
+    const input::PalexConfig& config
+) {
+    if (config.lookahead > 1) {
+        return create_lookahead_mappings(parser_table); // has to match the ids of get_lookahead_id
+    }
+    std::map<parser_generator::shift_reduce_parsers::Lookahead_t, size_t> columns;
+    for (const parser_generator::shift_reduce_parsers::Lookahead_t& lookahead : collect_all_lookaheads(parser_table)) {
+        if (!lookahead.empty()) {
+            columns.insert({lookahead, columns.size()});
+        }
+    }
+    return columns;
+}
+
+std::vector<parser_generator::Production> collect_reduced_productions(const parser_generator::shift_reduce_parsers::ParserTable& parser_table) {
+    using namespace parser_generator::shift_reduce_parsers;
+
+    std::set<parser_generator::Production> reduced_productions;
+    for (const ParserState& state : parser_table.get_states()) {
+        for (const Action& action : state.get_actions()) {
+            if (std::holds_alternative<Action::ReduceParameters>(action.parameters)) {
+                reduced_productions.insert(std::get<Action::ReduceParameters>(action.parameters).to_reduce);
+            }
+        }
+    }
+    std::vector<parser_generator::Production> ordered_productions; // entry productions come last, as they accept instead of reducing
+    std::copy_if(
+        reduced_productions.begin(), 
+        reduced_productions.end(), 
+        std::back_inserter(ordered_productions), 
+        [](const parser_generator::Production& production) -> bool { return !production.is_entry(); }
+    );
+    std::copy_if(
+        reduced_productions.begin(), 
+        reduced_productions.end(), 
+        std::back_inserter(ordered_productions), 
+        [](const parser_generator::Production& production) -> bool { return production.is_entry(); }
+    );
+    return ordered_productions;
+}
+
+std::string get_smallest_uint_type(const size_t max_value) {
+    if (max_value <= UINT8_MAX) {
+        return "uint8_t";
+    } else if (max_value <= UINT16_MAX) {
+        return "uint16_t";
+    } else if (max_value <= UINT32_MAX) {
+        return "uint32_t";
+    }
+    return "uint64_t";
+}
+
+std::vector<std::string> to_string_vector(const std::vector<size_t>& to_convert) {
+    std::vector<std::string> converted;
+    std::transform(
+        to_convert.begin(), 
+        to_convert.end(), 
+        std::back_inserter(converted), 
+        [](const size_t value) -> std::string { return std::to_string(value); }
+    );
+    return converted;
+}
+
+void complete_parser_shard_declarations(const std::string& unit_name, const input::PalexConfig& config, std::ostream& output) {
+    if (!uses_state_error_function(config)) {
+        return;
+    }
+    output << sfmt::Indentation{3};
+    if (config.lookahead > 1) {
+        output << "\n";
+    }
+    for (size_t shard = 0; has_parser_shards(config) && shard < config.shard_count; shard++) {
+        output << "bool parse_states_" << shard << "();\n"
+               << "StateID_t get_goto_state_" << shard << "(const " << unit_name << "NonterminalType reduced_production) const;\n";
+    }
+    output << "void report_unexpected_lookahead();";
+    output << sfmt::Indentation{-3};
+}
+
+void complete_state_error_function( // error messages are kept out of the state shards, as they are only needed on the cold path
+    const parser_generator::shift_reduce_parsers::ParserTable& parser_table, 
+    const std::string& unit_name, 
+    const input::PalexConfig& config, 
     std::ostream& output
 ) {
+    if (!uses_state_error_function(config)) {
+        return;
+    }
+    output << sfmt::Indentation{1};
+    if (config.lookahead > 1) {
+        output << "\n\n";
+    }
+    output << "template<class Lexer_t, class ASTBuilder_t>\n"
+              "void " << unit_name << "BasicParser<Lexer_t, ASTBuilder_t>::report_unexpected_lookahead() {\n";
+    output << sfmt::Indentation{1};
+    output << "switch (this->get_current_state()) {\n";
+    output << sfmt::Indentation{1};
+    for (size_t id = 0; id < parser_table.get_states().size(); id++) {
+        if (has_default_action(parser_table.get_states()[id])) {
+            continue;
+        }
+        output << "case " << id << ":\n"
+                  "    this->call_error_handler(" << create_state_error_message(parser_table.get_states()[id]) << ", " 
+               << expected_tokens_to_string(parser_table.get_states()[id], unit_name) << ");\n"
+                  "    break;\n";
+    }
+    output << "default:\n"
+              "    break;\n";
+    output << sfmt::Indentation{-1};
+    output << "}\n";
+    output << sfmt::Indentation{-1};
+    output << "}";
+    output << sfmt::Indentation{-1};
+}
+
+size_t get_parser_states_per_shard(const size_t state_count, const input::PalexConfig& config) {
+    return std::max((state_count + config.shard_count - 1) / config.shard_count, (size_t)1);
+}
+
+bool has_parser_shards(const input::PalexConfig& config) {
+    return config.shard_count > 1 && !config.table_driven_parser; // the tables are plain data, so there is nothing to split
+}
+
+bool uses_state_error_function(const input::PalexConfig& config) { // the lookahead decisions of LR(k > 1) parsers report errors in several places
+    return has_parser_shards(config) || config.table_driven_parser || config.lookahead > 1;
+}
+
+std::vector<std::string> get_parser_instantiations(const std::string& unit_name, const input::PalexConfig& config) {
+    if (config.amalgamate) {
+        return {}; // the amalgamated parser is header-only and gets instantiated implicitly
+    }
+    std::vector<std::string> instantiations{unit_name + "BasicParser<" + unit_name + "TokenCallbacks, " + unit_name + "ASTBuilderBase>"};
+    if (config.generate_lexer) {
+        instantiations.push_back(unit_name + "BasicParser<" + unit_name + "Lexer, " + unit_name + "ASTBuilderBase>");
+    }
+    return instantiations;
+}
+
+void complete_parser_instantiations(const std::string& unit_name, const input::PalexConfig& config, std::ostream& output) {
+    const std::vector<std::string> instantiations = get_parser_instantiations(unit_name, config);
+    if (!instantiations.empty()) {
+        output << "\n";
+    }
+    for (const std::string& instantiation : instantiations) {
+        output << "\n    template class " << instantiation << ";";
+    }
+}
+
+void complete_parser_shard_instantiations(const std::string& unit_name, const size_t shard, const input::PalexConfig& config, std::ostream& output) {
+    for (const std::string& instantiation : get_parser_instantiations(unit_name, config)) {
+        output << "\n\n    template bool " << instantiation << "::parse_states_" << shard << "();\n"
+                  "    template " << instantiation << "::StateID_t " << instantiation << "::get_goto_state_" << shard 
+               << "(const " << unit_name << "NonterminalType reduced_production) const;";
+    }
+}
+
+bool has_default_action(const parser_generator::shift_reduce_parsers::ParserState& state) {
+    return find_default_action(state) != nullptr;
+}
+
+const parser_generator::shift_reduce_parsers::Action* find_default_action(const parser_generator::shift_reduce_parsers::ParserState& state) {
+    for (const parser_generator::shift_reduce_parsers::Action& action : state.get_actions()) {
+        const parser_generator::shift_reduce_parsers::Lookahead_t* lookahead = get_action_lookahead(action);
+        if (lookahead && lookahead->empty()) {
+            return &action;
+        }
+    }
+    return nullptr;
+}
+
+const parser_generator::shift_reduce_parsers::Lookahead_t* get_action_lookahead(const parser_generator::shift_reduce_parsers::Action& action) {
+    using namespace parser_generator::shift_reduce_parsers;
+
+    return std::visit(
+        Visitor{
+            [](const Action::GotoParameters& goto_action) -> const Lookahead_t* { return nullptr; },
+            [](const Action::ReduceParameters& reduce_action) -> const Lookahead_t* { return &reduce_action.lookahead; },
+            [](const Action::ShiftParameters& shift_action) -> const Lookahead_t* { return &shift_action.lookahead; }
+        },
+        action.parameters
+    );
+}
+
+bool performs_same_operation(const parser_generator::shift_reduce_parsers::Action& first, const parser_generator::shift_reduce_parsers::Action& second) {
+    using namespace parser_generator::shift_reduce_parsers;
+
+    if (std::holds_alternative<Action::ShiftParameters>(first.parameters) && std::holds_alternative<Action::ShiftParameters>(second.parameters)) {
+        return std::get<Action::ShiftParameters>(first.parameters).next_state == std::get<Action::ShiftParameters>(second.parameters).next_state;
+    }
+    if (std::holds_alternative<Action::ReduceParameters>(first.parameters) && std::holds_alternative<Action::ReduceParameters>(second.parameters)) {
+        return std::get<Action::ReduceParameters>(first.parameters).to_reduce == std::get<Action::ReduceParameters>(second.parameters).to_reduce;
+    }
+    return false;
+}
+
+
+void complete_lookahead_case(const parser_generator::shift_reduce_parsers::Lookahead_t& lookahead, const std::string& unit_name, std::ostream& output) {
     if (lookahead.empty()) {
         output << "default:";
-    } else if (lookahead.size() == 1) {
-        output << "case "<< unit_name << "Token::TokenType::" << lookahead[0].identifier << ":";
     } else {
-        output << "case " << mappings.at(lookahead) << ":"; 
+        output << "case "<< unit_name << "Token::TokenType::" << lookahead[0].identifier << ":";
     }
 }
 
@@ -319,7 +1087,7 @@ std::set<std::string> collect_nonterminal_names(const std::vector<parser_generat
 std::set<std::string> collect_production_representations(const std::vector<parser_generator::Production>& productions) {
     std::set<std::string> production_representations;
     for (const parser_generator::Production& production : productions) {
-        if (!production.is_entry()) {
+        if (!production.is_entry() && !production.transparent) {
             production_representations.insert(production.get_representation());
         }
     }
@@ -364,7 +1132,7 @@ std::string create_state_error_message(const parser_generator::shift_reduce_pars
     using namespace parser_generator::shift_reduce_parsers;
 
     std::stringstream error_message_stream{};
-    error_message_stream << "\"Received '\" + lookahead_to_string(this->lookahead) + \"', but expected one of the following: ";
+    error_message_stream << "\"but expected one of the following: ";
     bool first_lookahead = true;
     for (const Action& action : state.get_actions()) {
         std::visit(
@@ -442,11 +1210,19 @@ void complete_reduce_methods(const std::vector<parser_generator::Production>& pr
     output << sfmt::Indentation{-3};
 }
 
+void complete_static_reduce_methods(const std::vector<parser_generator::Production>& productions, std::ostream& output) {
+    output << sfmt::Indentation{3};
+    for (const std::string& production_representation : collect_production_representations(productions)) {
+        output << "void reduce_" << production_representation << "(const size_t) {}\n";
+    }
+    output << sfmt::Indentation{-3};
+}
+
 void complete_lookahead_to_string(const input::PalexConfig& config, std::ostream& output) {
-    output << sfmt::Indentation{1};
+    output << sfmt::Indentation{2};
     if (config.lookahead <= 1) {
         output << "string_repr << lookahead.type;";
-        output << sfmt::Indentation{-1};
+        output << sfmt::Indentation{-2};
         return;
     }
     output << "for (auto iter = lookahead.begin(); iter != lookahead.end(); iter++) {\n";
@@ -457,7 +1233,108 @@ void complete_lookahead_to_string(const input::PalexConfig& config, std::ostream
               "string_repr << iter->type;\n";
     output << sfmt::Indentation{-1};
     output << "}";
-    output << sfmt::Indentation{-1};
+    output << sfmt::Indentation{-2};
+}
+
+std::map<std::string_view, templates::TemplateCompleter_t> create_parser_header_completers(
+    const std::string& unit_name,
+    const std::vector<parser_generator::Production>& productions,
+    const parser_generator::shift_reduce_parsers::ParserTable& parser_table,
+    const input::PalexConfig& config
+) {
+    using namespace std::placeholders;
+
+    return { 
+        {"LOOKAHEAD_INCLUDES", templates::conditional_completer(config.lookahead > 1, "#include <deque>")},
+        {"UNIT_NAME", templates::constant_completer(unit_name)},
+        {"MODULE_NAMESPACE", templates::constant_completer(config.module_name)},
+        {"LOOKAHEAD_COUNT", templates::constant_completer(std::to_string(config.lookahead))},
+        {"STACK_CAPACITY", templates::constant_completer(std::to_string(config.stack_capacity))},
+        {"STACK_GROWTH_FACTOR", templates::constant_completer(std::to_string(config.stack_growth_factor))},
+        {
+            "STACK_STATE_TYPE", // the largest value stays unused, so that truncated error states remain invalid
+            templates::choice_completer(parser_table.get_states().size() < UINT16_MAX, "uint16_t", "uint32_t")
+        },
+        {"NONTERMINAL_TYPES", std::bind(complete_nonterminal_enum, productions, _1)},
+        {
+            "LOOKAHEAD_TYPE",
+            templates::choice_completer(config.lookahead > 1, "std::deque<" + unit_name + "Token>", unit_name + "Token")
+        },
+        {
+            "LOOKAHEAD_MEMBER", 
+            templates::choice_completer(
+                config.lookahead > 1, 
+                "\n            std::array<" + unit_name + "Token, LOOKAHEAD> lookahead_buffer; // ring buffer, the next token is at lookahead_begin"
+                "\n            size_t lookahead_begin = 0;"
+                "\n            size_t lookahead_count = 0;", 
+                "\n            bool lookahead_consumed = true;"
+            )
+        },
+        {"LOOKAHEAD_FUNCTION", std::bind(complete_lookahead_function_declaration, unit_name, config, _1)},
+        {"FETCH_LOOKAHEAD_PARAMETER", templates::conditional_completer(config.lookahead > 1, "const size_t token_count = LOOKAHEAD")},
+        {"STATE_SHARD_FUNCTIONS", std::bind(complete_parser_shard_declarations, unit_name, config, _1)}
+    };
+}
+
+std::map<std::string_view, templates::TemplateCompleter_t> create_parser_source_completers(
+    const std::string& unit_name,
+    const std::vector<parser_generator::Production>& productions,
+    const parser_generator::shift_reduce_parsers::ParserTable& parser_table,
+    const input::PalexConfig& config
+) {
+    using namespace std::placeholders;
+
+    return {
+        {"INLINE", templates::conditional_completer(config.amalgamate, "inline ")},
+        {"ERROR_STATE_CONSTANT", templates::conditional_completer(!config.amalgamate, "constexpr size_t ERROR_STATE = (size_t)-1;")},
+        {"UNIT_NAME", templates::constant_completer(unit_name)},
+        {"MODULE_NAMESPACE", templates::constant_completer(config.module_name)},
+        {"PARSER_TABLES", std::bind(complete_parser_tables, parser_table, productions, unit_name, config, _1)},
+        {"PARSE_FUNCTION", std::bind(complete_parse_function, parser_table, productions, unit_name, config, _1)},
+        {"FETCH_LOOKAHEAD", std::bind(complete_fetch_lookahead, config, _1)},
+        {"FETCH_LOOKAHEAD_PARAMETER", templates::conditional_completer(config.lookahead > 1, "const size_t token_count")},
+        {"SHIFT_FUNCTION", std::bind(complete_shift_function, unit_name, config, _1)},
+        {"GOTO_FUNCTION", std::bind(complete_goto_function, parser_table, unit_name, config, _1)},
+        {"CALL_ERROR_HANDLER", std::bind(complete_call_error_handler, unit_name, config, _1)},
+        {"LEXER_INCLUDE", templates::conditional_completer(config.generate_lexer && !config.amalgamate, "\n#include \"" + unit_name + "Lexer.h\"")},
+        {"PARSER_INSTANTIATIONS", std::bind(complete_parser_instantiations, unit_name, config, _1)},
+        {"LOOKAHEAD_FUNCTION", std::bind(complete_lookahead_function, parser_table, unit_name, config, _1)},
+        {"STATE_ERROR_FUNCTION", std::bind(complete_state_error_function, parser_table, unit_name, config, _1)},
+        {
+            "LOOKAHEAD_TYPE",
+            templates::choice_completer(config.lookahead > 1, "std::deque<" + unit_name + "Token>", unit_name + "Token")
+        },
+        {"ERROR_REPORT_BEGIN", templates::choice_completer(config.lookahead > 1, "lookahead.front().begin", "lookahead.begin")},
+        {"ERROR_REPORT_END", templates::choice_completer(config.lookahead > 1, "lookahead.front().end", "lookahead.end")},
+        {
+            "LOOKAHEAD_TO_STRING_FUNCTION", 
+            std::bind(complete_lookahead_to_string, config, _1)
+        },
+        {
+            "LOOKAHEAD_TYPE_OUTSIDE_NAMESPACE", 
+            templates::choice_completer(
+                config.lookahead > 1, 
+                "std::deque<" + config.module_name + "::" +  unit_name + "Token>", 
+                config.module_name + "::" + unit_name + "Token"
+            )
+        },
+        {"LOOKAHEAD_INCLUDES", templates::conditional_completer(config.lookahead > 1, "#include <deque>")}
+    };
+}
+
+std::map<std::string_view, templates::TemplateCompleter_t> create_ast_builder_header_completers(
+    const std::string& unit_name,
+    const std::vector<parser_generator::Production>& productions,
+    const input::PalexConfig& config
+) {
+    using namespace std::placeholders;
+
+    return {
+        {"UNIT_NAME", templates::constant_completer(unit_name)},
+        {"MODULE_NAMESPACE", templates::constant_completer(config.module_name)},
+        {"REDUCE_METHODS", std::bind(complete_reduce_methods, productions, _1)},
+        {"STATIC_REDUCE_METHODS", std::bind(complete_static_reduce_methods, productions, _1)}
+    };
 }
 
 namespace parser_generator::shift_reduce_parsers::code_gen::cpp {
@@ -468,7 +1345,11 @@ namespace parser_generator::shift_reduce_parsers::code_gen::cpp {
         const input::PalexConfig& config
     ) {
         try {
-            generate_parser_header(unit_name, productions, config);
+            if (config.amalgamate) {
+                generate_amalgamated_parser(unit_name, productions, parser_table, config);
+                return true;
+            }
+            generate_parser_header(unit_name, productions, parser_table, config);
             generate_parser_source(unit_name, productions, parser_table, config);
             generate_ast_builder_header(unit_name, productions, config);
         } catch (const std::exception& err) {
@@ -481,25 +1362,12 @@ namespace parser_generator::shift_reduce_parsers::code_gen::cpp {
     void generate_parser_header(
         const std::string& unit_name,
         const std::vector<Production>& productions,
+        const ParserTable& parser_table,
         const input::PalexConfig& config
     ) {
-        using namespace std::placeholders;
-
-        const std::map<std::string_view, templates::TemplateCompleter_t> completers = { 
-            {"LOOKAHEAD_INCLUDES", templates::conditional_completer(config.lookahead > 1, "#include <deque>")},
-            {"UNIT_NAME", templates::constant_completer(unit_name)},
-            {"MODULE_NAMESPACE", templates::constant_completer(config.module_name)},
-            {"LOOKAHEAD_COUNT", templates::constant_completer(std::to_string(config.lookahead))},
-            {"NONTERMINAL_TYPES", std::bind(complete_nonterminal_enum, productions, _1)},
-            {
-                "LOOKAHEAD_TYPE",
-                templates::choice_completer(config.lookahead > 1, "std::deque<" + unit_name + "Token>", unit_name + "Token")
-            },
-            {"LOOKAHEAD_FUNCTION", std::bind(complete_lookahead_function_declaration, config, _1)}
-        };
         const std::string parser_header_path = config.output_path + "/" + unit_name + "Parser.h";
         std::cout << "Generating file " << parser_header_path << "..." << std::endl;
-        templates::write_template_to_file(cpp_parser_header, parser_header_path, completers);
+        templates::write_template_to_file(cpp_parser_header, parser_header_path, create_parser_header_completers(unit_name, productions, parser_table, config));
     }
 
     void generate_parser_source(
@@ -508,56 +1376,84 @@ namespace parser_generator::shift_reduce_parsers::code_gen::cpp {
         const ParserTable& parser_table,
         const input::PalexConfig& config
     ) {
-        using namespace std::placeholders;
-
-        const std::map<std::string_view, templates::TemplateCompleter_t> completers = {
-            {"UNIT_NAME", templates::constant_completer(unit_name)},
-            {"MODULE_NAMESPACE", templates::constant_completer(config.module_name)},
-            {"PARSER_TABLE", std::bind(complete_parser_table, parser_table, unit_name, config, _1)},
-            {"INIT_LOOKAHEAD", std::bind(complete_init_lookahead, config, _1)},
-            {"SHIFT_FUNCTION", std::bind(complete_shift_function, config, _1)},
-            {"GOTO_STATES", std::bind(complete_goto_states, parser_table, unit_name, _1)},
-            {"REFILL_QUEUE", templates::conditional_completer(config.lookahead > 1, "this->init_lookahead();")},
-            {"LOOKAHEAD_FUNCTION", std::bind(complete_lookahead_function, parser_table, unit_name, config, _1)},
-            {
-                "LOOKAHEAD_TYPE",
-                templates::choice_completer(config.lookahead > 1, "std::deque<" + unit_name + "Token>", unit_name + "Token")
-            },
-            {"ERROR_REPORT_BEGIN", templates::choice_completer(config.lookahead > 1, "lookahead.front().begin", "lookahead.begin")},
-            {"ERROR_REPORT_END", templates::choice_completer(config.lookahead > 1, "lookahead.front().end", "lookahead.end")},
-            {
-                "LOOKAHEAD_TO_STRING_FUNCTION", 
-                std::bind(complete_lookahead_to_string, config, _1)
-            },
-            {
-                "LOOKAHEAD_TYPE_OUTSIDE_NAMESPACE", 
-                templates::choice_completer(
-                    config.lookahead > 1, 
-                    "std::deque<" + config.module_name + "::" +  unit_name + "Token>", 
-                    config.module_name + "::" + unit_name + "Token"
-                )
-            },
-            {"LOOKAHEAD_INCLUDES", templates::conditional_completer(config.lookahead > 1, "#include <map>")}
-        };
         const std::string parser_source_path = config.output_path + "/" + unit_name + "Parser.cpp";
         std::cout << "Generating file " << parser_source_path << "..." << std::endl;
-        templates::write_template_to_file(cpp_parser_source, parser_source_path, completers);
+        templates::write_template_to_file(cpp_parser_source, parser_source_path, create_parser_source_completers(unit_name, productions, parser_table, config));
+        if (has_parser_shards(config)) {
+            generate_parser_states_sources(unit_name, parser_table, config);
+        }
     }      
 
-    void generate_ast_builder_header(
+    void generate_parser_states_sources(
         const std::string& unit_name,
-        const std::vector<Production>& productions,
+        const ParserTable& parser_table,
         const input::PalexConfig& config
     ) {
         using namespace std::placeholders;
 
-        const std::map<std::string_view, templates::TemplateCompleter_t> completers = {
-            {"UNIT_NAME", templates::constant_completer(unit_name)},
-            {"MODULE_NAMESPACE", templates::constant_completer(config.module_name)},
-            {"REDUCE_METHODS", std::bind(complete_reduce_methods, productions, _1)}
-        };
+        const size_t states_per_shard = get_parser_states_per_shard(parser_table.get_states().size(), config);
+        for (size_t shard = 0; shard < config.shard_count; shard++) {
+            const size_t first_state = shard * states_per_shard;
+            const std::map<std::string_view, templates::TemplateCompleter_t> completers = {
+                {"UNIT_NAME", templates::constant_completer(unit_name)},
+                {"MODULE_NAMESPACE", templates::constant_completer(config.module_name)},
+                {"SHARD_ID", templates::constant_completer(std::to_string(shard))},
+                {"LEXER_INCLUDE", templates::conditional_completer(config.generate_lexer, "\n#include \"" + unit_name + "Lexer.h\"")},
+                {"PARSER_INSTANTIATIONS", std::bind(complete_parser_shard_instantiations, unit_name, shard, config, _1)},
+                {
+                    "PARSER_TABLE", 
+                    [&](std::ostream& output) {
+                        output << sfmt::Indentation{3};
+                        complete_parser_states(parser_table, unit_name, config, first_state, first_state + states_per_shard, output);
+                        output << sfmt::Indentation{-3};
+                    }
+                },
+                {
+                    "GOTO_STATES", 
+                    [&](std::ostream& output) {
+                        output << sfmt::Indentation{3};
+                        complete_goto_state_cases(parser_table, unit_name, first_state, first_state + states_per_shard, output);
+                        output << sfmt::Indentation{-3};
+                    }
+                }
+            };
+            const std::string parser_states_path = config.output_path + "/" + unit_name + "ParserStates" + std::to_string(shard) + ".cpp";
+            std::cout << "Generating file " << parser_states_path << "..." << std::endl;
+            templates::write_template_to_file(cpp_parser_states_source, parser_states_path, completers);
+        }
+    }
+
+    void generate_ast_builder_header(
+        const std::string& unit_name,
+        const std::vector<Production>& productions,
+        const input::PalexConfig& config
+    ) {
         const std::string ast_builder_header_path = config.output_path + "/" + unit_name + "ASTBuilderBase.h";
         std::cout << "Generating file " << ast_builder_header_path << "..." << std::endl;
-        templates::write_template_to_file(cpp_ast_builder_header, ast_builder_header_path, completers);
+        templates::write_template_to_file(cpp_ast_builder_header, ast_builder_header_path, create_ast_builder_header_completers(unit_name, productions, config));
     }      
+
+    void generate_amalgamated_parser(
+        const std::string& unit_name,
+        const std::vector<Production>& productions,
+        const ParserTable& parser_table,
+        const input::PalexConfig& config
+    ) {
+        const std::string parser_header_path = config.output_path + "/" + unit_name + "Parser.h";
+        const std::string amalgamation = templates::amalgamate_sources(
+            {
+                templates::render_template(cpp_ast_builder_header, create_ast_builder_header_completers(unit_name, productions, config)),
+                templates::render_template(cpp_parser_header, create_parser_header_completers(unit_name, productions, parser_table, config)),
+                templates::render_template(cpp_parser_source, create_parser_source_completers(unit_name, productions, parser_table, config))
+            },
+            {
+                {"utf8.h", ""}, 
+                {unit_name + "Token.h", unit_name + "Lexer.h"}, // the tokens are part of the amalgamated lexer
+                {unit_name + "ASTBuilderBase.h", ""}, 
+                {unit_name + "Parser.h", ""}
+            }
+        );
+        std::cout << "Generating file " << parser_header_path << "..." << std::endl;
+        templates::write_string_to_file(amalgamation, parser_header_path);
+    }
 }
\ No newline at end of file
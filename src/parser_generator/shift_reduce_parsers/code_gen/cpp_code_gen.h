@@ -19,6 +19,7 @@ namespace parser_generator::shift_reduce_parsers::code_gen::cpp {
     void generate_parser_header(
         const std::string& unit_name,
         const std::vector<Production>& productions,
+        const ParserTable& parser_table,
         const input::PalexConfig& config
     );
     void generate_parser_source(
@@ -27,9 +28,20 @@ namespace parser_generator::shift_reduce_parsers::code_gen::cpp {
         const ParserTable& parser_table,
         const input::PalexConfig& config
     );
+    void generate_parser_states_sources( // only used when the states are split into multiple shards
+        const std::string& unit_name,
+        const ParserTable& parser_table,
+        const input::PalexConfig& config
+    );
     void generate_ast_builder_header(
         const std::string& unit_name,
         const std::vector<Production>& productions,
         const input::PalexConfig& config
     );
+    void generate_amalgamated_parser( // writes the parser and its AST builder base as a single header on top of the amalgamated lexer
+        const std::string& unit_name,
+        const std::vector<Production>& productions,
+        const ParserTable& parser_table,
+        const input::PalexConfig& config
+    );
 }
\ No newline at end of file
@@ -2,25 +2,167 @@
 
 #include <iostream>
 #include <cassert>
+#include <sstream>
+#include <optional>
+#include <algorithm>
+#include <stdexcept>
 
 #include "util/palex_except.h"
+#include "util/binary_cache.h"
 
 #include "parser_generator/validation.h"
+#include "parser_generator/grammar_reduction.h"
 
 #include "parser_generator/shift_reduce_parsers/parser_table_generation.h"
 #include "parser_generator/shift_reduce_parsers/parser_state_comparators.h"
 #include "parser_generator/shift_reduce_parsers/parser_state.h"
-#include "parser_generator/shift_reduce_parsers/state_lookahead.h"
+#include "parser_generator/shift_reduce_parsers/parser_table_serialization.h"
 
 #include "cpp_code_gen.h"
 
 namespace parser_generator::shift_reduce_parsers::code_gen {
+    constexpr uint64_t PARSER_TABLE_CACHE_VERSION = 4;
+    const std::string PARSER_TABLE_CACHE_CATEGORY = "parser";
+
     const std::vector<ParserCodeGenerator_t> PARSER_CODE_GENERATORS = {
         EMPTY_PARSER_GENERATOR,
         cpp::generate_parser_files
     };
 
-    bool generate_parser(const std::string& unit_name, const std::vector<Production>& productions, const input::PalexConfig& config) {
+    // helper functions
+    ParserTable load_or_generate_parser_table(
+        const std::set<Production>& productions, 
+        const PrecedenceTable_t& precedence_table, 
+        const input::PalexConfig& config
+    );
+    ParserTable generate_parser_table(
+        const std::set<Production>& productions, 
+        const PrecedenceTable_t& precedence_table, 
+        const input::PalexConfig& config
+    );
+    ParserTable generate_adaptive_parser_table(
+        const std::set<Production>& productions, 
+        const PrecedenceTable_t& precedence_table, 
+        const input::PalexConfig& config
+    );
+    std::string create_parser_table_cache_key(
+        const std::set<Production>& productions, 
+        const PrecedenceTable_t& precedence_table, 
+        const input::PalexConfig& config
+    );
+
+    ParserTable load_or_generate_parser_table(
+        const std::set<Production>& productions, 
+        const PrecedenceTable_t& precedence_table, 
+        const input::PalexConfig& config
+    ) {
+        const ParserStateComparator_t& state_comparator = PARSER_STATE_COMPARATORS[(size_t)config.parser_type];
+        if (config.cache_path.empty()) {
+            return generate_parser_table(productions, precedence_table, config);
+        }
+        const std::string cache_key = create_parser_table_cache_key(productions, precedence_table, config);
+        const std::optional<std::string> cached_table = bcache::load_entry(config.cache_path, PARSER_TABLE_CACHE_CATEGORY, cache_key);
+        if (cached_table.has_value()) {
+            try {
+                std::istringstream cached_table_stream(cached_table.value());
+                ParserTable parser_table = read_parser_table(cached_table_stream, state_comparator);
+                std::cout << "Using cached parser table..." << std::endl;
+                return parser_table;
+            } catch (const std::runtime_error& err) {
+                std::cerr << "Ignored damaged cache entry: " << err.what() << std::endl;
+            }
+        }
+
+        const ParserTable parser_table = generate_parser_table(productions, precedence_table, config);
+        try {
+            std::ostringstream serialized_table;
+            write_parser_table(serialized_table, parser_table);
+            bcache::store_entry(config.cache_path, PARSER_TABLE_CACHE_CATEGORY, cache_key, serialized_table.str());
+        } catch (const std::exception& err) { // the cache is only an optimization, so generation continues without it
+            std::cerr << "Failed to cache parser table: " << err.what() << std::endl;
+        }
+        return parser_table;
+    }
+
+    ParserTable generate_parser_table(
+        const std::set<Production>& productions, 
+        const PrecedenceTable_t& precedence_table, 
+        const input::PalexConfig& config
+    ) {
+        if (config.adaptive_lookahead) {
+            return generate_adaptive_parser_table(productions, precedence_table, config);
+        }
+        const ParserStateComparator_t& state_comparator = PARSER_STATE_COMPARATORS[(size_t)config.parser_type];
+        if (config.parser_type == input::ParserType::LALR && config.lookahead == 1) {
+            return ParserTable::generate_lalr_1(productions, state_comparator, precedence_table);
+        }
+        if (config.parser_type == input::ParserType::PGM && config.lookahead > 1) {
+            // the weak compatibility test only rules out new conflicts for single terminals, so longer lookaheads keep the canonical states
+            return ParserTable::generate(productions, lr_state_compare, config.lookahead, lr_state_hash, config.thread_count, precedence_table);
+        }
+        return ParserTable::generate(
+            productions,
+            state_comparator,
+            config.lookahead,
+            PARSER_STATE_HASHES[(size_t)config.parser_type],
+            config.thread_count,
+            precedence_table
+        );
+    }
+
+    ParserTable generate_adaptive_parser_table(
+        const std::set<Production>& productions, 
+        const PrecedenceTable_t& precedence_table, 
+        const input::PalexConfig& config
+    ) {
+        // The lookahead is raised for the whole table, the states of LR(k) tables therefore still get split by the longer lookaheads.
+        // Only the generated parser benefits, as the lookaheads of the states get shortened again afterwards.
+        input::PalexConfig fixed_config = config;
+        fixed_config.adaptive_lookahead = false;
+        for (fixed_config.lookahead = 1; ; fixed_config.lookahead++) {
+            try {
+                const ParserTable parser_table = generate_parser_table(productions, precedence_table, fixed_config);
+                // the table-driven parser maps whole lookaheads to columns, so it needs the same length in every state
+                return config.table_driven_parser ? parser_table : parser_table.with_minimal_lookaheads();
+            } catch (const palex_except::GrammarConflictError& err) {
+                if (fixed_config.lookahead >= config.lookahead) {
+                    throw;
+                }
+                std::cout << "Conflicts with a lookahead of " << fixed_config.lookahead << ", trying " << fixed_config.lookahead + 1 << "..." << std::endl;
+            }
+        }
+    }
+
+    std::string create_parser_table_cache_key(
+        const std::set<Production>& productions, 
+        const PrecedenceTable_t& precedence_table, 
+        const input::PalexConfig& config
+    ) {
+        std::ostringstream cache_key;
+        bcache::write_uint(cache_key, PARSER_TABLE_CACHE_VERSION);
+        bcache::write_uint(cache_key, (uint64_t)config.parser_type);
+        bcache::write_uint(cache_key, config.lookahead);
+        bcache::write_uint(cache_key, config.adaptive_lookahead);
+        bcache::write_uint(cache_key, config.adaptive_lookahead && config.table_driven_parser);
+        bcache::write_uint(cache_key, productions.size());
+        for (const Production& production : productions) {
+            write_production(cache_key, production);
+        }
+        bcache::write_uint(cache_key, precedence_table.size());
+        for (const auto& [terminal, precedence] : precedence_table) {
+            bcache::write_string(cache_key, terminal);
+            bcache::write_uint(cache_key, precedence.level);
+            bcache::write_uint(cache_key, (uint64_t)precedence.associativity);
+        }
+        return cache_key.str();
+    }
+
+    bool generate_parser(
+        const std::string& unit_name, 
+        const std::vector<Production>& productions, 
+        const PrecedenceTable_t& precedence_table, 
+        const input::PalexConfig& config
+    ) {
         if (productions.empty()) {
             std::cerr << "Skipped generation of parser as no productions are given!" << std::endl;
             return false;
@@ -29,16 +171,18 @@ namespace parser_generator::shift_reduce_parsers::code_gen {
             throw palex_except::ValidationError("No parser type supplied!");
         }
         validate_productions(productions);
-        const FirstSet_t first_set = generate_first_set(
-            std::set<Production>(productions.begin(), productions.end()),
-            config.lookahead
-        );
-        const ParserTable parser_table = ParserTable::generate(
-            std::set<Production>(productions.begin(), productions.end()),
-            PARSER_STATE_COMPARATORS[(size_t)config.parser_type],
-            config.lookahead
+        const GrammarReduction reduction = reduce_grammar(productions);
+        std::cout << reduction;
+        const ParserTable parser_table = load_or_generate_parser_table(
+            std::set<Production>(reduction.productions.begin(), reduction.productions.end()), 
+            precedence_table, 
+            config
         );
+        input::PalexConfig code_gen_config = config;
+        if (config.adaptive_lookahead) { // the generated parser only has to buffer as many tokens as the deepest state tests
+            code_gen_config.lookahead = std::max(parser_table.get_max_lookahead_depth(), (size_t)1);
+        }
         assert(PARSER_CODE_GENERATORS.size() > (size_t)config.language && "BUG: Supplied language has no parser generator associated with it!");
-        return PARSER_CODE_GENERATORS[(size_t)config.language](unit_name, productions, parser_table, config);
+        return PARSER_CODE_GENERATORS[(size_t)config.language](unit_name, reduction.productions, parser_table, code_gen_config);
     }
 }
\ No newline at end of file
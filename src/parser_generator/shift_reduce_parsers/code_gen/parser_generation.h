@@ -5,6 +5,7 @@
 #include <functional>
 
 #include "parser_generator/production_definition.h"
+#include "parser_generator/operator_precedence.h"
 
 #include "parser_generator/shift_reduce_parsers/parser_table_generation.h"
 
@@ -23,5 +24,10 @@ namespace parser_generator::shift_reduce_parsers::code_gen {
         return false;
     };
 
-    bool generate_parser(const std::string& unit_name, const std::vector<Production>& productions, const input::PalexConfig& config);
+    bool generate_parser(
+        const std::string& unit_name, 
+        const std::vector<Production>& productions, 
+        const PrecedenceTable_t& precedence_table, 
+        const input::PalexConfig& config
+    );
 }
\ No newline at end of file
@@ -0,0 +1,86 @@
+#include "indexed_parser_state.h"
+
+#include <cassert>
+#include <utility>
+#include <mutex>
+
+namespace parser_generator::shift_reduce_parsers {
+    LookaheadTable::LookaheadTable() {
+    }
+
+    LookaheadID_t LookaheadTable::get_lookahead_id(const IndexedLookahead_t& lookahead) {
+        {
+            std::shared_lock<std::shared_mutex> lock(this->table_mutex);
+            const auto lookahead_id = this->lookahead_ids.find(lookahead);
+            if (lookahead_id != this->lookahead_ids.end()) {
+                return lookahead_id->second;
+            }
+        }
+        std::unique_lock<std::shared_mutex> lock(this->table_mutex);
+        const auto [lookahead_id, inserted] = this->lookahead_ids.insert(std::make_pair(lookahead, this->lookaheads.size()));
+        if (inserted) {
+            this->lookaheads.push_back(lookahead);
+        }
+        return lookahead_id->second;
+    }
+
+    const IndexedLookahead_t& LookaheadTable::get_lookahead(const LookaheadID_t lookahead_id) const {
+        std::shared_lock<std::shared_mutex> lock(this->table_mutex);
+        assert(lookahead_id < this->lookaheads.size() && "BUG: Tried to access non-existent lookahead!");
+        return this->lookaheads[lookahead_id];
+    }
+
+    size_t LookaheadTable::size() const {
+        std::shared_lock<std::shared_mutex> lock(this->table_mutex);
+        return this->lookaheads.size();
+    }
+
+    LookaheadTable::~LookaheadTable() {
+    }
+
+    bool have_same_core(const IndexedProductionState& first, const IndexedProductionState& second) {
+        return first.production == second.production && first.position == second.position;
+    }
+
+    IndexedParserState_t::const_iterator skip_core(IndexedParserState_t::const_iterator core_begin, const IndexedParserState_t::const_iterator end) {
+        const IndexedProductionState& core = *core_begin;
+        while (core_begin != end && have_same_core(core, *core_begin)) {
+            core_begin++;
+        }
+        return core_begin;
+    }
+
+    Lookahead_t to_lookahead(const IndexedLookahead_t& to_convert, const SymbolTable& symbol_table) {
+        Lookahead_t lookahead;
+        for (const SymbolID_t symbol_id : to_convert) {
+            lookahead.push_back(symbol_table.get_symbol(symbol_id));
+        }
+        return lookahead;
+    }
+
+    ProductionState to_production_state(
+        const IndexedProductionState& to_convert,
+        const SymbolTable& symbol_table,
+        const LookaheadTable& lookahead_table
+    ) {
+        return ProductionState(
+            symbol_table.get_production(to_convert.production),
+            to_convert.position,
+            to_lookahead(lookahead_table.get_lookahead(to_convert.lookahead), symbol_table)
+        );
+    }
+
+    bool operator<(const IndexedProductionState& first, const IndexedProductionState& second) {
+        if (first.production != second.production) return first.production < second.production;
+        if (first.position != second.position) return first.position < second.position;
+        return first.lookahead < second.lookahead;
+    }
+
+    bool operator==(const IndexedProductionState& first, const IndexedProductionState& second) {
+        return first.production == second.production && first.position == second.position && first.lookahead == second.lookahead;
+    }
+
+    bool operator!=(const IndexedProductionState& first, const IndexedProductionState& second) {
+        return !(first == second);
+    }
+}
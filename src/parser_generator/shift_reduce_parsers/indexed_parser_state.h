@@ -0,0 +1,58 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include <deque>
+#include <utility>
+#include <set>
+#include <map>
+#include <shared_mutex>
+
+#include "parser_generator/symbol_table.h"
+
+#include "parser_state.h"
+
+namespace parser_generator::shift_reduce_parsers {
+    using LookaheadID_t = uint32_t;
+    using IndexedLookahead_t = std::vector<SymbolID_t>;
+    using IndexedProductionCore_t = std::pair<ProductionID_t, uint32_t>; // production id, position
+
+    // Interns the lookahead sequences, so that production states only have to store an id for them.
+    // The table can be shared by the threads generating states; returned lookaheads stay valid while new ones get added.
+    class LookaheadTable {
+        public:
+            LookaheadTable();
+            LookaheadID_t get_lookahead_id(const IndexedLookahead_t& lookahead); // adds unknown lookaheads to the table
+            const IndexedLookahead_t& get_lookahead(const LookaheadID_t lookahead_id) const;
+            size_t size() const;
+            ~LookaheadTable();
+        private:
+            std::deque<IndexedLookahead_t> lookaheads;
+            std::map<IndexedLookahead_t, LookaheadID_t> lookahead_ids;
+            mutable std::shared_mutex table_mutex;
+    };
+
+    // The counterpart of ProductionState that is used during table generation
+    struct IndexedProductionState {
+        ProductionID_t production;
+        uint32_t position;
+        LookaheadID_t lookahead;
+    };
+
+    // all lookaheads of the same production and position are adjacent in the set
+    using IndexedParserState_t = std::set<IndexedProductionState>;
+
+    bool have_same_core(const IndexedProductionState& first, const IndexedProductionState& second);
+    IndexedParserState_t::const_iterator skip_core(IndexedParserState_t::const_iterator core_begin, const IndexedParserState_t::const_iterator end);
+    Lookahead_t to_lookahead(const IndexedLookahead_t& to_convert, const SymbolTable& symbol_table);
+    ProductionState to_production_state(
+        const IndexedProductionState& to_convert,
+        const SymbolTable& symbol_table,
+        const LookaheadTable& lookahead_table
+    );
+
+    bool operator<(const IndexedProductionState& first, const IndexedProductionState& second);
+    bool operator==(const IndexedProductionState& first, const IndexedProductionState& second);
+    bool operator!=(const IndexedProductionState& first, const IndexedProductionState& second);
+}
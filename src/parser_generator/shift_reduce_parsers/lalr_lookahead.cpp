@@ -0,0 +1,253 @@
+#include "lalr_lookahead.h"
+
+#include <map>
+#include <utility>
+#include <limits>
+#include <algorithm>
+#include <cassert>
+
+#include "parser_generator/symbol_table.h"
+
+#include "terminal_set.h"
+#include "state_lookahead.h"
+
+namespace parser_generator::shift_reduce_parsers {
+    using Lr0Item_t = std::pair<ProductionID_t, size_t>; // production id, position
+    using TransitionRelation_t = std::vector<std::vector<size_t>>; // nonterminal transition id -> related nonterminal transition ids
+
+    struct Lr0State {
+        std::set<Lr0Item_t> items; // kernel and closure items
+        std::map<SymbolID_t, ParserStateID_t> transitions;
+    };
+
+    struct NonterminalTransition {
+        ParserStateID_t source_state;
+        SymbolID_t nonterminal;
+    };
+
+    // helper functions
+    bool derives_empty_suffix(const std::vector<SymbolID_t>& symbols, const size_t position, const std::vector<bool>& nullable_nonterminals);
+    std::set<Lr0Item_t> close_lr_0_items(const std::set<Lr0Item_t>& kernel, const SymbolTable& symbol_table);
+    std::vector<Lr0State> generate_lr_0_automaton(const SymbolTable& symbol_table);
+    std::vector<TerminalSet_t> propagate_terminal_sets(const TransitionRelation_t& relation, std::vector<TerminalSet_t> sets);
+    ParserState create_lalr_1_state(
+        const Lr0State& lr_0_state,
+        const std::map<Lr0Item_t, TerminalSet_t>& item_lookaheads,
+        const SymbolTable& symbol_table,
+        const PrecedenceTable_t& precedence_table
+    );
+
+    bool derives_empty_suffix(const std::vector<SymbolID_t>& symbols, const size_t position, const std::vector<bool>& nullable_nonterminals) {
+        return std::all_of(
+            symbols.begin() + (ssize_t)position,
+            symbols.end(),
+            [&](const SymbolID_t symbol) -> bool { return nullable_nonterminals[symbol]; } // terminals are never nullable
+        );
+    }
+
+    std::set<Lr0Item_t> close_lr_0_items(const std::set<Lr0Item_t>& kernel, const SymbolTable& symbol_table) {
+        std::set<Lr0Item_t> closure = kernel;
+        std::vector<bool> expanded_nonterminals(symbol_table.get_symbol_count(), false);
+        std::vector<Lr0Item_t> to_expand(kernel.begin(), kernel.end());
+        while (!to_expand.empty()) {
+            const auto [production_id, position] = to_expand.back();
+            to_expand.pop_back();
+            const std::vector<SymbolID_t>& symbols = symbol_table.get_production_symbols(production_id);
+            if (position == symbols.size() || symbol_table.is_terminal(symbols[position]) || expanded_nonterminals[symbols[position]]) {
+                continue;
+            }
+            expanded_nonterminals[symbols[position]] = true;
+            assert(!symbol_table.get_nonterminal_productions(symbols[position]).empty() && "BUG: nonterminal mappings are incomplete!");
+            for (const ProductionID_t expansion_id : symbol_table.get_nonterminal_productions(symbols[position])) {
+                if (closure.insert(Lr0Item_t{expansion_id, 0}).second) {
+                    to_expand.push_back(Lr0Item_t{expansion_id, 0});
+                }
+            }
+        }
+        return closure;
+    }
+
+    std::vector<Lr0State> generate_lr_0_automaton(const SymbolTable& symbol_table) {
+        std::set<Lr0Item_t> entry_kernel;
+        const SymbolID_t entry_symbol = symbol_table.get_symbol_id(Symbol{Symbol::SymbolType::NONTERMINAL, ENTRY_PRODUCTION_NAME});
+        for (const ProductionID_t production_id : symbol_table.get_nonterminal_productions(entry_symbol)) {
+            entry_kernel.insert(Lr0Item_t{production_id, 0});
+        }
+        std::vector<Lr0State> automaton{Lr0State{close_lr_0_items(entry_kernel, symbol_table), {}}};
+        std::map<std::set<Lr0Item_t>, ParserStateID_t> kernel_states{{entry_kernel, 0}};
+        for (ParserStateID_t state_id = 0; state_id < automaton.size(); state_id++) { // the states that are still missing transitions form the worklist
+            std::map<SymbolID_t, std::set<Lr0Item_t>> successor_kernels;
+            for (const auto& [production_id, position] : automaton[state_id].items) {
+                const std::vector<SymbolID_t>& symbols = symbol_table.get_production_symbols(production_id);
+                if (position != symbols.size()) {
+                    successor_kernels[symbols[position]].insert(Lr0Item_t{production_id, position + 1});
+                }
+            }
+            for (const auto& [symbol, kernel] : successor_kernels) {
+                const auto [kernel_state, inserted] = kernel_states.insert(std::make_pair(kernel, automaton.size()));
+                if (inserted) {
+                    automaton.push_back(Lr0State{close_lr_0_items(kernel, symbol_table), {}});
+                }
+                automaton[state_id].transitions[symbol] = kernel_state->second;
+            }
+        }
+        return automaton;
+    }
+
+    // The digraph algorithm of DeRemer and Pennello: every set receives the sets of all transitions reachable through the relation.
+    // Transitions of the same strongly connected component end up with the same set.
+    std::vector<TerminalSet_t> propagate_terminal_sets(const TransitionRelation_t& relation, std::vector<TerminalSet_t> sets) {
+        struct TraversalFrame {
+            size_t transition_id;
+            size_t depth;
+            size_t next_related;
+        };
+
+        constexpr size_t COMPLETED = std::numeric_limits<size_t>::max();
+        std::vector<size_t> depths(relation.size(), 0); // 0 marks unvisited transitions
+        std::vector<size_t> component_stack;
+        std::vector<TraversalFrame> traversal; // explicit call stack, so long relation chains can't overflow the native one
+        for (size_t root = 0; root < relation.size(); root++) {
+            if (depths[root] != 0) {
+                continue;
+            }
+            component_stack.push_back(root);
+            depths[root] = component_stack.size();
+            traversal.push_back(TraversalFrame{root, depths[root], 0});
+            while (!traversal.empty()) {
+                TraversalFrame& frame = traversal.back();
+                const size_t transition_id = frame.transition_id;
+                if (frame.next_related < relation[transition_id].size()) {
+                    const size_t related_id = relation[transition_id][frame.next_related++];
+                    if (depths[related_id] == 0) {
+                        component_stack.push_back(related_id);
+                        depths[related_id] = component_stack.size();
+                        traversal.push_back(TraversalFrame{related_id, depths[related_id], 0});
+                        continue;
+                    }
+                    depths[transition_id] = std::min(depths[transition_id], depths[related_id]);
+                    unite_terminal_sets(sets[transition_id], sets[related_id]);
+                    continue;
+                }
+                if (depths[transition_id] == frame.depth) { // root of a strongly connected component
+                    while (true) {
+                        const size_t member_id = component_stack.back();
+                        component_stack.pop_back();
+                        depths[member_id] = COMPLETED;
+                        if (member_id == transition_id) {
+                            break;
+                        }
+                        sets[member_id] = sets[transition_id];
+                    }
+                }
+                traversal.pop_back();
+                if (!traversal.empty()) {
+                    const size_t caller_id = traversal.back().transition_id;
+                    depths[caller_id] = std::min(depths[caller_id], depths[transition_id]);
+                    unite_terminal_sets(sets[caller_id], sets[transition_id]);
+                }
+            }
+        }
+        return sets;
+    }
+
+    ParserState create_lalr_1_state(
+        const Lr0State& lr_0_state,
+        const std::map<Lr0Item_t, TerminalSet_t>& item_lookaheads,
+        const SymbolTable& symbol_table,
+        const PrecedenceTable_t& precedence_table
+    ) {
+        ParserState lalr_1_state{};
+        for (const Lr0Item_t& item : lr_0_state.items) {
+            assert(item_lookaheads.find(item) != item_lookaheads.end() && "BUG: An item of the LR(0) automaton has no lookahead source!");
+            const Production& production = symbol_table.get_production(item.first);
+            for (SymbolID_t terminal_id = 0; terminal_id < symbol_table.get_terminal_count(); terminal_id++) {
+                if (!contains_terminal(item_lookaheads.at(item), terminal_id)) {
+                    continue;
+                }
+                const ProductionState production_state(production, item.second, Lookahead_t{symbol_table.get_symbol(terminal_id)});
+                lalr_1_state.add_production_state(production_state);
+                if (production_state.is_completed()) {
+                    lalr_1_state.add_action(Action{Action::ReduceParameters{production, production_state.get_lookahead()}}, precedence_table);
+                }
+            }
+        }
+        for (const auto& [symbol, next_state] : lr_0_state.transitions) {
+            if (symbol_table.is_terminal(symbol)) {
+                lalr_1_state.add_action(Action{Action::ShiftParameters{next_state, Lookahead_t{symbol_table.get_symbol(symbol)}}}, precedence_table);
+            } else {
+                lalr_1_state.add_action(Action{Action::GotoParameters{next_state, symbol_table.get_symbol(symbol)}});
+            }
+        }
+        return lalr_1_state;
+    }
+
+    std::vector<ParserState> generate_lalr_1_states(const std::set<Production>& productions, const PrecedenceTable_t& precedence_table) {
+        const SymbolTable symbol_table(productions);
+        const std::vector<bool> nullable_nonterminals = generate_terminal_first_set(symbol_table).nullable; // also rejects infinitely recursing grammars
+        const std::vector<Lr0State> automaton = generate_lr_0_automaton(symbol_table);
+
+        // the entry productions behave like a transition on the entry symbol out of the entry state, which is always followed by END_OF_FILE
+        const SymbolID_t entry_symbol = symbol_table.get_symbol_id(Symbol{Symbol::SymbolType::NONTERMINAL, ENTRY_PRODUCTION_NAME});
+        std::vector<NonterminalTransition> transitions{NonterminalTransition{0, entry_symbol}};
+        std::map<std::pair<ParserStateID_t, SymbolID_t>, size_t> transition_ids;
+        for (ParserStateID_t state_id = 0; state_id < automaton.size(); state_id++) {
+            for (const auto& [symbol, _] : automaton[state_id].transitions) {
+                if (!symbol_table.is_terminal(symbol)) {
+                    transition_ids[std::make_pair(state_id, symbol)] = transitions.size();
+                    transitions.push_back(NonterminalTransition{state_id, symbol});
+                }
+            }
+        }
+
+        std::vector<TerminalSet_t> direct_reads(transitions.size(), create_terminal_set(symbol_table.get_terminal_count()));
+        insert_terminal(direct_reads[0], symbol_table.get_end_of_file_id());
+        TransitionRelation_t reads(transitions.size());
+        for (size_t transition_id = 1; transition_id < transitions.size(); transition_id++) {
+            const NonterminalTransition& transition = transitions[transition_id];
+            const ParserStateID_t target_state = automaton[transition.source_state].transitions.at(transition.nonterminal);
+            for (const auto& [symbol, _] : automaton[target_state].transitions) {
+                if (symbol_table.is_terminal(symbol)) {
+                    insert_terminal(direct_reads[transition_id], symbol); // terminals come first, so their symbol ids are also their bit positions
+                } else if (nullable_nonterminals[symbol]) {
+                    reads[transition_id].push_back(transition_ids.at(std::make_pair(target_state, symbol)));
+                }
+            }
+        }
+        const std::vector<TerminalSet_t> read_sets = propagate_terminal_sets(reads, direct_reads);
+
+        // walking each production of a transition through the automaton yields the includes relation and the lookback of every item on the way
+        TransitionRelation_t includes(transitions.size());
+        std::vector<std::map<Lr0Item_t, std::vector<size_t>>> item_lookbacks(automaton.size());
+        for (size_t transition_id = 0; transition_id < transitions.size(); transition_id++) {
+            for (const ProductionID_t production_id : symbol_table.get_nonterminal_productions(transitions[transition_id].nonterminal)) {
+                const std::vector<SymbolID_t>& symbols = symbol_table.get_production_symbols(production_id);
+                ParserStateID_t state_id = transitions[transition_id].source_state;
+                for (size_t position = 0; position <= symbols.size(); position++) {
+                    item_lookbacks[state_id][Lr0Item_t{production_id, position}].push_back(transition_id);
+                    if (position == symbols.size()) {
+                        break;
+                    }
+                    if (!symbol_table.is_terminal(symbols[position]) && derives_empty_suffix(symbols, position + 1, nullable_nonterminals)) {
+                        includes[transition_ids.at(std::make_pair(state_id, symbols[position]))].push_back(transition_id);
+                    }
+                    state_id = automaton[state_id].transitions.at(symbols[position]);
+                }
+            }
+        }
+        const std::vector<TerminalSet_t> follow_sets = propagate_terminal_sets(includes, read_sets);
+
+        std::vector<ParserState> states;
+        for (ParserStateID_t state_id = 0; state_id < automaton.size(); state_id++) {
+            std::map<Lr0Item_t, TerminalSet_t> item_lookaheads;
+            for (const auto& [item, lookback] : item_lookbacks[state_id]) {
+                TerminalSet_t& lookaheads = item_lookaheads.insert(std::make_pair(item, create_terminal_set(symbol_table.get_terminal_count()))).first->second;
+                for (const size_t transition_id : lookback) {
+                    unite_terminal_sets(lookaheads, follow_sets[transition_id]);
+                }
+            }
+            states.push_back(create_lalr_1_state(automaton[state_id], item_lookaheads, symbol_table, precedence_table));
+        }
+        return states;
+    }
+}
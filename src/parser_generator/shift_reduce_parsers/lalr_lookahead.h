@@ -0,0 +1,12 @@
+#pragma once
+
+#include <set>
+#include <vector>
+
+#include "parser_state.h"
+
+namespace parser_generator::shift_reduce_parsers {
+    // Builds the LR(0) automaton of the productions and computes the LALR(1) lookaheads of its items with the reads, includes and lookback
+    // relations of DeRemer and Pennello. The states and actions are the same as the ones of merged canonical LR(1) states.
+    std::vector<ParserState> generate_lalr_1_states(const std::set<Production>& productions, const PrecedenceTable_t& precedence_table);
+}
@@ -7,8 +7,42 @@
 #include <sstream>
 
 #include "util/Visitor.h"
+#include "util/palex_except.h"
 
 namespace parser_generator::shift_reduce_parsers {
+    // helper functions
+    ConflictResolution resolve_action_conflict(const Action& first, const Action& second, const PrecedenceTable_t& precedence_table);
+    const Lookahead_t* get_shift_reduce_lookahead(const Action& action);
+
+    const Lookahead_t* get_shift_reduce_lookahead(const Action& action) {
+        return std::visit(
+            Visitor{
+                [](const Action::GotoParameters& goto_action) -> const Lookahead_t* { return nullptr; },
+                [](const Action::ShiftParameters& shift_action) -> const Lookahead_t* { return &shift_action.lookahead; },
+                [](const Action::ReduceParameters& reduce_action) -> const Lookahead_t* { return &reduce_action.lookahead; }
+            },
+            action.parameters
+        );
+    }
+
+    ConflictResolution resolve_action_conflict(const Action& first, const Action& second, const PrecedenceTable_t& precedence_table) {
+        return std::visit(
+            Visitor{
+                [&](const Action::ShiftParameters& f, const Action::ReduceParameters& s) -> ConflictResolution {
+                    return resolve_shift_reduce_conflict(s.to_reduce, f.lookahead.front().identifier, precedence_table);
+                },
+                [&](const Action::ReduceParameters& f, const Action::ShiftParameters& s) -> ConflictResolution {
+                    return resolve_shift_reduce_conflict(f.to_reduce, s.lookahead.front().identifier, precedence_table);
+                },
+                [](const auto& f, const auto& s) -> ConflictResolution {
+                    return ConflictResolution::UNRESOLVED; 
+                }
+            },
+            first.parameters,
+            second.parameters
+        );
+    }
+
     bool Action::conflict(const Action& first, const Action& second) {
         return std::visit( 
             Visitor{
@@ -100,7 +134,7 @@ namespace parser_generator::shift_reduce_parsers {
                 err << "Conflict occured on state merge:\n" 
                     << "State A:\n" << *this
                     << "State B:\n" << to_merge;
-                throw std::runtime_error(err.str());
+                throw palex_except::GrammarConflictError(err.str());
             }
             this->action_table.insert(action);
         }
@@ -112,11 +146,52 @@ namespace parser_generator::shift_reduce_parsers {
             err << "The action conflicts with the state it is supposed to be in:\n" 
                 << "Action: " << to_add << "\n"
                 << "State:\n" << *this;
-            throw std::runtime_error(err.str());
+            throw palex_except::GrammarConflictError(err.str());
         }
         this->action_table.insert(to_add);
     }
 
+    void ParserState::add_action(const Action& to_add, const PrecedenceTable_t& precedence_table) {
+        const Lookahead_t* lookahead = get_shift_reduce_lookahead(to_add);
+        if (lookahead && this->error_lookaheads.find(*lookahead) != this->error_lookaheads.end()) {
+            return; // further items of the operator must not bring the resolved actions back
+        }
+        const auto conflicting_action = std::find_if(
+            this->action_table.begin(), 
+            this->action_table.end(), 
+            [&](const Action& candidate) -> bool { return Action::conflict(to_add, candidate); }
+        );
+        if (conflicting_action == this->action_table.end()) {
+            this->action_table.insert(to_add);
+            return;
+        }
+        switch (resolve_action_conflict(to_add, *conflicting_action, precedence_table)) {
+            case ConflictResolution::UNRESOLVED:
+                this->add_action(to_add); // reports the conflict
+                break;
+            case ConflictResolution::SHIFT:
+                if (std::holds_alternative<Action::ShiftParameters>(to_add.parameters)) {
+                    this->action_table.erase(conflicting_action);
+                    this->action_table.insert(to_add);
+                }
+                break;
+            case ConflictResolution::REDUCE:
+                if (std::holds_alternative<Action::ReduceParameters>(to_add.parameters)) {
+                    this->action_table.erase(conflicting_action);
+                    this->action_table.insert(to_add);
+                }
+                break;
+            case ConflictResolution::SYNTAX_ERROR: // neither action is taken, so the lookahead is reported as unexpected
+                this->add_error_lookahead(*lookahead);
+                this->action_table.erase(conflicting_action);
+                break;
+        }
+    }
+
+    void ParserState::add_error_lookahead(const Lookahead_t& to_add) {
+        this->error_lookaheads.insert(to_add);
+    }
+
     bool ParserState::add_production_state(const ProductionState& to_add) {
         if (this->production_states.find(to_add) == this->production_states.end()) {
             this->production_states.insert(to_add);
@@ -144,6 +219,10 @@ namespace parser_generator::shift_reduce_parsers {
         return this->action_table;
     }
 
+    const std::set<Lookahead_t>& ParserState::get_error_lookaheads() const {
+        return this->error_lookaheads;
+    }
+
     ParserState::~ParserState() {
     }
 
@@ -176,7 +255,9 @@ namespace parser_generator::shift_reduce_parsers {
     }
 
     bool operator==(const ParserState& first, const ParserState& second) {
-        return first.production_states == second.production_states && first.action_table == second.action_table;
+        return first.production_states == second.production_states 
+            && first.action_table == second.action_table 
+            && first.error_lookaheads == second.error_lookaheads;
     }
 
     bool operator!=(const Action::GotoParameters& first, const Action::GotoParameters& second) {
@@ -230,7 +311,8 @@ namespace parser_generator::shift_reduce_parsers {
 
     bool operator<(const ParserState& first, const ParserState& second) {
         if (first.production_states != second.production_states) return first.production_states < second.production_states;
-        return first.action_table < second.action_table;
+        if (first.action_table != second.action_table) return first.action_table < second.action_table;
+        return first.error_lookaheads < second.error_lookaheads;
     }
 
     std::ostream& operator<<(std::ostream& output, const Action& to_print) {
@@ -272,6 +354,9 @@ namespace parser_generator::shift_reduce_parsers {
         for (const Action& action : to_print.action_table) {
             output << "\t" << action << "\n";
         }
+        for (const Lookahead_t& lookahead : to_print.error_lookaheads) {
+            output << "\terror on " << lookahead << "\n";
+        }
         return output;
     }
 }
@@ -8,6 +8,7 @@
 #include <optional>
 
 #include "parser_generator/production_definition.h"
+#include "parser_generator/operator_precedence.h"
 
 namespace parser_generator::shift_reduce_parsers {
     using ParserStateID_t = size_t;
@@ -60,14 +61,20 @@ namespace parser_generator::shift_reduce_parsers {
             ParserState(const std::set<ProductionState>& initial_production_states);
             void merge(const ParserState& to_merge);
             void add_action(const Action& to_add);
+            // resolves shift/reduce conflicts with the precedence of the operators, the remaining conflicts still throw
+            void add_action(const Action& to_add, const PrecedenceTable_t& precedence_table);
+            // the lookahead is reported as syntax error, even if the state would otherwise reduce without inspecting it
+            void add_error_lookahead(const Lookahead_t& to_add);
             bool add_production_state(const ProductionState& to_add); // returns whether the state changed
             ParserState advance_by(const Symbol& to_advance_by) const;
             const std::set<ProductionState>& get_production_states() const;
             const std::set<Action>& get_actions() const;
+            const std::set<Lookahead_t>& get_error_lookaheads() const;
             ~ParserState();
         private:
             std::set<ProductionState> production_states;
             std::set<Action> action_table;
+            std::set<Lookahead_t> error_lookaheads; // left by non-associative operators, no action may be taken on them
 
             bool conflicts_with(const Action& to_check) const;
 
@@ -1,34 +1,115 @@
 #include "parser_state_comparators.h"
 
+#include <iterator>
+
 // helper functions
-parser_generator::shift_reduce_parsers::ParserState reduce_to_lr_0_core(const parser_generator::shift_reduce_parsers::ParserState& to_reduce);
-
-parser_generator::shift_reduce_parsers::ParserState reduce_to_lr_0_core(const parser_generator::shift_reduce_parsers::ParserState& to_reduce) {
-    parser_generator::shift_reduce_parsers::ParserState lr_0_core;
-    for (const parser_generator::shift_reduce_parsers::ProductionState& production_state : to_reduce.get_production_states()) {
-        lr_0_core.add_production_state(
-            parser_generator::shift_reduce_parsers::ProductionState(
-                production_state.get_production(), 
-                production_state.get_position(), 
-                {} // No lookahead -> LR-0-State
-            )
-        );
-    }
-    return lr_0_core;
+void combine_hash(size_t& seed, const size_t value);
+
+namespace parser_generator::shift_reduce_parsers {
+    std::vector<std::vector<LookaheadID_t>> collect_core_lookaheads(const IndexedParserState_t& state);
+    bool have_common_lookahead(const std::vector<LookaheadID_t>& first, const std::vector<LookaheadID_t>& second);
+}
+
+void combine_hash(size_t& seed, const size_t value) {
+    seed ^= value + 0x9e3779b97f4a7c15 + (seed << 6) + (seed >> 2);
 }
 
 namespace parser_generator::shift_reduce_parsers {
     const std::vector<ParserStateComparator_t> PARSER_STATE_COMPARATORS = {
         EMPTY_PARSER_STATE_COMPARATOR,
         lalr_state_compare,
-        lr_state_compare
+        lr_state_compare,
+        pgm_state_compare
+    };
+
+    const std::vector<ParserStateHash_t> PARSER_STATE_HASHES = {
+        lalr_state_hash,
+        lalr_state_hash,
+        lr_state_hash,
+        lalr_state_hash // states with the same core may stay apart, so they share a bucket of the state index
     };
 
-    bool lr_state_compare(const ParserState& first, const ParserState& second) {
-        return first.get_production_states() == second.get_production_states(); // actions are the same when the production states are the same
+    std::vector<std::vector<LookaheadID_t>> collect_core_lookaheads(const IndexedParserState_t& state) {
+        std::vector<std::vector<LookaheadID_t>> core_lookaheads;
+        for (auto core = state.begin(); core != state.end(); core++) {
+            if (core == state.begin() || !have_same_core(*std::prev(core), *core)) {
+                core_lookaheads.emplace_back();
+            }
+            core_lookaheads.back().push_back(core->lookahead); // sorted, as the lookaheads of a core are ordered in the state
+        }
+        return core_lookaheads;
+    }
+
+    bool have_common_lookahead(const std::vector<LookaheadID_t>& first, const std::vector<LookaheadID_t>& second) {
+        auto first_lookahead = first.begin();
+        auto second_lookahead = second.begin();
+        while (first_lookahead != first.end() && second_lookahead != second.end()) {
+            if (*first_lookahead == *second_lookahead) {
+                return true;
+            }
+            if (*first_lookahead < *second_lookahead) {
+                first_lookahead++;
+            } else {
+                second_lookahead++;
+            }
+        }
+        return false;
     }
 
-    bool lalr_state_compare(const ParserState& first, const ParserState& second) {
-        return reduce_to_lr_0_core(first) == reduce_to_lr_0_core(second);
+    bool lr_state_compare(const IndexedParserState_t& first, const IndexedParserState_t& second) {
+        return first == second; // actions are the same when the production states are the same
     }
-}
\ No newline at end of file
+
+    bool lalr_state_compare(const IndexedParserState_t& first, const IndexedParserState_t& second) {
+        auto first_core = first.begin();
+        auto second_core = second.begin();
+        while (first_core != first.end() && second_core != second.end()) {
+            if (!have_same_core(*first_core, *second_core)) {
+                return false;
+            }
+            first_core = skip_core(first_core, first.end());
+            second_core = skip_core(second_core, second.end());
+        }
+        return first_core == first.end() && second_core == second.end();
+    }
+
+    bool pgm_state_compare(const IndexedParserState_t& first, const IndexedParserState_t& second) {
+        if (!lalr_state_compare(first, second)) {
+            return false;
+        }
+        const std::vector<std::vector<LookaheadID_t>> first_lookaheads = collect_core_lookaheads(first);
+        const std::vector<std::vector<LookaheadID_t>> second_lookaheads = collect_core_lookaheads(second);
+        for (size_t core = 0; core < first_lookaheads.size(); core++) {
+            for (size_t other_core = core + 1; other_core < first_lookaheads.size(); other_core++) {
+                const bool creates_overlap = have_common_lookahead(first_lookaheads[core], second_lookaheads[other_core])
+                    || have_common_lookahead(second_lookaheads[core], first_lookaheads[other_core]);
+                // an overlap that one of the states already has can't make the merged state any worse
+                const bool has_overlap = have_common_lookahead(first_lookaheads[core], first_lookaheads[other_core])
+                    || have_common_lookahead(second_lookaheads[core], second_lookaheads[other_core]);
+                if (creates_overlap && !has_overlap) {
+                    return false;
+                }
+            }
+        }
+        return true;
+    }
+
+    size_t lr_state_hash(const IndexedParserState_t& to_hash) {
+        size_t state_hash = 0;
+        for (const IndexedProductionState& production_state : to_hash) {
+            combine_hash(state_hash, production_state.production);
+            combine_hash(state_hash, production_state.position);
+            combine_hash(state_hash, production_state.lookahead);
+        }
+        return state_hash;
+    }
+
+    size_t lalr_state_hash(const IndexedParserState_t& to_hash) {
+        size_t state_hash = 0;
+        for (auto core = to_hash.begin(); core != to_hash.end(); core = skip_core(core, to_hash.end())) {
+            combine_hash(state_hash, core->production);
+            combine_hash(state_hash, core->position);
+        }
+        return state_hash;
+    }
+}
@@ -2,17 +2,25 @@
 
 #include <functional>
 #include <vector>
+#include <cstddef>
 
-#include "parser_state.h"
+#include "indexed_parser_state.h"
 
 namespace parser_generator::shift_reduce_parsers {
-    using ParserStateComparator_t = std::function<bool(const ParserState&, const ParserState&)>;
+    using ParserStateComparator_t = std::function<bool(const IndexedParserState_t&, const IndexedParserState_t&)>;
+    using ParserStateHash_t = std::function<size_t(const IndexedParserState_t&)>; // states that are equal according to the matching comparator need the same hash
 
     extern const std::vector<ParserStateComparator_t> PARSER_STATE_COMPARATORS;
-    inline const ParserStateComparator_t EMPTY_PARSER_STATE_COMPARATOR = [](const ParserState&, const ParserState&) -> bool {
+    extern const std::vector<ParserStateHash_t> PARSER_STATE_HASHES;
+    inline const ParserStateComparator_t EMPTY_PARSER_STATE_COMPARATOR = [](const IndexedParserState_t&, const IndexedParserState_t&) -> bool {
         return false;
     };
 
-    bool lr_state_compare(const ParserState& first, const ParserState& second);
-    bool lalr_state_compare(const ParserState& first, const ParserState& second);
-}
\ No newline at end of file
+    bool lr_state_compare(const IndexedParserState_t& first, const IndexedParserState_t& second);
+    bool lalr_state_compare(const IndexedParserState_t& first, const IndexedParserState_t& second);
+    // Pager's weak compatibility: states with the same core are only merged if that can't create conflicts the unmerged states don't have.
+    // This only holds for a lookahead of one terminal, so longer lookaheads have to use lr_state_compare instead.
+    bool pgm_state_compare(const IndexedParserState_t& first, const IndexedParserState_t& second);
+    size_t lr_state_hash(const IndexedParserState_t& to_hash);
+    size_t lalr_state_hash(const IndexedParserState_t& to_hash); // only depends on the LR(0) core, so it works with every comparator
+}
@@ -0,0 +1,385 @@
+#include "parser_table_builder.h"
+
+#include <algorithm>
+#include <cassert>
+#include <utility>
+#include <mutex>
+
+namespace parser_generator::shift_reduce_parsers {
+    ParserTableBuilder::ParserTableBuilder(
+        const std::set<Production>& productions,
+        const ParserStateComparator_t& state_comparator,
+        const ParserStateHash_t& state_hash,
+        const size_t lookahead,
+        const size_t thread_count,
+        const PrecedenceTable_t& precedence_table
+    ) : symbol_table(productions),
+        state_comparator(state_comparator),
+        state_hash(state_hash),
+        lookahead(lookahead),
+        precedence_table(precedence_table),
+        thread_pool(thread_count),
+        first_set(lookahead != 1 ? generate_indexed_first_set(this->symbol_table, lookahead) : IndexedFirstSet_t{}),
+        terminal_first_set(lookahead == 1 ? generate_terminal_first_set(this->symbol_table) : TerminalFirstSet{}) {
+        if (lookahead == 1) {
+            for (SymbolID_t terminal_id = 0; terminal_id < this->symbol_table.get_terminal_count(); terminal_id++) {
+                this->terminal_lookahead_ids.push_back(this->lookahead_table.get_lookahead_id(IndexedLookahead_t{terminal_id}));
+            }
+            this->closure_templates.resize(this->symbol_table.get_symbol_count());
+            for (SymbolID_t symbol_id = (SymbolID_t)this->symbol_table.get_terminal_count(); symbol_id < this->symbol_table.get_symbol_count(); symbol_id++) {
+                this->closure_templates[symbol_id] = this->generate_closure_template(symbol_id);
+            }
+        }
+    }
+
+    std::vector<ParserState> ParserTableBuilder::build() {
+        const IndexedParserState_t entry_state = this->expand_state(this->create_entry_state());
+        this->intern_state(entry_state, this->state_hash(entry_state));
+        // The successors of a whole frontier are generated in parallel, while interning them stays in the order of the frontier.
+        // Therefore the states get the same ids no matter how many threads there are.
+        while (!this->unprocessed_states.empty()) {
+            std::vector<ParserStateID_t> frontier;
+            std::vector<bool> in_frontier(this->states.size(), false);
+            for (const ParserStateID_t state_id : this->unprocessed_states) {
+                if (!in_frontier[state_id]) {
+                    in_frontier[state_id] = true;
+                    frontier.push_back(state_id);
+                }
+            }
+            this->unprocessed_states.clear();
+
+            std::vector<std::vector<StateSuccessor>> frontier_successors(frontier.size());
+            this->thread_pool.run(frontier.size(), [&](const size_t frontier_id) -> void {
+                frontier_successors[frontier_id] = this->generate_successors(frontier[frontier_id]);
+            });
+            for (size_t frontier_id = 0; frontier_id < frontier.size(); frontier_id++) {
+                for (const StateSuccessor& successor : frontier_successors[frontier_id]) {
+                    this->transitions[frontier[frontier_id]][successor.symbol] = this->intern_state(successor.state, successor.state_hash);
+                }
+            }
+        }
+        this->renumber_states();
+
+        // conflicts are only detected once the whole graph exists, the one of the state with the lowest id gets reported
+        std::vector<ParserState> parser_states(this->states.size());
+        this->thread_pool.run(this->states.size(), [&](const size_t state_id) -> void {
+            parser_states[state_id] = this->create_parser_state(state_id);
+        });
+        return parser_states;
+    }
+
+    ParserTableBuilder::~ParserTableBuilder() {
+    }
+
+    IndexedParserState_t ParserTableBuilder::create_entry_state() {
+        const LookaheadID_t entry_lookahead = this->lookahead_table.get_lookahead_id(
+            IndexedLookahead_t(this->lookahead, this->symbol_table.get_end_of_file_id())
+        );
+        IndexedParserState_t entry_state;
+        const SymbolID_t entry_symbol = this->symbol_table.get_symbol_id(Symbol{Symbol::SymbolType::NONTERMINAL, ENTRY_PRODUCTION_NAME});
+        for (const ProductionID_t production_id : this->symbol_table.get_nonterminal_productions(entry_symbol)) {
+            entry_state.insert(IndexedProductionState{production_id, 0, entry_lookahead});
+        }
+        return entry_state;
+    }
+
+    IndexedParserState_t ParserTableBuilder::expand_state(const IndexedParserState_t& to_expand) {
+        if (this->lookahead == 1) {
+            return this->expand_state_with_terminal_sets(to_expand);
+        }
+        // the closure of a state is the union of the closures of the nonterminals its items expect, which are shared between states
+        IndexedParserState_t expanded_state = to_expand;
+        for (const IndexedProductionState& production_state : to_expand) {
+            const std::vector<SymbolID_t>& symbols = this->symbol_table.get_production_symbols(production_state.production);
+            if (production_state.position == symbols.size() || this->symbol_table.is_terminal(symbols[production_state.position])) {
+                continue;
+            }
+            for (const IndexedLookahead_t& expansion_lookahead : follow_terminals(
+                production_state,
+                this->symbol_table,
+                this->lookahead_table,
+                this->first_set,
+                this->lookahead
+            )) {
+                const std::vector<IndexedProductionState>& nonterminal_closure = this->get_nonterminal_closure(
+                    symbols[production_state.position],
+                    this->lookahead_table.get_lookahead_id(expansion_lookahead)
+                );
+                expanded_state.insert(nonterminal_closure.begin(), nonterminal_closure.end());
+            }
+        }
+        return expanded_state;
+    }
+
+    IndexedParserState_t ParserTableBuilder::expand_state_with_terminal_sets(const IndexedParserState_t& to_expand) const {
+        // all lookaheads of an item share one bitset, and the closure items of each nonterminal come from its template
+        std::map<IndexedProductionCore_t, TerminalSet_t> item_lookaheads;
+        for (const IndexedProductionState& production_state : to_expand) {
+            TerminalSet_t& lookaheads = item_lookaheads.insert(std::make_pair(
+                IndexedProductionCore_t{production_state.production, production_state.position},
+                create_terminal_set(this->symbol_table.get_terminal_count())
+            )).first->second;
+            insert_terminal(lookaheads, this->lookahead_table.get_lookahead(production_state.lookahead).front());
+        }
+        // the kernel lookaheads are copied, as lookaheads added by the templates are already part of the templates
+        const std::vector<std::pair<IndexedProductionCore_t, TerminalSet_t>> kernel(item_lookaheads.begin(), item_lookaheads.end());
+        for (const auto& [core, kernel_lookaheads] : kernel) {
+            const std::vector<SymbolID_t>& symbols = this->symbol_table.get_production_symbols(core.first);
+            if (core.second == symbols.size() || this->symbol_table.is_terminal(symbols[core.second])) {
+                continue;
+            }
+            const TerminalSet_t expansion_lookaheads = follow_terminals(symbols, core.second + 1, kernel_lookaheads, this->terminal_first_set);
+            for (const ClosureTemplateItem& template_item : this->closure_templates[symbols[core.second]]) {
+                TerminalSet_t& lookaheads = item_lookaheads.insert(std::make_pair(
+                    IndexedProductionCore_t{template_item.production, 0},
+                    create_terminal_set(this->symbol_table.get_terminal_count())
+                )).first->second;
+                unite_terminal_sets(lookaheads, template_item.spontaneous_lookaheads);
+                if (template_item.propagates_lookaheads) {
+                    unite_terminal_sets(lookaheads, expansion_lookaheads);
+                }
+            }
+        }
+
+        IndexedParserState_t expanded_state;
+        for (const auto& [item, lookaheads] : item_lookaheads) {
+            for (SymbolID_t terminal_id = 0; terminal_id < this->symbol_table.get_terminal_count(); terminal_id++) {
+                if (contains_terminal(lookaheads, terminal_id)) {
+                    expanded_state.insert(IndexedProductionState{item.first, item.second, this->terminal_lookahead_ids[terminal_id]});
+                }
+            }
+        }
+        return expanded_state;
+    }
+
+    const std::vector<IndexedProductionState>& ParserTableBuilder::get_nonterminal_closure(const SymbolID_t nonterminal, const LookaheadID_t lookahead_id) {
+        {
+            std::shared_lock<std::shared_mutex> lock(this->nonterminal_closures_mutex);
+            const auto cached_closure = this->nonterminal_closures.find(std::make_pair(nonterminal, lookahead_id));
+            if (cached_closure != this->nonterminal_closures.end()) {
+                return cached_closure->second; // entries of the map are never moved
+            }
+        }
+        const std::vector<ProductionID_t>& expansions = this->symbol_table.get_nonterminal_productions(nonterminal);
+        assert(!expansions.empty() && "BUG: nonterminal mappings are incomplete!");
+        IndexedParserState_t closure;
+        std::vector<IndexedProductionState> to_visit;
+        for (const ProductionID_t expansion : expansions) {
+            closure.insert(IndexedProductionState{expansion, 0, lookahead_id});
+            to_visit.push_back(IndexedProductionState{expansion, 0, lookahead_id});
+        }
+        while (!to_visit.empty()) {
+            const IndexedProductionState production_state = to_visit.back();
+            to_visit.pop_back();
+            const std::vector<SymbolID_t>& symbols = this->symbol_table.get_production_symbols(production_state.production);
+            if (symbols.empty() || this->symbol_table.is_terminal(symbols.front())) {
+                continue;
+            }
+            for (const IndexedLookahead_t& expansion_lookahead : follow_terminals(
+                production_state,
+                this->symbol_table,
+                this->lookahead_table,
+                this->first_set,
+                this->lookahead
+            )) {
+                const LookaheadID_t expansion_lookahead_id = this->lookahead_table.get_lookahead_id(expansion_lookahead);
+                for (const ProductionID_t expansion : this->symbol_table.get_nonterminal_productions(symbols.front())) {
+                    const IndexedProductionState expanded_production_state{expansion, 0, expansion_lookahead_id};
+                    if (closure.insert(expanded_production_state).second) {
+                        to_visit.push_back(expanded_production_state);
+                    }
+                }
+            }
+        }
+        std::unique_lock<std::shared_mutex> lock(this->nonterminal_closures_mutex); // another thread may have inserted the same closure meanwhile
+        return this->nonterminal_closures.insert(std::make_pair(
+            std::make_pair(nonterminal, lookahead_id),
+            std::vector<IndexedProductionState>(closure.begin(), closure.end())
+        )).first->second;
+    }
+
+    std::vector<ClosureTemplateItem> ParserTableBuilder::generate_closure_template(const SymbolID_t nonterminal) const {
+        std::map<ProductionID_t, ClosureTemplateItem> template_items;
+        std::vector<ProductionID_t> to_visit;
+        for (const ProductionID_t expansion : this->symbol_table.get_nonterminal_productions(nonterminal)) {
+            template_items.insert(std::make_pair(expansion, ClosureTemplateItem{expansion, create_terminal_set(this->symbol_table.get_terminal_count()), true}));
+            to_visit.push_back(expansion);
+        }
+        while (!to_visit.empty()) {
+            const ProductionID_t production_id = to_visit.back();
+            to_visit.pop_back();
+            const std::vector<SymbolID_t>& symbols = this->symbol_table.get_production_symbols(production_id);
+            if (symbols.empty() || this->symbol_table.is_terminal(symbols.front())) {
+                continue;
+            }
+            const ClosureTemplateItem& template_item = template_items.at(production_id);
+            const TerminalSet_t spontaneous_lookaheads = follow_terminals(symbols, 1, template_item.spontaneous_lookaheads, this->terminal_first_set);
+            const bool propagates_lookaheads = template_item.propagates_lookaheads && std::all_of(
+                symbols.begin() + 1,
+                symbols.end(),
+                [&](const SymbolID_t symbol) -> bool { return this->terminal_first_set.nullable[symbol]; }
+            );
+            for (const ProductionID_t expansion : this->symbol_table.get_nonterminal_productions(symbols.front())) {
+                const auto [expanded_item, inserted] = template_items.insert(std::make_pair(
+                    expansion,
+                    ClosureTemplateItem{expansion, create_terminal_set(this->symbol_table.get_terminal_count()), false}
+                ));
+                bool changed = unite_terminal_sets(expanded_item->second.spontaneous_lookaheads, spontaneous_lookaheads);
+                if (propagates_lookaheads && !expanded_item->second.propagates_lookaheads) {
+                    expanded_item->second.propagates_lookaheads = true;
+                    changed = true;
+                }
+                if (inserted || changed) {
+                    to_visit.push_back(expansion);
+                }
+            }
+        }
+
+        std::vector<ClosureTemplateItem> closure_template;
+        for (const auto& [_, template_item] : template_items) {
+            closure_template.push_back(template_item);
+        }
+        return closure_template;
+    }
+
+    IndexedParserState_t ParserTableBuilder::advance_state(const IndexedParserState_t& to_advance, const SymbolID_t symbol_id) const {
+        IndexedParserState_t advanced_state;
+        for (const IndexedProductionState& production_state : to_advance) {
+            const std::vector<SymbolID_t>& symbols = this->symbol_table.get_production_symbols(production_state.production);
+            if (production_state.position != symbols.size() && symbols[production_state.position] == symbol_id) {
+                advanced_state.insert(IndexedProductionState{production_state.production, production_state.position + 1, production_state.lookahead});
+            }
+        }
+        assert(!advanced_state.empty() && "BUG: Tried to advance into an empty state!");
+        return advanced_state;
+    }
+
+    std::set<SymbolID_t> ParserTableBuilder::get_next_symbols(const IndexedParserState_t& state) const {
+        std::set<SymbolID_t> next_symbols;
+        for (const IndexedProductionState& production_state : state) {
+            const std::vector<SymbolID_t>& symbols = this->symbol_table.get_production_symbols(production_state.production);
+            if (production_state.position != symbols.size()) {
+                next_symbols.insert(symbols[production_state.position]);
+            }
+        }
+        return next_symbols;
+    }
+
+    std::vector<StateSuccessor> ParserTableBuilder::generate_successors(const ParserStateID_t state_id) {
+        std::vector<StateSuccessor> successors;
+        for (const SymbolID_t next_symbol : this->get_next_symbols(this->states[state_id])) {
+            IndexedParserState_t next_state = this->expand_state(this->advance_state(this->states[state_id], next_symbol));
+            const size_t next_state_hash = this->state_hash(next_state);
+            successors.push_back(StateSuccessor{next_symbol, std::move(next_state), next_state_hash});
+        }
+        return successors;
+    }
+
+    ParserStateID_t ParserTableBuilder::intern_state(const IndexedParserState_t& expanded_state, const size_t state_hash) {
+        const std::optional<ParserStateID_t> equivalent_state_id = this->find_equivalent_state_id(expanded_state, state_hash);
+        if (equivalent_state_id.has_value()) {
+            IndexedParserState_t& equivalent_state = this->states[equivalent_state_id.value()];
+            // if not all lookaheads are covered, the transitions have to be generated again for the merged state
+            if (!std::includes(equivalent_state.begin(), equivalent_state.end(), expanded_state.begin(), expanded_state.end())) {
+                equivalent_state.insert(expanded_state.begin(), expanded_state.end());
+                this->unprocessed_states.push_back(equivalent_state_id.value());
+            }
+            return equivalent_state_id.value();
+        }
+        this->states.push_back(expanded_state);
+        this->transitions.emplace_back();
+        this->state_index.insert(std::make_pair(state_hash, this->states.size() - 1));
+        this->unprocessed_states.push_back(this->states.size() - 1);
+        return this->states.size() - 1;
+    }
+
+    std::optional<ParserStateID_t> ParserTableBuilder::find_equivalent_state_id(const IndexedParserState_t& to_find, const size_t state_hash) const {
+        const auto [candidates_begin, candidates_end] = this->state_index.equal_range(state_hash);
+        for (auto candidate = candidates_begin; candidate != candidates_end; candidate++) {
+            if (this->state_comparator(to_find, this->states[candidate->second])) {
+                return candidate->second;
+            }
+        }
+        return std::nullopt;
+    }
+
+    void ParserTableBuilder::renumber_states() {
+        // breadth-first from the entry state with the successors in symbol order, so the ids only depend on the finished graph
+        std::vector<ParserStateID_t> new_ids(this->states.size(), this->states.size());
+        std::vector<ParserStateID_t> old_ids{0};
+        new_ids[0] = 0;
+        for (size_t visited = 0; visited < old_ids.size(); visited++) {
+            for (const auto& [_, next_state] : this->transitions[old_ids[visited]]) {
+                if (new_ids[next_state] == this->states.size()) {
+                    new_ids[next_state] = old_ids.size();
+                    old_ids.push_back(next_state);
+                }
+            }
+        }
+        assert(old_ids.size() == this->states.size() && "BUG: Generated a state that can't be reached from the entry state!");
+
+        std::vector<IndexedParserState_t> renumbered_states;
+        std::vector<std::map<SymbolID_t, ParserStateID_t>> renumbered_transitions;
+        for (const ParserStateID_t old_id : old_ids) {
+            renumbered_states.push_back(std::move(this->states[old_id]));
+            renumbered_transitions.emplace_back();
+            for (const auto& [symbol, next_state] : this->transitions[old_id]) {
+                renumbered_transitions.back()[symbol] = new_ids[next_state];
+            }
+        }
+        this->states = std::move(renumbered_states);
+        this->transitions = std::move(renumbered_transitions);
+        this->state_index.clear(); // the index is only needed while generating the graph
+    }
+
+    ParserState ParserTableBuilder::create_parser_state(const ParserStateID_t state_id) const {
+        std::set<ProductionState> production_states;
+        for (const IndexedProductionState& production_state : this->states[state_id]) {
+            production_states.insert(to_production_state(production_state, this->symbol_table, this->lookahead_table));
+        }
+        ParserState parser_state(production_states);
+        for (const IndexedProductionState& production_state : this->states[state_id]) {
+            if (production_state.position == this->symbol_table.get_production_symbols(production_state.production).size()) {
+                parser_state.add_action(Action{Action::ReduceParameters{
+                    this->symbol_table.get_production(production_state.production),
+                    to_lookahead(this->lookahead_table.get_lookahead(production_state.lookahead), this->symbol_table)
+                }}, this->precedence_table);
+            }
+        }
+        for (const auto& [next_symbol, next_state] : this->transitions[state_id]) { // terminals have smaller ids, so shifts come before gotos
+            if (this->symbol_table.is_terminal(next_symbol)) {
+                this->add_shift_actions(parser_state, state_id, next_symbol, next_state);
+            } else {
+                parser_state.add_action(Action{Action::GotoParameters{next_state, this->symbol_table.get_symbol(next_symbol)}});
+            }
+        }
+        return parser_state;
+    }
+
+    void ParserTableBuilder::add_shift_actions(ParserState& target, const ParserStateID_t state_id, const SymbolID_t terminal_id, const ParserStateID_t next_state) const {
+        std::set<IndexedLookahead_t> shift_lookaheads;
+        for (const IndexedProductionState& production_state : this->states[state_id]) {
+            const std::vector<SymbolID_t>& symbols = this->symbol_table.get_production_symbols(production_state.production);
+            if (production_state.position == symbols.size() || symbols[production_state.position] != terminal_id) {
+                continue;
+            }
+            if (this->lookahead <= 1) { // the shifted terminal is already the whole lookahead
+                shift_lookaheads.insert(IndexedLookahead_t{terminal_id});
+                continue;
+            }
+            for (IndexedLookahead_t shift_lookahead : follow_terminals(
+                production_state,
+                this->symbol_table,
+                this->lookahead_table,
+                this->first_set,
+                this->lookahead - 1 // the shifted terminal is the first symbol of the lookahead
+            )) {
+                shift_lookahead.insert(shift_lookahead.begin(), terminal_id);
+                shift_lookaheads.insert(shift_lookahead);
+            }
+        }
+        for (const IndexedLookahead_t& shift_lookahead : shift_lookaheads) {
+            target.add_action(Action{Action::ShiftParameters{next_state, to_lookahead(shift_lookahead, this->symbol_table)}}, this->precedence_table);
+        }
+    }
+}
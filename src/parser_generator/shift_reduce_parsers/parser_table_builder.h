@@ -0,0 +1,82 @@
+#pragma once
+
+#include <cstddef>
+#include <set>
+#include <map>
+#include <vector>
+#include <shared_mutex>
+#include <optional>
+#include <unordered_map>
+
+#include "util/thread_pool.h"
+
+#include "parser_generator/symbol_table.h"
+
+#include "parser_state.h"
+#include "indexed_parser_state.h"
+#include "parser_state_comparators.h"
+#include "state_lookahead.h"
+#include "terminal_set.h"
+
+namespace parser_generator::shift_reduce_parsers {
+    // An item of the closure of a nonterminal, whose lookaheads are made up of fixed terminals and the terminals following the nonterminal
+    struct ClosureTemplateItem {
+        ProductionID_t production; // the position is always 0
+        TerminalSet_t spontaneous_lookaheads;
+        bool propagates_lookaheads;
+    };
+
+    // A successor of a state that the workers prepare, so the only thing left to do in order is interning it
+    struct StateSuccessor {
+        SymbolID_t symbol;
+        IndexedParserState_t state; // already expanded
+        size_t state_hash;
+    };
+
+    // Generates the states of a parser table on the interned grammar. Names are only restored when the finished states get converted.
+    class ParserTableBuilder {
+        public:
+            ParserTableBuilder(
+                const std::set<Production>& productions,
+                const ParserStateComparator_t& state_comparator,
+                const ParserStateHash_t& state_hash,
+                const size_t lookahead,
+                const size_t thread_count,
+                const PrecedenceTable_t& precedence_table
+            );
+            std::vector<ParserState> build();
+            ~ParserTableBuilder();
+        private:
+            const SymbolTable symbol_table;
+            const ParserStateComparator_t& state_comparator;
+            const ParserStateHash_t& state_hash;
+            const size_t lookahead;
+            const PrecedenceTable_t& precedence_table;
+            tpool::ThreadPool thread_pool;
+            const IndexedFirstSet_t first_set; // only generated for lookaheads other than 1
+            const TerminalFirstSet terminal_first_set; // only generated for a lookahead of 1
+            LookaheadTable lookahead_table;
+            std::vector<LookaheadID_t> terminal_lookahead_ids; // terminal id -> id of the lookahead only made up of the terminal
+            std::vector<std::vector<ClosureTemplateItem>> closure_templates; // nonterminal id -> its closure, only generated for a lookahead of 1
+            std::map<std::pair<SymbolID_t, LookaheadID_t>, std::vector<IndexedProductionState>> nonterminal_closures; // cache for other lookaheads
+            std::shared_mutex nonterminal_closures_mutex;
+            std::vector<IndexedParserState_t> states;
+            std::vector<std::map<SymbolID_t, ParserStateID_t>> transitions;
+            std::unordered_multimap<size_t, ParserStateID_t> state_index; // state hash -> states with that hash
+            std::vector<ParserStateID_t> unprocessed_states; // states whose transitions are missing or outdated
+
+            IndexedParserState_t create_entry_state();
+            IndexedParserState_t expand_state(const IndexedParserState_t& to_expand);
+            IndexedParserState_t expand_state_with_terminal_sets(const IndexedParserState_t& to_expand) const;
+            const std::vector<IndexedProductionState>& get_nonterminal_closure(const SymbolID_t nonterminal, const LookaheadID_t lookahead_id);
+            std::vector<ClosureTemplateItem> generate_closure_template(const SymbolID_t nonterminal) const;
+            IndexedParserState_t advance_state(const IndexedParserState_t& to_advance, const SymbolID_t symbol_id) const;
+            std::set<SymbolID_t> get_next_symbols(const IndexedParserState_t& state) const;
+            std::vector<StateSuccessor> generate_successors(const ParserStateID_t state_id);
+            ParserStateID_t intern_state(const IndexedParserState_t& expanded_state, const size_t state_hash);
+            std::optional<ParserStateID_t> find_equivalent_state_id(const IndexedParserState_t& to_find, const size_t state_hash) const;
+            void renumber_states();
+            ParserState create_parser_state(const ParserStateID_t state_id) const;
+            void add_shift_actions(ParserState& target, const ParserStateID_t state_id, const SymbolID_t terminal_id, const ParserStateID_t next_state) const;
+    };
+}
@@ -5,6 +5,7 @@
 #include <cassert>
 #include <functional>
 #include <stack>
+#include <map>
 #include <utility>
 #include <variant>
 
@@ -14,144 +15,147 @@
 
 #include "parser_state_comparators.h"
 #include "state_lookahead.h"
+#include "lalr_lookahead.h"
+#include "util/thread_pool.h"
+
+#include "parser_table_builder.h"
 
 namespace parser_generator::shift_reduce_parsers {
 
     // helper functions
-    template<class T>
-    std::set<T> filter_set(const std::set<T>& to_filter, bool(*predicate)(const T&));
-    std::set<Production> filter_entry_productions(const std::set<Production>& productions);
-    std::set<ProductionState> filter_reduce_production_states(const std::set<ProductionState>& production_states);
-    std::set<Symbol> get_next_symbols(const std::set<ProductionState>& production_states);
-    NonterminalMappings_t generate_nonterminal_mappings(const std::set<Production>& productions);
-    ParserState create_entry_state(const std::set<Production>& productions, const size_t lookahead);
-    ParserState expand_parser_state(
-        const ParserState& to_expand, 
-        const FirstSet_t& first_set, 
-        const NonterminalMappings_t& nonterminal_mappings,
-        const size_t lookahead
-    );
-    void expand_production_state(
-        const ProductionState& to_expand, 
-        ParserState& target, 
-        const FirstSet_t& first_set, 
-        const NonterminalMappings_t& nonterminal_mappings,
-        const size_t lookahead
-    );
     bool matches_lookahead(const std::vector<std::string>& token_names, const Lookahead_t& lookahead, const size_t curr_position);
     size_t get_current_state(const std::stack<std::pair<size_t, DebugParseTree>>& parse_stack);
     DebugParseTree reduce_production(const Production& to_reduce, std::stack<std::pair<size_t, DebugParseTree>>& parse_stack);
+    const Lookahead_t* get_action_lookahead(const Action& action);
+    Lookahead_t shorten_lookahead(const Lookahead_t& lookahead, const size_t depth);
+    Action shorten_action_lookahead(const Action& action, const size_t depth);
+    bool is_decided_at_depth(const ParserState& state, const size_t depth);
+    std::optional<ParserStateID_t> get_goto_target(const ParserState& state, const Symbol& reduced);
+    std::vector<bool> collect_reachable_states(const std::vector<ParserState>& states);
+    Action redirect_action(const Action& action, const std::vector<ParserStateID_t>& new_ids);
 
-    template<class T>
-    std::set<T> filter_set(const std::set<T>& to_filter, bool(*predicate)(const T&)) {
-        std::set<T> filtered;
-        std::copy_if(
-            to_filter.begin(), 
-            to_filter.end(), 
-            std::inserter(filtered, filtered.begin()), 
-            predicate
-        );
-        return filtered;
-    }
-
-    std::set<Production> filter_entry_productions(const std::set<Production>& productions) {
-        return filter_set<Production>(productions, [](const Production& candidate) -> bool { return candidate.is_entry(); });
-    }
-
-    std::set<ProductionState> filter_reduce_production_states(const std::set<ProductionState>& production_states) {
-        return filter_set<ProductionState>(
-            production_states, 
-            [](const ProductionState& candidate) -> bool {
-                return candidate.is_completed(); 
+    bool matches_lookahead(const std::vector<std::string>& token_names, const Lookahead_t& lookahead, const size_t curr_position) {
+        const size_t sequence_length = std::min(lookahead.size(), token_names.size() - curr_position);
+        for (size_t i = 0; i < sequence_length; i++) {
+            if (token_names[curr_position + i] != lookahead[i].identifier) {
+                return false;
             }
-        );
-    }
-
-    std::set<Symbol> get_next_symbols(const std::set<ProductionState>& production_states) {
-        std::set<Symbol> symbols;
-        for (const ProductionState& production_state : production_states) {
-            if (!production_state.is_completed()) {
-                symbols.insert(production_state.get_current_symbol().value());
+        }
+        for (size_t i = sequence_length; i < lookahead.size(); i++) { // all remaining tokens after input end have to be EOF
+            if (lookahead[i].identifier != "END_OF_FILE") {
+                return false;
             }
         }
-        return symbols;
+        return true;
     }
 
-    NonterminalMappings_t generate_nonterminal_mappings(const std::set<Production>& productions) {
-        NonterminalMappings_t nonterminal_mapping;
-        for (const Production& production : productions) {
-            nonterminal_mapping[production.name].insert(production);
-        }
-        return nonterminal_mapping;
+    size_t get_current_state(const std::stack<std::pair<size_t, DebugParseTree>>& parse_stack) {
+        return parse_stack.empty() ? 0 : parse_stack.top().first;
     }
 
-    ParserState create_entry_state(const std::set<Production>& productions, const size_t lookahead) {
-        const std::set<Production> entry_productions = filter_entry_productions(productions);
-        std::set<ProductionState> entry_production_states;
-        std::transform(
-            entry_productions.begin(), 
-            entry_productions.end(), 
-            std::inserter(entry_production_states, entry_production_states.begin()),
-            [=](const Production& production) -> ProductionState { 
-                return ProductionState(production, Lookahead_t(lookahead, Symbol{Symbol::SymbolType::TERMINAL, "END_OF_FILE"})); 
-            }
+    const Lookahead_t* get_action_lookahead(const Action& action) {
+        return std::visit(
+            Visitor{
+                [](const Action::GotoParameters& goto_action) -> const Lookahead_t* { return nullptr; },
+                [](const Action::ShiftParameters& shift_action) -> const Lookahead_t* { return &shift_action.lookahead; },
+                [](const Action::ReduceParameters& reduce_action) -> const Lookahead_t* { return &reduce_action.lookahead; }
+            },
+            action.parameters
         );
-        return ParserState(entry_production_states);
     }
 
-    ParserState expand_parser_state(
-        const ParserState& to_expand, 
-        const FirstSet_t& first_set, 
-        const NonterminalMappings_t& nonterminal_mappings,
-        const size_t lookahead
-    ) {
-        ParserState target{};
-        for (const ProductionState& production_state : to_expand.get_production_states()) {
-            expand_production_state(production_state, target, first_set, nonterminal_mappings, lookahead);
-        }
-        return target;
+    Lookahead_t shorten_lookahead(const Lookahead_t& lookahead, const size_t depth) {
+        return Lookahead_t(lookahead.begin(), lookahead.begin() + std::min(depth, lookahead.size()));
     }
 
-    void expand_production_state(
-        const ProductionState& to_expand, 
-        ParserState& target, 
-        const FirstSet_t& first_set, 
-        const NonterminalMappings_t& nonterminal_mappings,
-        const size_t lookahead
-    ) {
-        if (!target.add_production_state(to_expand)) {
-            return;
-        }
-        if (to_expand.is_completed() || to_expand.get_current_symbol().value().type == Symbol::SymbolType::TERMINAL) {
-            return;
-        }
-        const std::string nonterminal_name = to_expand.get_current_symbol().value().identifier;
-        assert(nonterminal_mappings.find(nonterminal_name) != nonterminal_mappings.end() && "BUG: nonterminal mappings are incomplete!");
-        const std::set<Lookahead_t> follow_set = follow_terminals(to_expand.get_current_symbol().value(), target, first_set, lookahead);
-        for (const Production& expansion : nonterminal_mappings.at(nonterminal_name)) {
-            for (const Lookahead_t& expansion_lookahead : follow_set) {
-                expand_production_state(ProductionState(expansion, expansion_lookahead), target, first_set, nonterminal_mappings, lookahead);  
-            }
-        }
+    Action shorten_action_lookahead(const Action& action, const size_t depth) {
+        const auto shorten = [&](const Lookahead_t& lookahead) -> Lookahead_t {
+            return shorten_lookahead(lookahead, depth);
+        };
+        return std::visit(
+            Visitor{
+                [](const Action::GotoParameters& goto_action) -> Action { return Action{goto_action}; },
+                [&](const Action::ShiftParameters& shift_action) -> Action { 
+                    return Action{Action::ShiftParameters{shift_action.next_state, shorten(shift_action.lookahead)}}; 
+                },
+                [&](const Action::ReduceParameters& reduce_action) -> Action { 
+                    return Action{Action::ReduceParameters{reduce_action.to_reduce, shorten(reduce_action.lookahead)}}; 
+                }
+            },
+            action.parameters
+        );
     }
 
-    bool matches_lookahead(const std::vector<std::string>& token_names, const Lookahead_t& lookahead, const size_t curr_position) {
-        const size_t sequence_length = std::min(lookahead.size(), token_names.size() - curr_position);
-        for (size_t i = 0; i < sequence_length; i++) {
-            if (token_names[curr_position + i] != lookahead[i].identifier) {
+    bool is_decided_at_depth(const ParserState& state, const size_t depth) {
+        // every prefix of the lookaheads has to lead to a single action, an error lookahead counts as an action of its own
+        std::map<Lookahead_t, std::optional<Action>> prefix_actions;
+        for (const Action& action : state.get_actions()) {
+            const Lookahead_t* lookahead = get_action_lookahead(action);
+            if (!lookahead || lookahead->empty()) {
+                continue;
+            }
+            const Action shortened_action = shorten_action_lookahead(action, depth);
+            const auto [prefix_action, inserted] = prefix_actions.insert(std::make_pair(*get_action_lookahead(shortened_action), shortened_action));
+            if (!inserted && prefix_action->second != shortened_action) {
                 return false;
             }
         }
-        for (size_t i = sequence_length; i < lookahead.size(); i++) { // all remaining tokens after input end have to be EOF
-            if (lookahead[i].identifier != "END_OF_FILE") {
+        for (const Lookahead_t& error_lookahead : state.get_error_lookaheads()) {
+            const auto [prefix_action, inserted] = prefix_actions.insert(std::make_pair(shorten_lookahead(error_lookahead, depth), std::nullopt));
+            if (!inserted && prefix_action->second.has_value()) {
                 return false;
             }
         }
         return true;
     }
 
-    size_t get_current_state(const std::stack<std::pair<size_t, DebugParseTree>>& parse_stack) {
-        return parse_stack.empty() ? 0 : parse_stack.top().first;
+    std::optional<ParserStateID_t> get_goto_target(const ParserState& state, const Symbol& reduced) {
+        for (const Action& action : state.get_actions()) {
+            if (std::holds_alternative<Action::GotoParameters>(action.parameters) && std::get<Action::GotoParameters>(action.parameters).reduced_symbol == reduced) {
+                return std::get<Action::GotoParameters>(action.parameters).next_state;
+            }
+        }
+        return std::nullopt;
+    }
+
+    std::vector<bool> collect_reachable_states(const std::vector<ParserState>& states) {
+        std::vector<bool> reachable(states.size(), false);
+        std::vector<ParserStateID_t> to_visit = {0};
+        reachable[0] = true;
+        while (!to_visit.empty()) {
+            const ParserStateID_t curr_state = to_visit.back();
+            to_visit.pop_back();
+            for (const Action& action : states[curr_state].get_actions()) {
+                const std::optional<ParserStateID_t> next_state = std::visit(
+                    Visitor{
+                        [](const Action::GotoParameters& goto_action) -> std::optional<ParserStateID_t> { return goto_action.next_state; },
+                        [](const Action::ShiftParameters& shift_action) -> std::optional<ParserStateID_t> { return shift_action.next_state; },
+                        [](const Action::ReduceParameters& reduce_action) -> std::optional<ParserStateID_t> { return std::nullopt; }
+                    },
+                    action.parameters
+                );
+                if (next_state.has_value() && !reachable[next_state.value()]) {
+                    reachable[next_state.value()] = true;
+                    to_visit.push_back(next_state.value());
+                }
+            }
+        }
+        return reachable;
+    }
+
+    Action redirect_action(const Action& action, const std::vector<ParserStateID_t>& new_ids) {
+        return std::visit(
+            Visitor{
+                [&](const Action::GotoParameters& goto_action) -> Action { 
+                    return Action{Action::GotoParameters{new_ids[goto_action.next_state], goto_action.reduced_symbol}}; 
+                },
+                [&](const Action::ShiftParameters& shift_action) -> Action { 
+                    return Action{Action::ShiftParameters{new_ids[shift_action.next_state], shift_action.lookahead}}; 
+                },
+                [](const Action::ReduceParameters& reduce_action) -> Action { return Action{reduce_action}; }
+            },
+            action.parameters
+        );
     }
 
     bool operator==(const DebugParseTree& first, const DebugParseTree& second) {
@@ -179,7 +183,8 @@ namespace parser_generator::shift_reduce_parsers {
         return DebugParseTree{to_reduce.name, sub_nodes};
     }
 
-    ParserTable::ParserTable(const ParserStateComparator_t& state_comparator) : state_comparator(state_comparator) {
+    ParserTable::ParserTable(const ParserStateComparator_t& state_comparator, const std::vector<ParserState>& states) 
+     : state_comparator(state_comparator), states(states) {
     }
 
     DebugParseTree ParserTable::debug_parse(const std::vector<std::string>& token_names) const {
@@ -225,122 +230,154 @@ namespace parser_generator::shift_reduce_parsers {
         return this->states;
     }
 
-    ParserTable::~ParserTable() {
-    }
-
-    ParserTable ParserTable::generate(const std::set<Production>& productions, const ParserStateComparator_t& state_comparator, const size_t lookahead) {
-        const FirstSet_t first_set = generate_first_set(productions, lookahead);
-        const NonterminalMappings_t nonterminal_mappings = generate_nonterminal_mappings(productions);
-        const ParserState entry_state = create_entry_state(productions, lookahead);
-        ParserTable parser_table(state_comparator);
-        parser_table.construct_state_from_core(entry_state, first_set, nonterminal_mappings, lookahead);
-        return parser_table;
-    }
-
-    std::optional<ParserStateID_t> ParserTable::try_get_matching_state_id(const ParserState& to_find) {
-        const auto state_ptr = std::find_if(
-            this->states.begin(), 
-            this->states.end(), 
-            std::bind(this->state_comparator, to_find, std::placeholders::_1)
-        );
-        if (state_ptr == this->states.end()) {
+    std::optional<Production> ParserTable::get_default_reduction(const ParserStateID_t state_id) const {
+        assert(state_id < this->states.size() && "BUG: Tried to access non-existent state!");
+        if (!this->states[state_id].get_error_lookaheads().empty()) { // the errors have to be detected before reducing
             return std::nullopt;
         }
-        const bool are_all_lookaheads_covered = std::includes(
-            state_ptr->get_production_states().begin(),
-            state_ptr->get_production_states().end(),
-            to_find.get_production_states().begin(),
-            to_find.get_production_states().end()
-        );
-        // if not all lookaheads are covered, we need to generate the actions for the production states to be added; therefore the states aren't matching
-        if (!are_all_lookaheads_covered) {
+        std::optional<Production> default_reduction = std::nullopt;
+        bool has_lookahead = false;
+        for (const Action& action : this->states[state_id].get_actions()) {
+            if (std::holds_alternative<Action::ShiftParameters>(action.parameters)) {
+                return std::nullopt;
+            }
+            if (!std::holds_alternative<Action::ReduceParameters>(action.parameters)) {
+                continue;
+            }
+            const Action::ReduceParameters& reduce_action = std::get<Action::ReduceParameters>(action.parameters);
+            if (default_reduction.has_value() && default_reduction.value() != reduce_action.to_reduce) {
+                return std::nullopt;
+            }
+            default_reduction = reduce_action.to_reduce;
+            has_lookahead |= !reduce_action.lookahead.empty();
+        }
+        // accepting has to check the lookahead, otherwise trailing input after the entry production would be ignored
+        if (default_reduction.has_value() && default_reduction.value().is_entry() && has_lookahead) {
             return std::nullopt;
         }
-        return std::optional<ParserStateID_t>{state_ptr - this->states.begin()};
+        return default_reduction;
     }
 
-    ParserStateID_t ParserTable::construct_state_from_core(
-        const ParserState& state_core, 
-        const FirstSet_t& first_set,
-        const NonterminalMappings_t& nonterminal_mappings,
-        const size_t lookahead
-    ) {
-        const ParserState expanded_state = expand_parser_state(state_core, first_set, nonterminal_mappings, lookahead);
-        std::optional<ParserStateID_t> exact_state_id = this->try_get_matching_state_id(expanded_state);
-        if (exact_state_id.has_value()) {
-            return exact_state_id.value();
+    size_t ParserTable::get_lookahead_depth(const ParserStateID_t state_id) const {
+        assert(state_id < this->states.size() && "BUG: Tried to access non-existent state!");
+        size_t depth = 0;
+        for (const Action& action : this->states[state_id].get_actions()) {
+            const Lookahead_t* lookahead = get_action_lookahead(action);
+            if (lookahead) {
+                depth = std::max(depth, lookahead->size());
+            }
         }
-        const ParserStateID_t state_id = this->insert_state(expanded_state);
-        this->generate_actions(state_id, first_set, nonterminal_mappings, lookahead);
-        return state_id;
+        for (const Lookahead_t& error_lookahead : this->states[state_id].get_error_lookaheads()) {
+            depth = std::max(depth, error_lookahead.size());
+        }
+        return depth;
     }
 
-    void ParserTable::generate_actions(
-        const ParserStateID_t target_state_id,
-        const FirstSet_t& first_set,
-        const NonterminalMappings_t& nonterminal_mappings,
-        const size_t lookahead
-    ) {
-        this->generate_reduce_actions(target_state_id);
-        this->generate_shift_actions(target_state_id, first_set, nonterminal_mappings, lookahead);
-        this->generate_goto_actions(target_state_id, first_set, nonterminal_mappings, lookahead);
+    size_t ParserTable::get_max_lookahead_depth() const {
+        size_t max_depth = 0;
+        for (ParserStateID_t state_id = 0; state_id < this->states.size(); state_id++) {
+            max_depth = std::max(max_depth, this->get_lookahead_depth(state_id));
+        }
+        return max_depth;
     }
 
-    void ParserTable::generate_shift_actions(
-        const ParserStateID_t target_state_id,
-        const FirstSet_t& first_set,
-        const NonterminalMappings_t& nonterminal_mappings,
-        const size_t lookahead
-    ) {
-        for (const Symbol& next_symbol : get_next_symbols(this->states[target_state_id].get_production_states())) {
-            if (next_symbol.type != Symbol::SymbolType::TERMINAL) {
-                continue;
+    ParserTable ParserTable::with_minimal_lookaheads() const {
+        // Only the action gets chosen earlier, the stack stays a viable prefix. Therefore a syntax error may merely be reported later.
+        std::vector<ParserState> shortened_states;
+        for (ParserStateID_t state_id = 0; state_id < this->states.size(); state_id++) {
+            size_t depth = std::min((size_t)1, this->get_lookahead_depth(state_id));
+            while (depth < this->get_lookahead_depth(state_id) && !is_decided_at_depth(this->states[state_id], depth)) {
+                depth++;
+            }
+            shortened_states.emplace_back(this->states[state_id].get_production_states());
+            for (const Action& action : this->states[state_id].get_actions()) {
+                shortened_states.back().add_action(shorten_action_lookahead(action, depth));
             }
-            const ParserState shift_state_core = this->states[target_state_id].advance_by(next_symbol);
-            const ParserStateID_t shift_state_id = this->construct_state_from_core(shift_state_core, first_set, nonterminal_mappings, lookahead);
-            for (Lookahead_t lookahead : follow_terminals(next_symbol, this->states[target_state_id], first_set, std::max((size_t)1, lookahead) - 1)) {
-                lookahead.insert(lookahead.begin(), next_symbol);
-                this->states[target_state_id].add_action(Action{Action::ShiftParameters{shift_state_id, lookahead}});
+            for (const Lookahead_t& error_lookahead : this->states[state_id].get_error_lookaheads()) {
+                shortened_states.back().add_error_lookahead(shorten_lookahead(error_lookahead, depth));
             }
         }
+        return ParserTable(this->state_comparator, shortened_states);
     }
 
-    void ParserTable::generate_reduce_actions(
-        const ParserStateID_t target_state_id
-    ) {
-        for (const ProductionState& to_reduce : filter_reduce_production_states(this->states[target_state_id].get_production_states())) {
-            this->states[target_state_id].add_action(Action{Action::ReduceParameters{to_reduce.get_production(), to_reduce.get_lookahead()}});
+    ParserTable ParserTable::with_bypassed_unit_reductions() const {
+        // A state that only reduces the transparent production A -> B pops B and then takes the goto on A of the state below.
+        // The goto on B can therefore lead there directly, the stack entry of B just stands in for A.
+        std::vector<ParserState> redirected_states;
+        bool redirected = false;
+        for (const ParserState& state : this->states) {
+            redirected_states.emplace_back(state.get_production_states());
+            for (const Lookahead_t& error_lookahead : state.get_error_lookaheads()) {
+                redirected_states.back().add_error_lookahead(error_lookahead);
+            }
+            for (const Action& action : state.get_actions()) {
+                if (!std::holds_alternative<Action::GotoParameters>(action.parameters)) {
+                    redirected_states.back().add_action(action);
+                    continue;
+                }
+                Action::GotoParameters goto_action = std::get<Action::GotoParameters>(action.parameters);
+                for (size_t chain_length = 0; chain_length < this->states.size(); chain_length++) { // bounds cyclic unit chains
+                    const std::optional<Production> default_reduction = this->get_default_reduction(goto_action.next_state);
+                    if (!default_reduction.has_value() || !default_reduction.value().transparent || default_reduction.value().is_entry()) {
+                        break;
+                    }
+                    const std::optional<ParserStateID_t> next_state = get_goto_target(state, Symbol{Symbol::SymbolType::NONTERMINAL, default_reduction.value().name});
+                    if (!next_state.has_value()) {
+                        break;
+                    }
+                    goto_action.next_state = next_state.value();
+                    redirected = true;
+                }
+                redirected_states.back().add_action(Action{goto_action});
+            }
+        }
+        if (!redirected) {
+            return *this;
         }
-    }
 
-    void ParserTable::generate_goto_actions(
-        const ParserStateID_t target_state_id,
-        const FirstSet_t& first_set,
-        const NonterminalMappings_t& nonterminal_mappings,
-        const size_t lookahead
-    ) {
-        for (const Symbol& next_symbol : get_next_symbols(this->states[target_state_id].get_production_states())) {
-            if (next_symbol.type != Symbol::SymbolType::NONTERMINAL) {
+        const std::vector<bool> reachable = collect_reachable_states(redirected_states);
+        std::vector<ParserStateID_t> new_ids(redirected_states.size(), 0);
+        ParserStateID_t next_id = 0;
+        for (ParserStateID_t state_id = 0; state_id < redirected_states.size(); state_id++) {
+            new_ids[state_id] = reachable[state_id] ? next_id++ : 0;
+        }
+        std::vector<ParserState> remaining_states;
+        for (ParserStateID_t state_id = 0; state_id < redirected_states.size(); state_id++) {
+            if (!reachable[state_id]) {
                 continue;
             }
-            const ParserState goto_state_core = this->states[target_state_id].advance_by(next_symbol);
-            const ParserStateID_t goto_state_id = this->construct_state_from_core(goto_state_core, first_set, nonterminal_mappings, lookahead);
-            this->states[target_state_id].add_action(Action{Action::GotoParameters{goto_state_id, next_symbol}});
+            remaining_states.emplace_back(redirected_states[state_id].get_production_states());
+            for (const Lookahead_t& error_lookahead : redirected_states[state_id].get_error_lookaheads()) {
+                remaining_states.back().add_error_lookahead(error_lookahead);
+            }
+            for (const Action& action : redirected_states[state_id].get_actions()) {
+                remaining_states.back().add_action(redirect_action(action, new_ids));
+            }
         }
+        return ParserTable(this->state_comparator, remaining_states);
     }
-    
-    ParserStateID_t ParserTable::insert_state(const ParserState& to_insert) {
-        auto mergeable_state_ptr = std::find_if(
-            this->states.begin(), 
-            this->states.end(), 
-            std::bind(this->state_comparator, to_insert, std::placeholders::_1)
-        );
-        if (mergeable_state_ptr != this->states.end()) {
-            mergeable_state_ptr->merge(to_insert);
-            return mergeable_state_ptr - this->states.begin();
-        }
-        this->states.push_back(to_insert);
-        return this->states.size() - 1;
+
+    ParserTable::~ParserTable() {
+    }
+
+    ParserTable ParserTable::generate(
+        const std::set<Production>& productions, 
+        const ParserStateComparator_t& state_comparator, 
+        const size_t lookahead,
+        const ParserStateHash_t& state_hash,
+        const size_t thread_count,
+        const PrecedenceTable_t& precedence_table
+    ) {
+        ParserTableBuilder builder(productions, state_comparator, state_hash, lookahead, tpool::resolve_thread_count(thread_count), precedence_table);
+        return ParserTable(state_comparator, builder.build()).with_bypassed_unit_reductions();
+    }
+
+    ParserTable ParserTable::generate_lalr_1(
+        const std::set<Production>& productions, 
+        const ParserStateComparator_t& state_comparator,
+        const PrecedenceTable_t& precedence_table
+    ) {
+        return ParserTable(state_comparator, generate_lalr_1_states(productions, precedence_table)).with_bypassed_unit_reductions();
     }
 
     const Action& ParserTable::debug_next_action(const std::vector<std::string>& token_names, const size_t curr_state, const size_t curr_position) const {
@@ -12,8 +12,6 @@
 #include "state_lookahead.h"
 
 namespace parser_generator::shift_reduce_parsers {    
-    using NonterminalMappings_t = std::map<std::string, std::set<Production>>;
-
     struct DebugParseTree {
         std::string identifier;
         std::vector<DebugParseTree> sub_nodes;
@@ -23,45 +21,37 @@ namespace parser_generator::shift_reduce_parsers {
 
     class ParserTable {
         public:
-            ParserTable(const ParserStateComparator_t& state_comparator);
+            ParserTable(const ParserStateComparator_t& state_comparator, const std::vector<ParserState>& states);
             DebugParseTree debug_parse(const std::vector<std::string>& token_names) const;
             const std::vector<ParserState>& get_states() const;
+            // the production a state reduces without inspecting the lookahead (the state has no shifts and reduces only this production)
+            std::optional<Production> get_default_reduction(const ParserStateID_t state_id) const;
+            size_t get_lookahead_depth(const ParserStateID_t state_id) const; // the longest lookahead an action of the state tests
+            size_t get_max_lookahead_depth() const;
+            // shortens the lookaheads of each state to the fewest tokens that still decide its actions
+            ParserTable with_minimal_lookaheads() const;
+            // lets gotos skip the states that only reduce a transparent production and drops the states that become unreachable
+            ParserTable with_bypassed_unit_reductions() const;
             ~ParserTable();
 
-            static ParserTable generate(const std::set<Production>& productions, const ParserStateComparator_t& state_comparator, const size_t lookahead);
+            static ParserTable generate(
+                const std::set<Production>& productions, 
+                const ParserStateComparator_t& state_comparator, 
+                const size_t lookahead,
+                const ParserStateHash_t& state_hash = lalr_state_hash,
+                const size_t thread_count = 1, // 0 uses one thread per hardware thread, the generated table is the same for every count
+                const PrecedenceTable_t& precedence_table = {}
+            );
+            // same result as generate with lalr_state_compare and a lookahead of 1, but without building the canonical LR(1) states first
+            static ParserTable generate_lalr_1(
+                const std::set<Production>& productions, 
+                const ParserStateComparator_t& state_comparator,
+                const PrecedenceTable_t& precedence_table = {}
+            );
         private:
             const ParserStateComparator_t& state_comparator;
             std::vector<ParserState> states;
 
-            std::optional<ParserStateID_t> try_get_matching_state_id(const ParserState& to_find);
-            ParserStateID_t construct_state_from_core(
-                const ParserState& state_core, 
-                const FirstSet_t& first_set,
-                const NonterminalMappings_t& nonterminal_mappings,
-                const size_t lookahead
-            );
-            void generate_actions(
-                const ParserStateID_t target_state_id,
-                const FirstSet_t& first_set,
-                const NonterminalMappings_t& nonterminal_mappings,
-                const size_t lookahead
-            );
-            void generate_shift_actions(
-                const ParserStateID_t target_state_id,
-                const FirstSet_t& first_set,
-                const NonterminalMappings_t& nonterminal_mappings,
-                const size_t lookahead
-            );
-            void generate_reduce_actions(
-                const ParserStateID_t target_state_id
-            );
-            void generate_goto_actions(
-                const ParserStateID_t target_state_id,
-                const FirstSet_t& first_set,
-                const NonterminalMappings_t& nonterminal_mappings,
-                const size_t lookahead
-            );
-            ParserStateID_t insert_state(const ParserState& to_insert);
             const Action& debug_next_action(const std::vector<std::string>& token_names, const size_t curr_state, const size_t curr_position) const;
             size_t debug_goto(const size_t curr_state, const std::string& reduced) const;
 
@@ -0,0 +1,195 @@
+#include "parser_table_serialization.h"
+
+#include <map>
+#include <vector>
+#include <stdexcept>
+
+#include "util/binary_cache.h"
+#include "util/Visitor.h"
+
+namespace parser_generator::shift_reduce_parsers {
+    enum class ActionType {
+        GOTO,
+        SHIFT,
+        REDUCE
+    };
+
+    // helper functions
+    void write_symbol(std::ostream& output, const Symbol& to_write);
+    Symbol read_symbol(std::istream& input);
+    void write_lookahead(std::ostream& output, const Lookahead_t& to_write);
+    Lookahead_t read_lookahead(std::istream& input);
+    std::map<Production, size_t> collect_production_ids(const ParserTable& parser_table);
+    const Production& get_production(const std::vector<Production>& productions, const uint64_t production_id);
+
+    void write_symbol(std::ostream& output, const Symbol& to_write) {
+        bcache::write_uint(output, (uint64_t)to_write.type);
+        bcache::write_string(output, to_write.identifier);
+    }
+
+    Symbol read_symbol(std::istream& input) {
+        const uint64_t type = bcache::read_uint(input);
+        if (type > (uint64_t)Symbol::SymbolType::NONTERMINAL) {
+            throw std::runtime_error("Invalid symbol type in cache entry!");
+        }
+        return Symbol{(Symbol::SymbolType)type, bcache::read_string(input)};
+    }
+
+    void write_lookahead(std::ostream& output, const Lookahead_t& to_write) {
+        bcache::write_uint(output, to_write.size());
+        for (const Symbol& symbol : to_write) {
+            write_symbol(output, symbol);
+        }
+    }
+
+    Lookahead_t read_lookahead(std::istream& input) {
+        Lookahead_t lookahead;
+        const uint64_t symbol_count = bcache::read_uint(input);
+        for (uint64_t i = 0; i < symbol_count; i++) {
+            lookahead.push_back(read_symbol(input));
+        }
+        return lookahead;
+    }
+
+    std::map<Production, size_t> collect_production_ids(const ParserTable& parser_table) {
+        std::map<Production, size_t> production_ids;
+        for (const ParserState& state : parser_table.get_states()) {
+            for (const ProductionState& production_state : state.get_production_states()) {
+                production_ids.insert(std::make_pair(production_state.get_production(), production_ids.size()));
+            }
+            for (const Action& action : state.get_actions()) {
+                if (std::holds_alternative<Action::ReduceParameters>(action.parameters)) {
+                    const Production& to_reduce = std::get<Action::ReduceParameters>(action.parameters).to_reduce;
+                    production_ids.insert(std::make_pair(to_reduce, production_ids.size()));
+                }
+            }
+        }
+        return production_ids;
+    }
+
+    const Production& get_production(const std::vector<Production>& productions, const uint64_t production_id) {
+        if (production_id >= productions.size()) {
+            throw std::runtime_error("Invalid production id in cache entry!");
+        }
+        return productions[production_id];
+    }
+
+    void write_production(std::ostream& output, const Production& to_write) {
+        bcache::write_string(output, to_write.name);
+        bcache::write_string(output, to_write.tag);
+        bcache::write_uint(output, to_write.transparent);
+        bcache::write_uint(output, to_write.symbols.size());
+        for (const Symbol& symbol : to_write.symbols) {
+            write_symbol(output, symbol);
+        }
+    }
+
+    Production read_production(std::istream& input) {
+        Production production{bcache::read_string(input), {}, bcache::read_string(input)};
+        production.transparent = bcache::read_uint(input) != 0;
+        const uint64_t symbol_count = bcache::read_uint(input);
+        for (uint64_t i = 0; i < symbol_count; i++) {
+            production.symbols.push_back(read_symbol(input));
+        }
+        return production;
+    }
+
+    void write_parser_table(std::ostream& output, const ParserTable& to_write) {
+        const std::map<Production, size_t> production_ids = collect_production_ids(to_write);
+        std::vector<const Production*> productions(production_ids.size(), nullptr);
+        for (const auto& [production, id] : production_ids) {
+            productions[id] = &production;
+        }
+
+        bcache::write_uint(output, productions.size());
+        for (const Production* const production : productions) {
+            write_production(output, *production);
+        }
+
+        bcache::write_uint(output, to_write.get_states().size());
+        for (const ParserState& state : to_write.get_states()) {
+            bcache::write_uint(output, state.get_production_states().size());
+            for (const ProductionState& production_state : state.get_production_states()) {
+                bcache::write_uint(output, production_ids.at(production_state.get_production()));
+                bcache::write_uint(output, production_state.get_position());
+                write_lookahead(output, production_state.get_lookahead());
+            }
+
+            bcache::write_uint(output, state.get_actions().size());
+            for (const Action& action : state.get_actions()) {
+                std::visit(
+                    Visitor{
+                        [&](const Action::GotoParameters& goto_action) {
+                            bcache::write_uint(output, (uint64_t)ActionType::GOTO);
+                            bcache::write_uint(output, goto_action.next_state);
+                            write_symbol(output, goto_action.reduced_symbol);
+                        },
+                        [&](const Action::ShiftParameters& shift_action) {
+                            bcache::write_uint(output, (uint64_t)ActionType::SHIFT);
+                            bcache::write_uint(output, shift_action.next_state);
+                            write_lookahead(output, shift_action.lookahead);
+                        },
+                        [&](const Action::ReduceParameters& reduce_action) {
+                            bcache::write_uint(output, (uint64_t)ActionType::REDUCE);
+                            bcache::write_uint(output, production_ids.at(reduce_action.to_reduce));
+                            write_lookahead(output, reduce_action.lookahead);
+                        }
+                    },
+                    action.parameters
+                );
+            }
+
+            bcache::write_uint(output, state.get_error_lookaheads().size());
+            for (const Lookahead_t& error_lookahead : state.get_error_lookaheads()) {
+                write_lookahead(output, error_lookahead);
+            }
+        }
+    }
+
+    ParserTable read_parser_table(std::istream& input, const ParserStateComparator_t& state_comparator) {
+        std::vector<Production> productions;
+        const uint64_t production_count = bcache::read_uint(input);
+        for (uint64_t i = 0; i < production_count; i++) {
+            productions.push_back(read_production(input));
+        }
+
+        std::vector<ParserState> states;
+        const uint64_t state_count = bcache::read_uint(input);
+        for (uint64_t state_id = 0; state_id < state_count; state_id++) {
+            std::set<ProductionState> production_states;
+            const uint64_t production_state_count = bcache::read_uint(input);
+            for (uint64_t i = 0; i < production_state_count; i++) {
+                const Production& production = get_production(productions, bcache::read_uint(input));
+                const uint64_t position = bcache::read_uint(input);
+                production_states.insert(ProductionState(production, position, read_lookahead(input)));
+            }
+            ParserState state(production_states);
+
+            const uint64_t action_count = bcache::read_uint(input);
+            for (uint64_t i = 0; i < action_count; i++) {
+                const uint64_t action_type = bcache::read_uint(input);
+                const uint64_t action_target = bcache::read_uint(input);
+                if (action_type != (uint64_t)ActionType::REDUCE && action_target >= state_count) {
+                    throw std::runtime_error("Invalid state id in cache entry!");
+                }
+                if (action_type == (uint64_t)ActionType::GOTO) {
+                    state.add_action(Action{Action::GotoParameters{action_target, read_symbol(input)}});
+                } else if (action_type == (uint64_t)ActionType::SHIFT) {
+                    state.add_action(Action{Action::ShiftParameters{action_target, read_lookahead(input)}});
+                } else if (action_type == (uint64_t)ActionType::REDUCE) {
+                    state.add_action(Action{Action::ReduceParameters{get_production(productions, action_target), read_lookahead(input)}});
+                } else {
+                    throw std::runtime_error("Invalid action type in cache entry!");
+                }
+            }
+
+            const uint64_t error_lookahead_count = bcache::read_uint(input);
+            for (uint64_t i = 0; i < error_lookahead_count; i++) {
+                state.add_error_lookahead(read_lookahead(input));
+            }
+            states.push_back(state);
+        }
+
+        return ParserTable(state_comparator, states);
+    }
+}
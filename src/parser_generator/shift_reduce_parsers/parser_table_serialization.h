@@ -0,0 +1,17 @@
+#pragma once
+
+#include <istream>
+#include <ostream>
+
+#include "parser_generator/production_definition.h"
+
+#include "parser_table_generation.h"
+#include "parser_state_comparators.h"
+
+namespace parser_generator::shift_reduce_parsers {
+    // compact binary format used by the generation cache
+    void write_production(std::ostream& output, const Production& to_write);
+    Production read_production(std::istream& input);
+    void write_parser_table(std::ostream& output, const ParserTable& to_write);
+    ParserTable read_parser_table(std::istream& input, const ParserStateComparator_t& state_comparator);
+}
@@ -10,32 +10,88 @@
 #include "parser_state_comparators.h"
 
 namespace parser_generator::shift_reduce_parsers {
+    struct ProductionFirstTerminals {
+        TerminalSet_t first_terminals;
+        bool nullable;
+    };
+
     // helper functions
-    FirstSet_t generate_incomplete_first_set(const std::set<Production>& productions, const size_t lookahead, const FirstSet_t& previous_iter = {});
+    IndexedFirstSet_t generate_incomplete_first_set(const SymbolTable& symbol_table, const size_t lookahead, const IndexedFirstSet_t& previous_iter);
+    std::optional<std::set<IndexedLookahead_t>> try_get_terminals(
+        const SymbolTable& symbol_table,
+        const ProductionID_t production_id,
+        const size_t position,
+        const size_t lookahead,
+        const IndexedFirstSet_t& previous_iter
+    );
     std::optional<std::set<Lookahead_t>> try_get_terminals(
-        const ProductionState& production_state, 
-        const size_t lookahead, 
+        const ProductionState& production_state,
+        const size_t lookahead,
         const FirstSet_t& previous_iter
     );
     std::optional<std::set<Lookahead_t>> try_get_symbol_terminals(const ProductionState& production_state, const FirstSet_t& previous_iter);
-    bool is_first_set_valid(const FirstSet_t& to_validate, const std::set<Production>& used_productions);
-    std::set<Lookahead_t> combinations(const std::set<Lookahead_t>& base, const std::set<Lookahead_t>& to_append);
-    std::set<Lookahead_t> truncate(const std::set<Lookahead_t>& to_truncate, const size_t max_length);
+    bool is_first_set_valid(const IndexedFirstSet_t& to_validate, const SymbolTable& symbol_table);
+    std::optional<ProductionFirstTerminals> try_get_production_first_terminals(
+        const SymbolTable& symbol_table,
+        const ProductionID_t production_id,
+        const std::vector<bool>& completed_nonterminals,
+        const TerminalFirstSet& first_set
+    );
+    template<class Symbol_t>
+    std::set<std::vector<Symbol_t>> combinations(const std::set<std::vector<Symbol_t>>& base, const std::set<std::vector<Symbol_t>>& to_append);
+    template<class Symbol_t>
+    std::set<std::vector<Symbol_t>> truncate(const std::set<std::vector<Symbol_t>>& to_truncate, const size_t max_length);
 
-    FirstSet_t generate_incomplete_first_set(const std::set<Production>& productions, const size_t lookahead, const FirstSet_t& previous_iter) {
-        FirstSet_t first_set;
-        for (const Production& production : productions) {
-            std::optional<std::set<Lookahead_t>> production_first_terminals = try_get_terminals(ProductionState(production), lookahead, previous_iter);
-            if (production_first_terminals.has_value()) {
-                first_set[production.name].insert(production_first_terminals.value().begin(), production_first_terminals.value().end());
+    IndexedFirstSet_t generate_incomplete_first_set(const SymbolTable& symbol_table, const size_t lookahead, const IndexedFirstSet_t& previous_iter) {
+        IndexedFirstSet_t first_set(symbol_table.get_symbol_count());
+        for (ProductionID_t production_id = 0; production_id < symbol_table.get_production_count(); production_id++) {
+            std::optional<std::set<IndexedLookahead_t>> production_first_terminals = try_get_terminals(symbol_table, production_id, 0, lookahead, previous_iter);
+            if (!production_first_terminals.has_value()) {
+                continue;
             }
+            std::optional<std::set<IndexedLookahead_t>>& nonterminal_first_terminals = first_set[symbol_table.get_production_name(production_id)];
+            if (!nonterminal_first_terminals.has_value()) {
+                nonterminal_first_terminals = std::set<IndexedLookahead_t>{};
+            }
+            nonterminal_first_terminals.value().insert(production_first_terminals.value().begin(), production_first_terminals.value().end());
         }
         return first_set;
     }
 
+    std::optional<std::set<IndexedLookahead_t>> try_get_terminals(
+        const SymbolTable& symbol_table,
+        const ProductionID_t production_id,
+        const size_t position,
+        const size_t lookahead,
+        const IndexedFirstSet_t& previous_iter
+    ) {
+        const std::vector<SymbolID_t>& symbols = symbol_table.get_production_symbols(production_id);
+        if (lookahead == 0 || position == symbols.size()) {
+            return std::set<IndexedLookahead_t>{IndexedLookahead_t{}};
+        }
+        const std::optional<std::set<IndexedLookahead_t>> symbol_first_terminals = symbol_table.is_terminal(symbols[position])
+            ? std::set<IndexedLookahead_t>{IndexedLookahead_t{symbols[position]}}
+            : previous_iter[symbols[position]]; // a missing value means that this first-set can't be completed yet in this iteration
+        if (!symbol_first_terminals.has_value()) {
+            return std::nullopt;
+        }
+        size_t min_consumed = std::min_element(symbol_first_terminals.value().begin(), symbol_first_terminals.value().end())->size();
+        std::optional<std::set<IndexedLookahead_t>> sub_first_terminals = try_get_terminals(
+            symbol_table,
+            production_id,
+            position + 1,
+            lookahead - min_consumed,
+            previous_iter
+        );
+        if (!sub_first_terminals.has_value()) {
+            return std::nullopt;
+        }
+        return truncate(combinations(symbol_first_terminals.value(), sub_first_terminals.value()), lookahead);
+    }
+
     std::optional<std::set<Lookahead_t>> try_get_terminals(
-        const ProductionState& production_state, 
-        const size_t lookahead, 
+        const ProductionState& production_state,
+        const size_t lookahead,
         const FirstSet_t& previous_iter
     ) {
         if (lookahead == 0 || production_state.is_completed()) {
@@ -46,7 +102,7 @@ namespace parser_generator::shift_reduce_parsers {
             return std::nullopt;
         }
         size_t min_consumed = std::min_element(symbol_first_terminals.value().begin(), symbol_first_terminals.value().end())->size();
-        std::optional<std::set<Lookahead_t>> sub_first_terminals = try_get_terminals(production_state.advance(), lookahead - min_consumed, previous_iter);  
+        std::optional<std::set<Lookahead_t>> sub_first_terminals = try_get_terminals(production_state.advance(), lookahead - min_consumed, previous_iter);
         if (!sub_first_terminals.has_value()) {
             return std::nullopt;
         }
@@ -66,20 +122,41 @@ namespace parser_generator::shift_reduce_parsers {
         return previous_iter.at(non_terminal_name);
     }
 
-    bool is_first_set_valid(const FirstSet_t& to_validate, const std::set<Production>& used_productions) {
-        for (const Production& production : used_productions) {
-            if (to_validate.find(production.name) == to_validate.end()) {
+    bool is_first_set_valid(const IndexedFirstSet_t& to_validate, const SymbolTable& symbol_table) {
+        for (ProductionID_t production_id = 0; production_id < symbol_table.get_production_count(); production_id++) {
+            if (!to_validate[symbol_table.get_production_name(production_id)].has_value()) {
                 return false;
             }
         }
         return true;
     }
 
-    std::set<Lookahead_t> combinations(const std::set<Lookahead_t>& base, const std::set<Lookahead_t>& to_append) {
-        std::set<Lookahead_t> all_combinations;
-        for (const Lookahead_t& base_part : base) {
-            for (const Lookahead_t& append_part : to_append) {
-                Lookahead_t combination = base_part;
+    std::optional<ProductionFirstTerminals> try_get_production_first_terminals(
+        const SymbolTable& symbol_table,
+        const ProductionID_t production_id,
+        const std::vector<bool>& completed_nonterminals,
+        const TerminalFirstSet& first_set
+    ) {
+        ProductionFirstTerminals production_first_terminals{create_terminal_set(symbol_table.get_terminal_count()), true};
+        for (const SymbolID_t symbol : symbol_table.get_production_symbols(production_id)) {
+            if (!symbol_table.is_terminal(symbol) && !completed_nonterminals[symbol]) {
+                return std::nullopt; // like in the general case, the production can't contribute before all symbols up to its first non-nullable one can
+            }
+            unite_terminal_sets(production_first_terminals.first_terminals, first_set.first_terminals[symbol]);
+            if (!first_set.nullable[symbol]) {
+                production_first_terminals.nullable = false;
+                break;
+            }
+        }
+        return production_first_terminals;
+    }
+
+    template<class Symbol_t>
+    std::set<std::vector<Symbol_t>> combinations(const std::set<std::vector<Symbol_t>>& base, const std::set<std::vector<Symbol_t>>& to_append) {
+        std::set<std::vector<Symbol_t>> all_combinations;
+        for (const std::vector<Symbol_t>& base_part : base) {
+            for (const std::vector<Symbol_t>& append_part : to_append) {
+                std::vector<Symbol_t> combination = base_part;
                 combination.insert(combination.end(), append_part.begin(), append_part.end());
                 all_combinations.insert(combination);
             }
@@ -87,15 +164,16 @@ namespace parser_generator::shift_reduce_parsers {
         return all_combinations;
     }
 
-    std::set<Lookahead_t> truncate(const std::set<Lookahead_t>& to_truncate, const size_t max_length) {
-        std::set<Lookahead_t> truncated;
+    template<class Symbol_t>
+    std::set<std::vector<Symbol_t>> truncate(const std::set<std::vector<Symbol_t>>& to_truncate, const size_t max_length) {
+        std::set<std::vector<Symbol_t>> truncated;
         std::transform(
-            to_truncate.begin(), 
-            to_truncate.end(), 
-            std::inserter(truncated, truncated.begin()), 
-            [&](const Lookahead_t& to_truncate) -> Lookahead_t {
+            to_truncate.begin(),
+            to_truncate.end(),
+            std::inserter(truncated, truncated.begin()),
+            [&](const std::vector<Symbol_t>& to_truncate) -> std::vector<Symbol_t> {
                 if (to_truncate.size() > max_length) {
-                    return Lookahead_t(to_truncate.begin(), to_truncate.begin() + (ssize_t)max_length);
+                    return std::vector<Symbol_t>(to_truncate.begin(), to_truncate.begin() + (ssize_t)max_length);
                 }
                 return to_truncate;
             }
@@ -104,20 +182,93 @@ namespace parser_generator::shift_reduce_parsers {
     }
 
     FirstSet_t generate_first_set(const std::set<Production>& productions, const size_t lookahead) {
-        FirstSet_t first_set = generate_incomplete_first_set(productions, lookahead);
+        const SymbolTable symbol_table(productions);
+        const IndexedFirstSet_t indexed_first_set = generate_indexed_first_set(symbol_table, lookahead);
+        FirstSet_t first_set;
+        for (ProductionID_t production_id = 0; production_id < symbol_table.get_production_count(); production_id++) {
+            std::set<Lookahead_t>& nonterminal_first_terminals = first_set[symbol_table.get_production(production_id).name];
+            for (const IndexedLookahead_t& first_terminals : indexed_first_set[symbol_table.get_production_name(production_id)].value()) {
+                nonterminal_first_terminals.insert(to_lookahead(first_terminals, symbol_table));
+            }
+        }
+        return first_set;
+    }
+
+    IndexedFirstSet_t generate_indexed_first_set(const SymbolTable& symbol_table, const size_t lookahead) {
+        // nonterminals without value still miss information in the current iteration
+        IndexedFirstSet_t first_set = generate_incomplete_first_set(symbol_table, lookahead, IndexedFirstSet_t(symbol_table.get_symbol_count()));
         while (true) {
-            FirstSet_t next_iter = generate_incomplete_first_set(productions, lookahead, first_set);
+            IndexedFirstSet_t next_iter = generate_incomplete_first_set(symbol_table, lookahead, first_set);
             if (next_iter == first_set) {
                 break;
             }
             first_set = next_iter;
         }
-        if (!is_first_set_valid(first_set, productions)) {
+        if (!is_first_set_valid(first_set, symbol_table)) {
             throw palex_except::ValidationError("Unable to create first set of productions as some of them recurse infinitely!");
         }
         return first_set;
     }
 
+    TerminalFirstSet generate_terminal_first_set(const SymbolTable& symbol_table) {
+        TerminalFirstSet first_set{
+            std::vector<TerminalSet_t>(symbol_table.get_symbol_count(), create_terminal_set(symbol_table.get_terminal_count())),
+            std::vector<bool>(symbol_table.get_symbol_count(), false)
+        };
+        for (SymbolID_t terminal = 0; terminal < symbol_table.get_terminal_count(); terminal++) {
+            insert_terminal(first_set.first_terminals[terminal], terminal);
+        }
+        std::vector<std::vector<ProductionID_t>> dependent_productions(symbol_table.get_symbol_count()); // nonterminal id -> productions using it
+        for (ProductionID_t production_id = 0; production_id < symbol_table.get_production_count(); production_id++) {
+            for (const SymbolID_t symbol : symbol_table.get_production_symbols(production_id)) {
+                if (!symbol_table.is_terminal(symbol)) {
+                    dependent_productions[symbol].push_back(production_id);
+                }
+            }
+        }
+
+        // only the productions using a changed nonterminal have to be visited again
+        std::vector<bool> completed_nonterminals(symbol_table.get_symbol_count(), false);
+        std::vector<ProductionID_t> unprocessed_productions;
+        for (ProductionID_t production_id = symbol_table.get_production_count(); production_id > 0; production_id--) {
+            unprocessed_productions.push_back(production_id - 1);
+        }
+        while (!unprocessed_productions.empty()) {
+            const ProductionID_t production_id = unprocessed_productions.back();
+            unprocessed_productions.pop_back();
+            const std::optional<ProductionFirstTerminals> production_first_terminals = try_get_production_first_terminals(
+                symbol_table,
+                production_id,
+                completed_nonterminals,
+                first_set
+            );
+            if (!production_first_terminals.has_value()) {
+                continue;
+            }
+            const SymbolID_t production_name = symbol_table.get_production_name(production_id);
+            bool changed = !completed_nonterminals[production_name];
+            completed_nonterminals[production_name] = true;
+            changed |= unite_terminal_sets(first_set.first_terminals[production_name], production_first_terminals.value().first_terminals);
+            if (production_first_terminals.value().nullable && !first_set.nullable[production_name]) {
+                first_set.nullable[production_name] = true;
+                changed = true;
+            }
+            if (changed) {
+                unprocessed_productions.insert(
+                    unprocessed_productions.end(),
+                    dependent_productions[production_name].begin(),
+                    dependent_productions[production_name].end()
+                );
+            }
+        }
+        for (ProductionID_t production_id = 0; production_id < symbol_table.get_production_count(); production_id++) {
+            if (!completed_nonterminals[symbol_table.get_production_name(production_id)]) {
+                throw palex_except::ValidationError("Unable to create first set of productions as some of them recurse infinitely!");
+            }
+        }
+        return first_set;
+    }
+
     std::set<Lookahead_t> follow_terminals(const Symbol& to_check, const ParserState& current_state, const FirstSet_t& first_set, const size_t lookahead) {
         std::set<Lookahead_t> follow_terminals_set;
         for (const ProductionState& production_state : current_state.get_production_states()) {
@@ -125,16 +276,58 @@ namespace parser_generator::shift_reduce_parsers {
                 std::optional<std::set<Lookahead_t>> production_follow_terminals = try_get_terminals(production_state.advance(), lookahead, first_set);
                 assert(production_follow_terminals.has_value() && "BUG: 'follow_tokens' got used with invalid first set!");
                 std::set<Lookahead_t> expanded_follow_terminals = truncate(
-                    combinations(production_follow_terminals.value(), std::set<Lookahead_t>{production_state.get_lookahead()}), 
+                    combinations(production_follow_terminals.value(), std::set<Lookahead_t>{production_state.get_lookahead()}),
                     lookahead
                 );
                 follow_terminals_set.insert(expanded_follow_terminals.begin(), expanded_follow_terminals.end());
             }
         }
         assert(
-            !follow_terminals_set.empty() && 
+            !follow_terminals_set.empty() &&
             "BUG: Supplied a symbol to 'follow_tokens' in combination with a parser state that has no production starting with that symbol!"
         );
         return follow_terminals_set;
     }
-}
\ No newline at end of file
+
+    std::set<IndexedLookahead_t> follow_terminals(
+        const IndexedProductionState& production_state,
+        const SymbolTable& symbol_table,
+        const LookaheadTable& lookahead_table,
+        const IndexedFirstSet_t& first_set,
+        const size_t lookahead
+    ) {
+        assert(
+            production_state.position < symbol_table.get_production_symbols(production_state.production).size()
+            && "BUG: Tried to get the follow terminals of a completed production!"
+        );
+        const std::optional<std::set<IndexedLookahead_t>> production_follow_terminals = try_get_terminals(
+            symbol_table,
+            production_state.production,
+            production_state.position + 1,
+            lookahead,
+            first_set
+        );
+        assert(production_follow_terminals.has_value() && "BUG: 'follow_tokens' got used with invalid first set!");
+        return truncate(
+            combinations(production_follow_terminals.value(), std::set<IndexedLookahead_t>{lookahead_table.get_lookahead(production_state.lookahead)}),
+            lookahead
+        );
+    }
+
+    TerminalSet_t follow_terminals(
+        const std::vector<SymbolID_t>& symbols,
+        const size_t position,
+        const TerminalSet_t& follow,
+        const TerminalFirstSet& first_set
+    ) {
+        TerminalSet_t follow_terminals_set(follow.size(), 0);
+        for (size_t symbol_position = position; symbol_position < symbols.size(); symbol_position++) {
+            unite_terminal_sets(follow_terminals_set, first_set.first_terminals[symbols[symbol_position]]);
+            if (!first_set.nullable[symbols[symbol_position]]) {
+                return follow_terminals_set;
+            }
+        }
+        unite_terminal_sets(follow_terminals_set, follow);
+        return follow_terminals_set;
+    }
+}
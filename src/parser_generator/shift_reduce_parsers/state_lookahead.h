@@ -4,12 +4,42 @@
 #include <cstddef>
 #include <string>
 #include <map>
+#include <vector>
+#include <optional>
+
+#include "parser_generator/symbol_table.h"
 
 #include "parser_state.h"
+#include "indexed_parser_state.h"
+#include "terminal_set.h"
 
 namespace parser_generator::shift_reduce_parsers {
     using FirstSet_t = std::map<std::string, std::set<Lookahead_t>>;
+    using IndexedFirstSet_t = std::vector<std::optional<std::set<IndexedLookahead_t>>>; // symbol id -> first terminals, only set for nonterminals
+
+    // The first set for a lookahead of one terminal, which fits into a bitset per symbol
+    struct TerminalFirstSet {
+        std::vector<TerminalSet_t> first_terminals; // symbol id -> terminals that can begin the symbol
+        std::vector<bool> nullable; // symbol id -> whether the symbol can derive the empty string
+    };
 
     FirstSet_t generate_first_set(const std::set<Production>& productions, const size_t lookahead);
+    IndexedFirstSet_t generate_indexed_first_set(const SymbolTable& symbol_table, const size_t lookahead);
+    TerminalFirstSet generate_terminal_first_set(const SymbolTable& symbol_table);
     std::set<Lookahead_t> follow_terminals(const Symbol& to_check, const ParserState& current_state, const FirstSet_t& first_set, const size_t lookahead);
-}
\ No newline at end of file
+    // the terminals that can follow the current symbol of the production state, including the lookahead of the production state
+    std::set<IndexedLookahead_t> follow_terminals(
+        const IndexedProductionState& production_state,
+        const SymbolTable& symbol_table,
+        const LookaheadTable& lookahead_table,
+        const IndexedFirstSet_t& first_set,
+        const size_t lookahead
+    );
+    // the terminals that can follow the given position of the symbols, with the follow terminals added if the rest of the symbols is nullable
+    TerminalSet_t follow_terminals(
+        const std::vector<SymbolID_t>& symbols,
+        const size_t position,
+        const TerminalSet_t& follow,
+        const TerminalFirstSet& first_set
+    );
+}
@@ -0,0 +1,66 @@
+#include "table_compression.h"
+
+#include <algorithm>
+#include <numeric>
+
+namespace parser_generator::shift_reduce_parsers {
+    // helper functions
+    bool fits_at_offset(const std::vector<size_t>& checks, const size_t unused_slot, const TableRow_t& row, const size_t offset);
+
+    bool fits_at_offset(const std::vector<size_t>& checks, const size_t unused_slot, const TableRow_t& row, const size_t offset) {
+        return std::all_of(
+            row.begin(), 
+            row.end(), 
+            [&](const auto& entry) -> bool { 
+                return offset + entry.first >= checks.size() || checks[offset + entry.first] == unused_slot; 
+            }
+        );
+    }
+
+    CompressedTable compress_table(const std::vector<TableRow_t>& rows, const size_t column_count) {
+        const size_t unused_slot = rows.size();
+        CompressedTable compressed{std::vector<size_t>(rows.size(), 0), {}, {}};
+        std::vector<size_t> row_order(rows.size());
+        std::iota(row_order.begin(), row_order.end(), 0);
+        std::stable_sort( // dense rows are placed first, as the sparse ones fill the gaps more easily
+            row_order.begin(), 
+            row_order.end(), 
+            [&](const size_t first, const size_t second) -> bool { return rows[first].size() > rows[second].size(); }
+        );
+        size_t first_unused_slot = 0;
+        for (const size_t row_id : row_order) {
+            const TableRow_t& row = rows[row_id];
+            // all slots before the first unused one are taken, so the smallest column can't be placed there
+            size_t offset = (!row.empty() && first_unused_slot > row.begin()->first) ? first_unused_slot - row.begin()->first : 0;
+            while (!fits_at_offset(compressed.checks, unused_slot, row, offset)) {
+                offset++;
+            }
+            compressed.row_offsets[row_id] = offset;
+            for (const auto& [column, value] : row) {
+                if (offset + column >= compressed.checks.size()) {
+                    compressed.checks.resize(offset + column + 1, unused_slot);
+                    compressed.values.resize(offset + column + 1, 0);
+                }
+                compressed.checks[offset + column] = row_id;
+                compressed.values[offset + column] = value;
+            }
+            while (first_unused_slot < compressed.checks.size() && compressed.checks[first_unused_slot] != unused_slot) {
+                first_unused_slot++;
+            }
+        }
+        // every lookup of a valid column has to stay in bounds, even for the rows with the largest offsets
+        const size_t max_offset = compressed.row_offsets.empty() ? 0 : *std::max_element(compressed.row_offsets.begin(), compressed.row_offsets.end());
+        const size_t slot_count = std::max({compressed.checks.size(), max_offset + column_count, (size_t)1});
+        compressed.checks.resize(slot_count, unused_slot);
+        compressed.values.resize(slot_count, 0);
+        return compressed;
+    }
+
+    std::optional<size_t> lookup_compressed_entry(const CompressedTable& table, const size_t row, const size_t column) {
+        const size_t slot = table.row_offsets[row] + column;
+        if (slot >= table.checks.size() || table.checks[slot] != row) {
+            return std::nullopt;
+        }
+        return table.values[slot];
+    }
+}
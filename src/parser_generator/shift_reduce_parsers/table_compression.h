@@ -0,0 +1,21 @@
+#pragma once
+
+#include <cstddef>
+#include <vector>
+#include <map>
+#include <optional>
+
+namespace parser_generator::shift_reduce_parsers {
+    using TableRow_t = std::map<size_t, size_t>; // column -> value; missing columns fall back to the default of the row
+
+    // Row displacement ("comb") compression: all rows get packed into a single value array, each at its own offset, 
+    // such that no two rows occupy the same slot. The check array stores the owner row of each slot.
+    struct CompressedTable {
+        std::vector<size_t> row_offsets;
+        std::vector<size_t> values;
+        std::vector<size_t> checks; // the row count marks unused slots
+    };
+
+    CompressedTable compress_table(const std::vector<TableRow_t>& rows, const size_t column_count);
+    std::optional<size_t> lookup_compressed_entry(const CompressedTable& table, const size_t row, const size_t column);
+}
@@ -0,0 +1,27 @@
+#include "terminal_set.h"
+
+#include <cassert>
+
+namespace parser_generator::shift_reduce_parsers {
+    TerminalSet_t create_terminal_set(const size_t terminal_count) {
+        return TerminalSet_t((terminal_count + TERMINAL_SET_WORD_BITS - 1) / TERMINAL_SET_WORD_BITS, 0);
+    }
+
+    void insert_terminal(TerminalSet_t& target, const size_t terminal_id) {
+        target[terminal_id / TERMINAL_SET_WORD_BITS] |= (uint64_t)1 << (terminal_id % TERMINAL_SET_WORD_BITS);
+    }
+
+    bool contains_terminal(const TerminalSet_t& terminal_set, const size_t terminal_id) {
+        return (terminal_set[terminal_id / TERMINAL_SET_WORD_BITS] >> (terminal_id % TERMINAL_SET_WORD_BITS)) & 1;
+    }
+
+    bool unite_terminal_sets(TerminalSet_t& target, const TerminalSet_t& to_add) {
+        assert(target.size() == to_add.size() && "BUG: Tried to unite terminal sets of different grammars!");
+        bool changed = false;
+        for (size_t word = 0; word < target.size(); word++) {
+            changed |= (to_add[word] & ~target[word]) != 0;
+            target[word] |= to_add[word];
+        }
+        return changed;
+    }
+}
@@ -0,0 +1,17 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace parser_generator::shift_reduce_parsers {
+    using TerminalSet_t = std::vector<uint64_t>; // bitset over the terminal ids
+
+    constexpr size_t TERMINAL_SET_WORD_BITS = 64;
+
+    TerminalSet_t create_terminal_set(const size_t terminal_count);
+    void insert_terminal(TerminalSet_t& target, const size_t terminal_id);
+    bool contains_terminal(const TerminalSet_t& terminal_set, const size_t terminal_id);
+    // returns whether terminals were added to the target
+    bool unite_terminal_sets(TerminalSet_t& target, const TerminalSet_t& to_add);
+}
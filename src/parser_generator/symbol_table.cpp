@@ -0,0 +1,97 @@
+#include "symbol_table.h"
+
+#include <cassert>
+#include <stdexcept>
+
+namespace parser_generator {
+    SymbolTable::SymbolTable(const std::set<Production>& productions) : terminal_count(0), productions(productions.begin(), productions.end()) {
+        std::set<Symbol> grammar_symbols{Symbol{Symbol::SymbolType::TERMINAL, "END_OF_FILE"}};
+        for (const Production& production : productions) {
+            grammar_symbols.insert(Symbol{Symbol::SymbolType::NONTERMINAL, production.name});
+            grammar_symbols.insert(production.symbols.begin(), production.symbols.end());
+        }
+        for (const Symbol& symbol : grammar_symbols) { // terminals are ordered before nonterminals
+            this->symbol_ids[symbol] = this->symbols.size();
+            this->symbols.push_back(symbol);
+            if (symbol.type == Symbol::SymbolType::TERMINAL) {
+                this->terminal_count++;
+            }
+        }
+
+        this->nonterminal_productions.resize(this->symbols.size());
+        for (ProductionID_t production_id = 0; production_id < this->productions.size(); production_id++) {
+            const Production& production = this->productions[production_id];
+            this->production_ids[production] = production_id;
+            this->production_names.push_back(this->get_symbol_id(Symbol{Symbol::SymbolType::NONTERMINAL, production.name}));
+            this->production_symbols.emplace_back();
+            for (const Symbol& symbol : production.symbols) {
+                this->production_symbols.back().push_back(this->get_symbol_id(symbol));
+            }
+            this->nonterminal_productions[this->production_names.back()].push_back(production_id);
+        }
+    }
+
+    size_t SymbolTable::get_symbol_count() const {
+        return this->symbols.size();
+    }
+
+    size_t SymbolTable::get_terminal_count() const {
+        return this->terminal_count;
+    }
+
+    size_t SymbolTable::get_production_count() const {
+        return this->productions.size();
+    }
+
+    bool SymbolTable::is_terminal(const SymbolID_t symbol_id) const {
+        return symbol_id < this->terminal_count;
+    }
+
+    SymbolID_t SymbolTable::get_symbol_id(const Symbol& symbol) const {
+        const auto symbol_id = this->symbol_ids.find(symbol);
+        if (symbol_id == this->symbol_ids.end()) {
+            throw std::runtime_error("The symbol '" + symbol.identifier + "' isn't part of the grammar!");
+        }
+        return symbol_id->second;
+    }
+
+    SymbolID_t SymbolTable::get_end_of_file_id() const {
+        return this->get_symbol_id(Symbol{Symbol::SymbolType::TERMINAL, "END_OF_FILE"});
+    }
+
+    const Symbol& SymbolTable::get_symbol(const SymbolID_t symbol_id) const {
+        assert(symbol_id < this->symbols.size() && "BUG: Tried to access non-existent symbol!");
+        return this->symbols[symbol_id];
+    }
+
+    ProductionID_t SymbolTable::get_production_id(const Production& production) const {
+        const auto production_id = this->production_ids.find(production);
+        if (production_id == this->production_ids.end()) {
+            throw std::runtime_error("The production '" + production.name + "' isn't part of the grammar!");
+        }
+        return production_id->second;
+    }
+
+    const Production& SymbolTable::get_production(const ProductionID_t production_id) const {
+        assert(production_id < this->productions.size() && "BUG: Tried to access non-existent production!");
+        return this->productions[production_id];
+    }
+
+    SymbolID_t SymbolTable::get_production_name(const ProductionID_t production_id) const {
+        assert(production_id < this->productions.size() && "BUG: Tried to access non-existent production!");
+        return this->production_names[production_id];
+    }
+
+    const std::vector<SymbolID_t>& SymbolTable::get_production_symbols(const ProductionID_t production_id) const {
+        assert(production_id < this->productions.size() && "BUG: Tried to access non-existent production!");
+        return this->production_symbols[production_id];
+    }
+
+    const std::vector<ProductionID_t>& SymbolTable::get_nonterminal_productions(const SymbolID_t nonterminal_id) const {
+        assert(nonterminal_id < this->symbols.size() && "BUG: Tried to access non-existent symbol!");
+        return this->nonterminal_productions[nonterminal_id];
+    }
+
+    SymbolTable::~SymbolTable() {
+    }
+}
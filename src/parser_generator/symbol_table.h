@@ -0,0 +1,44 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <set>
+#include <map>
+#include <vector>
+
+#include "production_definition.h"
+
+namespace parser_generator {
+    using SymbolID_t = uint32_t;
+    using ProductionID_t = uint32_t;
+
+    // Dense integer ids for the symbols and productions of a grammar, so the table generation doesn't have to copy and compare names.
+    // Terminals (END_OF_FILE included) get the ids before the nonterminals. Within both groups, the ids follow the order of the symbols,
+    // and the production ids follow the order of the productions.
+    class SymbolTable {
+        public:
+            explicit SymbolTable(const std::set<Production>& productions);
+            size_t get_symbol_count() const;
+            size_t get_terminal_count() const;
+            size_t get_production_count() const;
+            bool is_terminal(const SymbolID_t symbol_id) const;
+            SymbolID_t get_symbol_id(const Symbol& symbol) const;
+            SymbolID_t get_end_of_file_id() const;
+            const Symbol& get_symbol(const SymbolID_t symbol_id) const;
+            ProductionID_t get_production_id(const Production& production) const;
+            const Production& get_production(const ProductionID_t production_id) const;
+            SymbolID_t get_production_name(const ProductionID_t production_id) const;
+            const std::vector<SymbolID_t>& get_production_symbols(const ProductionID_t production_id) const;
+            const std::vector<ProductionID_t>& get_nonterminal_productions(const SymbolID_t nonterminal_id) const;
+            ~SymbolTable();
+        private:
+            std::vector<Symbol> symbols;
+            std::map<Symbol, SymbolID_t> symbol_ids;
+            size_t terminal_count;
+            std::vector<Production> productions;
+            std::map<Production, ProductionID_t> production_ids;
+            std::vector<SymbolID_t> production_names;
+            std::vector<std::vector<SymbolID_t>> production_symbols;
+            std::vector<std::vector<ProductionID_t>> nonterminal_productions; // empty for terminals
+    };
+}
@@ -45,6 +45,7 @@ void parser_generator::validate_productions(const std::vector<Production>& to_ch
     check_for_duplicate_productions(to_check);
     check_for_entry(to_check);
     check_for_tag_conflicts(to_check);
+    check_for_invalid_transparent_productions(to_check);
 }
 
 void parser_generator::check_for_missing_productions(const std::vector<Production>& to_check) {
@@ -93,4 +94,30 @@ void parser_generator::check_for_tag_conflicts(const std::vector<Production>& to
             );
         }
     }
+}
+
+void parser_generator::check_for_invalid_transparent_productions(const std::vector<Production>& to_check) {
+    for (const Production& production : to_check) {
+        if (!production.transparent) {
+            continue;
+        }
+        std::stringstream prod_representation;
+        prod_representation << production;
+        if (production.is_entry() || production.symbols.size() != 1 || production.symbols.front().type != Symbol::SymbolType::NONTERMINAL) {
+            throw palex_except::ValidationError(
+                "The transparent production '" + prod_representation.str() + "' has to produce exactly one nonterminal and can't be the entry production!"
+            );
+        }
+        if (!production.tag.empty()) {
+            throw palex_except::ValidationError("The transparent production '" + prod_representation.str() + "' has no reduce method to tag!");
+        }
+    }
+}
+
+void parser_generator::check_for_undefined_precedence_tokens(const PrecedenceTable_t& to_check, const std::set<std::string>& token_names) {
+    for (const auto& [terminal, precedence] : to_check) {
+        if (token_names.find(terminal) == token_names.end()) {
+            throw palex_except::ValidationError("The precedence of the token '" + terminal + "' is declared, but the token isn't defined!");
+        }
+    }
 }
\ No newline at end of file
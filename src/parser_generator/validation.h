@@ -2,8 +2,10 @@
 
 #include <vector>
 #include <set>
+#include <string>
 
 #include "production_definition.h"
+#include "operator_precedence.h"
 
 namespace parser_generator {
     void validate_productions(const std::vector<Production>& to_check);
@@ -11,4 +13,6 @@ namespace parser_generator {
     void check_for_duplicate_productions(const std::vector<Production>& to_check);
     void check_for_entry(const std::vector<Production>& to_check);
     void check_for_tag_conflicts(const std::vector<Production>& to_check);
+    void check_for_invalid_transparent_productions(const std::vector<Production>& to_check);
+    void check_for_undefined_precedence_tokens(const PrecedenceTable_t& to_check, const std::set<std::string>& token_names);
 }
\ No newline at end of file
@@ -227,6 +227,10 @@ const std::vector<std::unique_ptr<regex::RegexBase>>& regex::RegexAlternation::g
     return this->branches;
 }
 
+std::vector<std::unique_ptr<regex::RegexBase>> regex::RegexAlternation::release_branches() {
+    return std::move(this->branches);
+}
+
 size_t regex::RegexAlternation::get_priority() const {
     size_t shortest = (size_t)-1;
 
@@ -255,6 +259,10 @@ const std::vector<std::unique_ptr<regex::RegexBase>>& regex::RegexSequence::get_
     return this->sequence;
 }
 
+std::vector<std::unique_ptr<regex::RegexBase>> regex::RegexSequence::release_elements() {
+    return std::move(this->sequence);
+}
+
 size_t regex::RegexSequence::get_priority() const {
     size_t priority_sum = 0;
 
@@ -285,6 +293,10 @@ const std::unique_ptr<regex::RegexBase>& regex::RegexQuantifier::get_operand() c
     return this->operand;
 }
 
+std::unique_ptr<regex::RegexBase> regex::RegexQuantifier::release_operand() {
+    return std::move(this->operand);
+}
+
 size_t regex::RegexQuantifier::get_min() const {
     return this->min_count;
 }
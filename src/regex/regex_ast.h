@@ -67,6 +67,7 @@ namespace regex {
             ~RegexAlternation() = default;
             void add_branch(std::unique_ptr<RegexBase> branch);
             const std::vector<std::unique_ptr<RegexBase>>& get_branches() const;
+            std::vector<std::unique_ptr<RegexBase>> release_branches();
             size_t get_priority() const override;
             void debug(std::ostream& output, const size_t indentation_level = 0) const override;
         private:
@@ -79,6 +80,7 @@ namespace regex {
             ~RegexSequence() = default;
             void append_element(std::unique_ptr<RegexBase> to_append);
             const std::vector<std::unique_ptr<RegexBase>>& get_elements() const;
+            std::vector<std::unique_ptr<RegexBase>> release_elements();
             size_t get_priority() const override;
             void debug(std::ostream& output, const size_t indentation_level = 0) const override;
         private:
@@ -91,6 +93,7 @@ namespace regex {
 
             RegexQuantifier(std::unique_ptr<RegexBase> operand, const size_t min_count, const size_t max_count);
             const std::unique_ptr<RegexBase>& get_operand() const;
+            std::unique_ptr<RegexBase> release_operand();
             size_t get_min() const;
             size_t get_max() const;
             size_t get_priority() const override;
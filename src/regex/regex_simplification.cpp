@@ -0,0 +1,144 @@
+#include "regex_simplification.h"
+
+#include <vector>
+#include <utility>
+#include <stdexcept>
+
+// helper functions
+bool is_star_or_plus(const regex::RegexQuantifier* const to_check);
+bool is_collapsible_quantifier(const regex::RegexQuantifier* const to_check);
+std::unique_ptr<regex::RegexCharSet> copy_char_set(const regex::CharRangeSet& to_copy);
+std::unique_ptr<regex::RegexBase> normalize_quantifier(std::unique_ptr<regex::RegexBase> operand, size_t min, size_t max);
+
+bool is_star_or_plus(const regex::RegexQuantifier* const to_check) {
+    return to_check->get_min() <= 1 && to_check->get_max() == regex::RegexQuantifier::INFINITE;
+}
+
+bool is_collapsible_quantifier(const regex::RegexQuantifier* const to_check) { // *, +, ?
+    return to_check->get_min() <= 1 && (to_check->get_max() == 1 || to_check->get_max() == regex::RegexQuantifier::INFINITE);
+}
+
+std::unique_ptr<regex::RegexCharSet> copy_char_set(const regex::CharRangeSet& to_copy) {
+    std::unique_ptr<regex::RegexCharSet> copy = std::make_unique<regex::RegexCharSet>(false);
+    for (const regex::CharRange& range : to_copy.get_ranges()) {
+        copy->insert_char_range(range);
+    }
+    return copy;
+}
+
+std::unique_ptr<regex::RegexBase> normalize_quantifier(std::unique_ptr<regex::RegexBase> operand, size_t min, size_t max) {
+    if (max == 0 || regex::is_empty_sequence(operand.get())) {
+        return std::make_unique<regex::RegexSequence>();
+    }
+    if (min == 1 && max == 1) {
+        return operand;
+    }
+    regex::RegexQuantifier* nested = dynamic_cast<regex::RegexQuantifier*>(operand.get());
+    const bool is_collapsible = min <= 1 && (max == 1 || max == regex::RegexQuantifier::INFINITE); // *, +, ?
+    if (nested && is_collapsible_quantifier(nested) && is_collapsible) { // e.g. (a+)* -> a*, (a?)? -> a?
+        const bool infinite = is_star_or_plus(nested) || max == regex::RegexQuantifier::INFINITE;
+        return std::make_unique<regex::RegexQuantifier>(nested->release_operand(), min * nested->get_min(), infinite ? regex::RegexQuantifier::INFINITE : 1);
+    }
+
+    return std::make_unique<regex::RegexQuantifier>(std::move(operand), min, max);
+}
+
+std::unique_ptr<regex::RegexBase> regex::simplify_regex(const RegexBase* const to_simplify) {
+    if (dynamic_cast<const RegexAlternation*>(to_simplify)) {
+        return simplify_regex_branch(dynamic_cast<const RegexAlternation*>(to_simplify));
+    }
+    if (dynamic_cast<const RegexCharSet*>(to_simplify)) {
+        return simplify_regex_char_set(dynamic_cast<const RegexCharSet*>(to_simplify));
+    }
+    if (dynamic_cast<const RegexQuantifier*>(to_simplify)) {
+        return simplify_regex_quantifier(dynamic_cast<const RegexQuantifier*>(to_simplify));
+    }
+    if (dynamic_cast<const RegexSequence*>(to_simplify)) {
+        return simplify_regex_sequence(dynamic_cast<const RegexSequence*>(to_simplify));
+    }
+
+    throw std::runtime_error("Tried to simplify unknown regex type!");
+}
+
+std::unique_ptr<regex::RegexBase> regex::simplify_regex_branch(const RegexAlternation* const to_simplify) {
+    std::vector<std::unique_ptr<RegexBase>> pending;
+    for (const std::unique_ptr<RegexBase>& branch : to_simplify->get_branches()) {
+        pending.push_back(simplify_regex(branch.get()));
+    }
+
+    std::vector<std::unique_ptr<RegexBase>> branches;
+    CharRangeSet merged_char_sets;
+    bool has_char_set = false;
+    bool matches_empty = false;
+    for (size_t i = 0; i < pending.size(); i++) {
+        if (RegexAlternation* nested = dynamic_cast<RegexAlternation*>(pending[i].get())) { // (a|(b|c)) -> (a|b|c)
+            for (std::unique_ptr<RegexBase>& nested_branch : nested->release_branches()) {
+                pending.push_back(std::move(nested_branch));
+            }
+        } else if (RegexCharSet* char_set = dynamic_cast<RegexCharSet*>(pending[i].get())) { // a|b|[c-e] -> [a-e]
+            merged_char_sets = merged_char_sets + char_set->get_range_set();
+            has_char_set = true;
+        } else if (is_empty_sequence(pending[i].get())) {
+            matches_empty = true;
+        } else {
+            branches.push_back(std::move(pending[i]));
+        }
+    }
+    if (has_char_set) {
+        branches.insert(branches.begin(), copy_char_set(merged_char_sets));
+    }
+
+    std::unique_ptr<RegexBase> simplified = nullptr;
+    if (branches.empty()) {
+        return std::make_unique<RegexSequence>();
+    }
+    if (branches.size() == 1) {
+        simplified = std::move(branches.front());
+    } else {
+        std::unique_ptr<RegexAlternation> alternation = std::make_unique<RegexAlternation>();
+        for (std::unique_ptr<RegexBase>& branch : branches) {
+            alternation->add_branch(std::move(branch));
+        }
+        simplified = std::move(alternation);
+    }
+    if (matches_empty) { // (a|) -> a{0,1}
+        return normalize_quantifier(std::move(simplified), 0, 1);
+    }
+    return simplified;
+}
+
+std::unique_ptr<regex::RegexBase> regex::simplify_regex_char_set(const RegexCharSet* const to_simplify) {
+    return copy_char_set(to_simplify->get_range_set());
+}
+
+std::unique_ptr<regex::RegexBase> regex::simplify_regex_quantifier(const RegexQuantifier* const to_simplify) {
+    return normalize_quantifier(simplify_regex(to_simplify->get_operand().get()), to_simplify->get_min(), to_simplify->get_max());
+}
+
+std::unique_ptr<regex::RegexBase> regex::simplify_regex_sequence(const RegexSequence* const to_simplify) {
+    std::vector<std::unique_ptr<RegexBase>> elements;
+    for (const std::unique_ptr<RegexBase>& element : to_simplify->get_elements()) {
+        std::unique_ptr<RegexBase> simplified = simplify_regex(element.get());
+        if (RegexSequence* nested = dynamic_cast<RegexSequence*>(simplified.get())) { // a(bc) -> abc, also drops empty sequences
+            for (std::unique_ptr<RegexBase>& nested_element : nested->release_elements()) {
+                elements.push_back(std::move(nested_element));
+            }
+        } else {
+            elements.push_back(std::move(simplified));
+        }
+    }
+
+    if (elements.size() == 1) {
+        return std::move(elements.front());
+    }
+    std::unique_ptr<RegexSequence> sequence = std::make_unique<RegexSequence>();
+    for (std::unique_ptr<RegexBase>& element : elements) {
+        sequence->append_element(std::move(element));
+    }
+    return sequence;
+}
+
+bool regex::is_empty_sequence(const RegexBase* const to_check) {
+    const RegexSequence* sequence = dynamic_cast<const RegexSequence*>(to_check);
+    return sequence && sequence->get_elements().empty();
+}
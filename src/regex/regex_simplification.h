@@ -0,0 +1,16 @@
+#pragma once
+
+#include <memory>
+
+#include "regex_ast.h"
+
+namespace regex {
+    // returns a simplified copy that matches the same language (the priority of the copy may differ from the original)
+    std::unique_ptr<RegexBase> simplify_regex(const RegexBase* const to_simplify);
+    std::unique_ptr<RegexBase> simplify_regex_branch(const RegexAlternation* const to_simplify);
+    std::unique_ptr<RegexBase> simplify_regex_char_set(const RegexCharSet* const to_simplify);
+    std::unique_ptr<RegexBase> simplify_regex_quantifier(const RegexQuantifier* const to_simplify);
+    std::unique_ptr<RegexBase> simplify_regex_sequence(const RegexSequence* const to_simplify);
+
+    bool is_empty_sequence(const RegexBase* const to_check);
+}
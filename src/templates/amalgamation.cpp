@@ -0,0 +1,40 @@
+#include "amalgamation.h"
+
+#include <sstream>
+#include <optional>
+#include <string_view>
+
+// helper functions
+std::optional<std::string_view> get_included_file(const std::string_view line);
+
+std::optional<std::string_view> get_included_file(const std::string_view line) {
+    constexpr std::string_view INCLUDE_DIRECTIVE = "#include ";
+    if (line.substr(0, INCLUDE_DIRECTIVE.size()) != INCLUDE_DIRECTIVE || line.size() < INCLUDE_DIRECTIVE.size() + 2) {
+        return std::nullopt;
+    }
+    return line.substr(INCLUDE_DIRECTIVE.size() + 1, line.size() - INCLUDE_DIRECTIVE.size() - 2);
+}
+
+std::string templates::amalgamate_sources(const std::vector<std::string>& sources, const std::map<std::string, std::string>& include_replacements) {
+    std::ostringstream amalgamation;
+    amalgamation << "#pragma once\n";
+    for (const std::string& source : sources) {
+        amalgamation << "\n";
+        std::istringstream source_lines(source);
+        std::string line;
+        while (std::getline(source_lines, line)) {
+            if (line == "#pragma once") {
+                continue;
+            }
+            const std::optional<std::string_view> included_file = get_included_file(line);
+            const auto replacement = included_file.has_value() ? include_replacements.find(std::string(included_file.value())) 
+                                                               : include_replacements.end();
+            if (replacement == include_replacements.end()) {
+                amalgamation << line << "\n";
+            } else if (!replacement->second.empty()) {
+                amalgamation << "#include \"" << replacement->second << "\"\n";
+            }
+        }
+    }
+    return amalgamation.str();
+}
\ No newline at end of file
@@ -0,0 +1,11 @@
+#pragma once
+
+#include <string>
+#include <vector>
+#include <map>
+
+namespace templates {
+    // Joins rendered C++ sources into a single header. The include directives of files that are part of the amalgamation get
+    // replaced by the mapped include target or dropped if the target is empty.
+    std::string amalgamate_sources(const std::vector<std::string>& sources, const std::map<std::string, std::string>& include_replacements);
+}
\ No newline at end of file
@@ -3,12 +3,42 @@
 #include <cstring>
 #include <algorithm>
 #include <cstddef>
+#include <cstdint>
 #include <fstream>
+#include <sstream>
+#include <filesystem>
+#include <optional>
 #include <stdexcept>
+#include <random>
+#include <iomanip>
+#include <system_error>
 
 #include "util/palex_except.h"
 #include "util/stream_format.h"
 
+// helper functions
+std::optional<std::string> read_file(const std::string& path);
+std::string get_temporary_path(const std::string& output_path);
+
+std::optional<std::string> read_file(const std::string& path) {
+    std::ifstream input_file(path, std::ios::binary);
+    if (!input_file.is_open()) {
+        return std::nullopt;
+    }
+    std::ostringstream content;
+    content << input_file.rdbuf();
+    return content.str();
+}
+
+std::string get_temporary_path(const std::string& output_path) {
+    // every writer gets its own file, so concurrent runs generating the same file don't write into each other's files
+    std::random_device random_source;
+    const uint64_t suffix = ((uint64_t)random_source() << 32) ^ (uint64_t)random_source();
+    std::ostringstream temporary_path;
+    temporary_path << output_path << "." << std::hex << std::setw(16) << std::setfill('0') << suffix << ".tmp";
+    return temporary_path.str();
+}
+
 templates::TemplateCompleter_t templates::EMPTY_COMPLETER = [](std::ostream& output) -> void {};
 
 templates::TemplateCompleter_t templates::constant_completer(const std::string& completer_output) {
@@ -23,50 +53,127 @@ templates::TemplateCompleter_t templates::choice_completer(const bool toggle_fla
     return constant_completer(toggle_flag ? on_true : on_false);
 }
 
+templates::CompiledTemplate::CompiledTemplate(const std::string_view source) {
+    std::map<std::string_view, size_t> tag_indices;
+    const char* text_begin_ptr = source.data();
+    const char* const source_end = source.data() + source.size();
+
+    const auto add_text = [&](const char* const text_end_ptr) {
+        if (text_end_ptr != text_begin_ptr) {
+            this->segments.push_back(TemplateSegment{std::string_view(text_begin_ptr, (size_t)(text_end_ptr - text_begin_ptr)), TEXT_SEGMENT});
+        }
+    };
+
+    for (const char* curr_ptr = text_begin_ptr; curr_ptr != source_end; curr_ptr++) {
+        if (*curr_ptr != '%') {
+            continue;
+        }
+        const char* const tag_begin_ptr = curr_ptr;
+        const char* const tag_end_ptr = std::find(tag_begin_ptr + 1, source_end, '%');
+        if (tag_end_ptr == source_end) {
+            throw palex_except::ParserError("The tag is missing an end character!");
+        }
+        if (tag_end_ptr - tag_begin_ptr == 1) {
+            add_text(tag_begin_ptr + 1); // Empty tags get interpreted as % (modulo-operator)
+        } else {
+            add_text(tag_begin_ptr);
+            const std::string_view tag = std::string_view(tag_begin_ptr + 1, (size_t)(tag_end_ptr - tag_begin_ptr - 1));
+            const auto tag_index = tag_indices.insert(std::make_pair(tag, this->tags.size()));
+            if (tag_index.second) {
+                this->tags.push_back(tag);
+            }
+            this->segments.push_back(TemplateSegment{tag, tag_index.first->second});
+        }
+        curr_ptr = tag_end_ptr;
+        text_begin_ptr = tag_end_ptr + 1;
+    }
+    add_text(source_end);
+}
+
+templates::CompiledTemplate::operator TemplateView() const {
+    return TemplateView{this->segments.data(), this->segments.size(), this->tags.data(), this->tags.size()};
+}
+
 void templates::write_template_to_stream(
-    const char* const to_write, 
+    const TemplateView& to_write, 
     std::ostream& output, 
     const std::map<std::string_view, TemplateCompleter_t>& completers
 ) {
-    const char* const to_write_end = to_write + strlen(to_write);
-    for (const char* curr_ptr = to_write; curr_ptr != to_write_end; curr_ptr++) {
-        if (*curr_ptr == '%') {
-            const char* const tag_begin_ptr = curr_ptr;
-            const char* const tag_end_ptr = std::find(tag_begin_ptr + 1, to_write_end, '%');
-            if (tag_end_ptr == to_write_end) {
-                throw palex_except::ParserError("The tag is missing an end character!");
-            }
-            if (tag_end_ptr - tag_begin_ptr == 1) {
-                output << '%'; // Empty tags get interpreted as % (modulo-operator)
-            } else {
-                const std::string_view tag = std::string_view(tag_begin_ptr + 1, (size_t)(tag_end_ptr - tag_begin_ptr - 1));
-                if (completers.find(tag) == completers.end()) {
-                    throw std::runtime_error("No matching completer-function for the tag '" + std::string(tag) + "' found!");
-                }
-                completers.at(tag)(output);
-            }
-            curr_ptr = tag_end_ptr;
+    // every tag is looked up only once, the segments refer to the completers by index
+    std::vector<const TemplateCompleter_t*> tag_completers(to_write.tag_count, nullptr);
+    for (size_t tag_index = 0; tag_index < to_write.tag_count; tag_index++) {
+        const auto completer = completers.find(to_write.tags[tag_index]);
+        if (completer == completers.end()) {
+            throw std::runtime_error("No matching completer-function for the tag '" + std::string(to_write.tags[tag_index]) + "' found!");
+        }
+        tag_completers[tag_index] = &completer->second;
+    }
+
+    for (size_t segment_index = 0; segment_index < to_write.segment_count; segment_index++) {
+        const TemplateSegment& segment = to_write.segments[segment_index];
+        if (segment.tag_index == TEXT_SEGMENT) {
+            output.write(segment.content.data(), (std::streamsize)segment.content.size());
         } else {
-            output << *curr_ptr;
+            (*tag_completers[segment.tag_index])(output);
         }
     }
 }
 
+void templates::write_template_to_stream(
+    const char* const to_write, 
+    std::ostream& output, 
+    const std::map<std::string_view, TemplateCompleter_t>& completers
+) {
+    write_template_to_stream(CompiledTemplate(to_write), output, completers);
+}
+
 void templates::write_template_to_file(
     const char* const to_write, 
     const std::string& output_path, 
     const std::map<std::string_view, TemplateCompleter_t>& completers
 ) {
-    std::ofstream output_file(output_path);
-    sfmt::IndentationStreamBuffer indentation_output_file_buffer(output_file);
-    if (!output_file.is_open()) {
-        throw std::runtime_error("Unable to open the file '" + output_path + "'!");
+    write_template_to_file(CompiledTemplate(to_write), output_path, completers);
+}
+
+std::string templates::render_template(const TemplateView& to_render, const std::map<std::string_view, TemplateCompleter_t>& completers) {
+    std::ostringstream rendered_output;
+    {
+        sfmt::IndentationStreamBuffer indentation_output_buffer(rendered_output);
+        write_template_to_stream(to_render, rendered_output, completers);
+    }
+    return rendered_output.str();
+}
+
+void templates::write_string_to_file(const std::string& content, const std::string& output_path) {
+    // unchanged files are kept, so that their modification time doesn't trigger a rebuild
+    const std::optional<std::string> existing = read_file(output_path);
+    if (existing.has_value() && existing.value() == content) {
+        return;
     }
+
+    const std::string temporary_path = get_temporary_path(output_path);
     try {
-        write_template_to_stream(to_write, output_file, completers);
-    } catch(...) {
-        output_file.close();
+        {
+            std::ofstream output_file(temporary_path, std::ios::binary | std::ios::trunc);
+            if (!output_file.is_open()) {
+                throw std::runtime_error("Unable to open the file '" + output_path + "'!");
+            }
+            if (!output_file.write(content.data(), (std::streamsize)content.size()).flush()) {
+                throw std::runtime_error("Failed to write the file '" + output_path + "'!");
+            }
+        }
+        std::filesystem::rename(temporary_path, output_path);
+    } catch (...) {
+        std::error_code ignored_error;
+        std::filesystem::remove(temporary_path, ignored_error);
         throw;
     }
-    output_file.close();
-}
\ No newline at end of file
+}
+
+void templates::write_template_to_file(
+    const TemplateView& to_write, 
+    const std::string& output_path, 
+    const std::map<std::string_view, TemplateCompleter_t>& completers
+) {
+    write_string_to_file(render_template(to_write, completers), output_path);
+}
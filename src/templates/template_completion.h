@@ -4,20 +4,53 @@
 #include <functional>
 #include <string_view>
 #include <string>
+#include <vector>
 #include <map>
+#include <cstddef>
 
 namespace templates {
     using TemplateCompleter_t = std::function<void (std::ostream&)>;
 
+    constexpr size_t TEXT_SEGMENT = (size_t)-1;
+
+    struct TemplateSegment {
+        std::string_view content; // the literal text or the name of the tag
+        size_t tag_index; // index into the tag table of the template, TEXT_SEGMENT for literal text
+    };
+
+    struct TemplateView { // precompiled template, literal type so that build time generated templates can be constexpr
+        const TemplateSegment* segments;
+        size_t segment_count;
+        const std::string_view* tags; // every tag is only contained once
+        size_t tag_count;
+    };
+
+    class CompiledTemplate { // template compiled at runtime, the segments reference the source, so it has to outlive the template
+        public:
+            explicit CompiledTemplate(const std::string_view source);
+            operator TemplateView() const;
+        private:
+            std::vector<TemplateSegment> segments;
+            std::vector<std::string_view> tags;
+    };
+
     extern TemplateCompleter_t EMPTY_COMPLETER;
 
     TemplateCompleter_t constant_completer(const std::string& completer_output);
     TemplateCompleter_t conditional_completer(const bool enable_flag, const std::string& completer_output);
     TemplateCompleter_t choice_completer(const bool toggle_flag, const std::string& on_true, const std::string& on_false);
+    void write_template_to_stream(
+        const TemplateView& to_write, 
+        std::ostream& output, 
+        const std::map<std::string_view, TemplateCompleter_t>& completers
+    );
     void write_template_to_stream(
         const char* const to_write, 
         std::ostream& output, 
         const std::map<std::string_view, TemplateCompleter_t>& completers
     );
+    std::string render_template(const TemplateView& to_render, const std::map<std::string_view, TemplateCompleter_t>& completers);
+    void write_string_to_file(const std::string& content, const std::string& output_path); // keeps the file untouched if the content didn't change
+    void write_template_to_file(const TemplateView& to_write, const std::string& output_path, const std::map<std::string_view, TemplateCompleter_t>& completers);
     void write_template_to_file(const char* const to_write, const std::string& output_path, const std::map<std::string_view, TemplateCompleter_t>& completers);
-}
\ No newline at end of file
+}
@@ -1,3 +1,69 @@
+# Compiles a template into a constexpr segment list, so that no template parsing has to be done at runtime.
 file(READ "${TEMPLATE_DIR}/${TEMPLATE_NAME}.template" template)
-set(output "#pragma once\n\nstatic const char* ${TEMPLATE_NAME} = R\"(${template})\";")
+
+set(tags "")
+set(tag_count 0)
+set(segments "")
+set(segment_count 0)
+set(text "")
+
+string(FIND "${template}" "%" tag_begin)
+while(NOT tag_begin EQUAL -1)
+    string(SUBSTRING "${template}" 0 ${tag_begin} text_part)
+    string(APPEND text "${text_part}")
+    math(EXPR tag_begin "${tag_begin} + 1")
+    string(SUBSTRING "${template}" ${tag_begin} -1 template)
+    string(FIND "${template}" "%" tag_length)
+    if(tag_length EQUAL -1)
+        message(FATAL_ERROR "The tag in the template ${TEMPLATE_NAME} is missing an end character!")
+    endif()
+
+    if(tag_length EQUAL 0)
+        # Empty tags get interpreted as % (modulo-operator)
+        string(APPEND text "%")
+    else()
+        if(NOT text STREQUAL "")
+            string(APPEND segments "    templates::TemplateSegment{R\"(${text})\", templates::TEXT_SEGMENT},\n")
+            math(EXPR segment_count "${segment_count} + 1")
+            set(text "")
+        endif()
+        string(SUBSTRING "${template}" 0 ${tag_length} tag)
+        list(FIND tags "${tag}" tag_index)
+        if(tag_index EQUAL -1)
+            list(APPEND tags "${tag}")
+            set(tag_index ${tag_count})
+            math(EXPR tag_count "${tag_count} + 1")
+        endif()
+        string(APPEND segments "    templates::TemplateSegment{\"${tag}\", ${tag_index}},\n")
+        math(EXPR segment_count "${segment_count} + 1")
+    endif()
+
+    math(EXPR tag_length "${tag_length} + 1")
+    string(SUBSTRING "${template}" ${tag_length} -1 template)
+    string(FIND "${template}" "%" tag_begin)
+endwhile()
+string(APPEND text "${template}")
+if(NOT text STREQUAL "")
+    string(APPEND segments "    templates::TemplateSegment{R\"(${text})\", templates::TEXT_SEGMENT},\n")
+    math(EXPR segment_count "${segment_count} + 1")
+endif()
+
+set(output "#pragma once\n\n#include \"templates/template_completion.h\"\n\n")
+if(tag_count EQUAL 0)
+    set(tags_ptr "nullptr")
+else()
+    string(APPEND output "static constexpr std::string_view ${TEMPLATE_NAME}_tags[] = {\n")
+    foreach(tag ${tags})
+        string(APPEND output "    \"${tag}\",\n")
+    endforeach()
+    string(APPEND output "};\n\n")
+    set(tags_ptr "${TEMPLATE_NAME}_tags")
+endif()
+if(segment_count EQUAL 0)
+    set(segments_ptr "nullptr")
+else()
+    string(APPEND output "static constexpr templates::TemplateSegment ${TEMPLATE_NAME}_segments[] = {\n${segments}};\n\n")
+    set(segments_ptr "${TEMPLATE_NAME}_segments")
+endif()
+string(APPEND output "static constexpr templates::TemplateView ${TEMPLATE_NAME} = {${segments_ptr}, ${segment_count}, ${tags_ptr}, ${tag_count}};\n")
 file(WRITE "${OUTPUT_DIR}/${TEMPLATE_NAME}.h" "${output}")
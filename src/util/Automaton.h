@@ -90,6 +90,7 @@ namespace sm {
 
             StateID_t next_state_id;
             ConnectionID_t next_connection_id;
+            size_t epsilon_connection_count;
 
             std::map<StateID_t, StateValue_T> states;
             std::map<ConnectionID_t, const Connection> connections;
@@ -1,5 +1,5 @@
 template<class StateValue_T, class ConnectionValue_T>
-sm::Automaton<StateValue_T, ConnectionValue_T>::Automaton() : next_state_id{0}, next_connection_id{0} {
+sm::Automaton<StateValue_T, ConnectionValue_T>::Automaton() : next_state_id{0}, next_connection_id{0}, epsilon_connection_count{0} {
 }
 
 template<class StateValue_T, class ConnectionValue_T>
@@ -109,6 +109,9 @@ void sm::Automaton<StateValue_T, ConnectionValue_T>::remove_connection(const Con
     std::vector<ConnectionID_t>& transitions = this->transition_table.at(to_remove.source).at(to_remove.target);
     transitions.erase(std::find(transitions.begin(), transitions.end(), id));
 
+    if (to_remove.type == Connection::ConnectionType::EPSILON) {
+        this->epsilon_connection_count--;
+    }
     this->connections.erase(id);
 }
 
@@ -145,6 +148,9 @@ auto sm::Automaton<StateValue_T, ConnectionValue_T>::add_connection(const Connec
 
     this->connections.insert(std::make_pair(connection_id, to_add));
     this->transition_table[to_add.source][to_add.target].push_back(connection_id);
+    if (to_add.type == Connection::ConnectionType::EPSILON) {
+        this->epsilon_connection_count++;
+    }
 
     return connection_id;    
 }
@@ -201,6 +207,9 @@ void sm::Automaton<StateValue_T, ConnectionValue_T>::insert_mergeable_states(con
 
 template<class StateValue_T, class ConnectionValue_T>
 auto sm::Automaton<StateValue_T, ConnectionValue_T>::get_mergeable_states(const std::set<StateID_t> sources) const -> std::set<StateID_t> {
+    if (this->epsilon_connection_count == 0) { // epsilon-free automatons (e.g. position automatons) don't need a closure
+        return sources;
+    }
     std::set<StateID_t> mergeable_states;
 
     for (const StateID_t source : sources) {
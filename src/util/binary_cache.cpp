@@ -0,0 +1,125 @@
+#include "binary_cache.h"
+
+#include <fstream>
+#include <sstream>
+#include <filesystem>
+#include <stdexcept>
+#include <iomanip>
+#include <algorithm>
+#include <random>
+#include <system_error>
+
+constexpr uint64_t FNV_OFFSET_BASIS = 0xcbf29ce484222325;
+constexpr uint64_t FNV_PRIME = 0x100000001b3;
+constexpr size_t UINT_BYTE_COUNT = 8;
+
+// helper functions
+std::filesystem::path get_entry_path(const std::string& cache_path, const std::string& category, const std::string& key);
+std::filesystem::path get_temporary_path(const std::filesystem::path& entry_path);
+
+std::filesystem::path get_entry_path(const std::string& cache_path, const std::string& category, const std::string& key) {
+    std::stringstream file_name;
+    file_name << category << "-" << std::hex << std::setw(16) << std::setfill('0') << bcache::hash_content(key) << ".bin";
+    return std::filesystem::path(cache_path) / file_name.str();
+}
+
+std::filesystem::path get_temporary_path(const std::filesystem::path& entry_path) {
+    // every writer gets its own file, so concurrent runs storing the same entry don't write into each other's files
+    std::random_device random_source;
+    const uint64_t suffix = ((uint64_t)random_source() << 32) ^ (uint64_t)random_source();
+    std::stringstream file_suffix;
+    file_suffix << "." << std::hex << std::setw(16) << std::setfill('0') << suffix << ".tmp";
+    std::filesystem::path temporary_path = entry_path;
+    temporary_path += file_suffix.str();
+    return temporary_path;
+}
+
+void bcache::write_uint(std::ostream& output, const uint64_t value) {
+    char bytes[UINT_BYTE_COUNT];
+    for (size_t i = 0; i < UINT_BYTE_COUNT; i++) {
+        bytes[i] = (char)((value >> (8 * i)) & 0xff);
+    }
+    output.write(bytes, UINT_BYTE_COUNT);
+}
+
+void bcache::write_string(std::ostream& output, const std::string_view value) {
+    write_uint(output, value.size());
+    output.write(value.data(), value.size());
+}
+
+uint64_t bcache::read_uint(std::istream& input) {
+    char bytes[UINT_BYTE_COUNT];
+    if (!input.read(bytes, UINT_BYTE_COUNT)) {
+        throw std::runtime_error("Unexpected end of cache entry!");
+    }
+    uint64_t value = 0;
+    for (size_t i = 0; i < UINT_BYTE_COUNT; i++) {
+        value |= (uint64_t)(unsigned char)bytes[i] << (8 * i);
+    }
+    return value;
+}
+
+std::string bcache::read_string(std::istream& input) {
+    const uint64_t length = read_uint(input);
+    std::string value;
+    // the length isn't trusted blindly, as a corrupted entry could request huge allocations
+    while (value.size() < length) {
+        char buffer[4096];
+        const size_t chunk_size = std::min<uint64_t>(sizeof(buffer), length - value.size());
+        if (!input.read(buffer, chunk_size)) {
+            throw std::runtime_error("Unexpected end of cache entry!");
+        }
+        value.append(buffer, chunk_size);
+    }
+    return value;
+}
+
+uint64_t bcache::hash_content(const std::string_view content) {
+    uint64_t hash = FNV_OFFSET_BASIS;
+    for (const char curr : content) {
+        hash ^= (unsigned char)curr;
+        hash *= FNV_PRIME;
+    }
+    return hash;
+}
+
+std::optional<std::string> bcache::load_entry(const std::string& cache_path, const std::string& category, const std::string& key) {
+    std::ifstream entry(get_entry_path(cache_path, category, key), std::ios::binary);
+    if (!entry.is_open()) {
+        return std::nullopt;
+    }
+    try {
+        if (read_string(entry) != key) {
+            return std::nullopt;
+        }
+        return read_string(entry);
+    } catch (const std::runtime_error&) { // damaged entries are treated like missing ones
+        return std::nullopt;
+    }
+}
+
+void bcache::store_entry(const std::string& cache_path, const std::string& category, const std::string& key, const std::string& data) {
+    const std::filesystem::path entry_path = get_entry_path(cache_path, category, key);
+    const std::filesystem::path temporary_path = get_temporary_path(entry_path);
+
+    std::filesystem::create_directories(cache_path);
+    try {
+        {
+            std::ofstream entry(temporary_path, std::ios::binary | std::ios::trunc);
+            if (!entry.is_open()) {
+                throw std::runtime_error("Unable to create cache entry '" + temporary_path.string() + "'!");
+            }
+            write_string(entry, key);
+            write_string(entry, data);
+            if (!entry.flush()) {
+                throw std::runtime_error("Failed to write cache entry '" + temporary_path.string() + "'!");
+            }
+        }
+        // concurrent generator runs never see partially written entries
+        std::filesystem::rename(temporary_path, entry_path);
+    } catch (...) {
+        std::error_code ignored_error;
+        std::filesystem::remove(temporary_path, ignored_error);
+        throw;
+    }
+}
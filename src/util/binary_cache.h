@@ -0,0 +1,22 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <optional>
+#include <istream>
+#include <ostream>
+
+namespace bcache {
+    // all integers are stored as 64 bit little endian values, strings are prefixed by their length
+    void write_uint(std::ostream& output, const uint64_t value);
+    void write_string(std::ostream& output, const std::string_view value);
+    uint64_t read_uint(std::istream& input);
+    std::string read_string(std::istream& input);
+
+    uint64_t hash_content(const std::string_view content); // FNV-1a
+
+    // entries are stored as <cache_path>/<category>-<hash of key>.bin and contain the full key, so hash collisions are detected on load
+    std::optional<std::string> load_entry(const std::string& cache_path, const std::string& category, const std::string& key);
+    void store_entry(const std::string& cache_path, const std::string& category, const std::string& key, const std::string& data);
+}
@@ -18,4 +18,10 @@ palex_except::ValidationError::ValidationError(const std::string& message) : mes
 
 const char* palex_except::ValidationError::what() const noexcept {
     return this->message.c_str();
+}
+
+palex_except::GrammarConflictError::GrammarConflictError(const char* const message) : std::runtime_error(message) {    
+}
+
+palex_except::GrammarConflictError::GrammarConflictError(const std::string& message) : std::runtime_error(message) {    
 }
\ No newline at end of file
@@ -21,4 +21,11 @@ namespace palex_except {
         private:
             const std::string message;
     };
+
+    // two actions of a parser state can't be told apart with the used lookahead
+    class GrammarConflictError : public std::runtime_error {
+        public:
+            GrammarConflictError(const char* const message);
+            GrammarConflictError(const std::string& message);
+    };
 }
\ No newline at end of file
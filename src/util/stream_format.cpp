@@ -1,6 +1,7 @@
 #include "stream_format.h"
 
 #include <algorithm>
+#include <string>
 
 namespace sfmt {
     std::ostream& operator<<(std::ostream& output, const Indentation& manipulator) {
@@ -50,14 +51,52 @@ namespace sfmt {
     }
 
     int IndentationStreamBuffer::overflow(int written_char) {
+        if (written_char == traits_type::eof()) {
+            return traits_type::not_eof(written_char);
+        }
         if (this->is_start_of_line && written_char != '\n') {
-            const size_t whitespace_count = this->indentation_level * this->indentation_width;
-            this->destination->sputn(std::string(whitespace_count, ' ').c_str(), (std::streamsize)whitespace_count);
+            this->write_indentation();
         }
         this->is_start_of_line = written_char == '\n';
         return (int)this->destination->sputc((char)written_char);
     }
 
+    std::streamsize IndentationStreamBuffer::xsputn(const char* to_write, std::streamsize count) {
+        const char* const to_write_end = to_write + count;
+        const char* line_begin = to_write;
+
+        while (line_begin != to_write_end) {
+            const char* const newline = std::find(line_begin, to_write_end, '\n');
+            const char* const line_end = (newline == to_write_end) ? to_write_end : newline + 1;
+            if (this->is_start_of_line && *line_begin != '\n' && !this->write_indentation()) {
+                return (std::streamsize)(line_begin - to_write);
+            }
+            const std::streamsize line_length = (std::streamsize)(line_end - line_begin);
+            const std::streamsize written = this->destination->sputn(line_begin, line_length);
+            if (written != line_length) {
+                return (std::streamsize)(line_begin - to_write) + written;
+            }
+            this->is_start_of_line = *(line_end - 1) == '\n';
+            line_begin = line_end;
+        }
+
+        return count;
+    }
+
+    bool IndentationStreamBuffer::write_indentation() {
+        static const std::string INDENTATION_CHUNK(64, ' ');
+
+        size_t whitespace_count = this->indentation_level * this->indentation_width;
+        while (whitespace_count != 0) {
+            const size_t chunk_size = std::min(whitespace_count, INDENTATION_CHUNK.size());
+            if (this->destination->sputn(INDENTATION_CHUNK.data(), (std::streamsize)chunk_size) != (std::streamsize)chunk_size) {
+                return false;
+            }
+            whitespace_count -= chunk_size;
+        }
+        return true;
+    }
+
     int IndentationStreamBuffer::sync() {
         return this->destination->pubsync();
     }
@@ -20,8 +20,11 @@ namespace sfmt {
             virtual ~IndentationStreamBuffer();
         protected:
             virtual int overflow(int written_char) override;
+            virtual std::streamsize xsputn(const char* to_write, std::streamsize count) override; // writes whole lines at once
             virtual int sync() override; 
         private:
+            bool write_indentation();
+
             bool is_start_of_line;
             std::ostream* stream_buffer_owner;
             std::streambuf* destination;
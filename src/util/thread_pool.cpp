@@ -0,0 +1,105 @@
+#include "thread_pool.h"
+
+#include <limits>
+#include <algorithm>
+
+namespace tpool {
+    size_t resolve_thread_count(const size_t requested_threads) {
+        if (requested_threads != 0) {
+            return requested_threads;
+        }
+        return std::max((size_t)std::thread::hardware_concurrency(), (size_t)1); // hardware_concurrency is 0 if it's unknown
+    }
+
+    ThreadPool::ThreadPool(const size_t thread_count)
+        : batch_task(nullptr),
+        batch_size(0),
+        next_task(0),
+        finished_tasks(0),
+        batch_generation(0),
+        stopping(false),
+        failed_task(std::numeric_limits<size_t>::max()),
+        failure(nullptr) {
+        for (size_t worker = 1; worker < thread_count; worker++) { // the calling thread is the last one
+            this->workers.emplace_back(&ThreadPool::work, this);
+        }
+    }
+
+    void ThreadPool::run(const size_t task_count, const std::function<void(size_t)>& task) {
+        if (task_count == 0) {
+            return;
+        }
+        {
+            std::lock_guard<std::mutex> lock(this->batch_mutex);
+            this->batch_task = &task;
+            this->batch_size = task_count;
+            this->next_task = 0;
+            this->finished_tasks = 0;
+            this->failed_task = std::numeric_limits<size_t>::max();
+            this->failure = nullptr;
+            this->batch_generation++;
+        }
+        this->batch_started.notify_all();
+        this->process_tasks();
+
+        std::unique_lock<std::mutex> lock(this->batch_mutex);
+        this->batch_finished.wait(lock, [this]() -> bool { return this->finished_tasks == this->batch_size; });
+        this->batch_task = nullptr;
+        if (this->failure != nullptr) {
+            std::rethrow_exception(this->failure);
+        }
+    }
+
+    size_t ThreadPool::get_thread_count() const {
+        return this->workers.size() + 1;
+    }
+
+    ThreadPool::~ThreadPool() {
+        {
+            std::lock_guard<std::mutex> lock(this->batch_mutex);
+            this->stopping = true;
+        }
+        this->batch_started.notify_all();
+        for (std::thread& worker : this->workers) {
+            worker.join();
+        }
+    }
+
+    void ThreadPool::work() {
+        size_t processed_generation = 0;
+        while (true) {
+            {
+                std::unique_lock<std::mutex> lock(this->batch_mutex);
+                this->batch_started.wait(lock, [&]() -> bool { return this->stopping || this->batch_generation != processed_generation; });
+                if (this->stopping) {
+                    return;
+                }
+                processed_generation = this->batch_generation;
+            }
+            this->process_tasks();
+        }
+    }
+
+    void ThreadPool::process_tasks() {
+        std::unique_lock<std::mutex> lock(this->batch_mutex);
+        while (this->batch_task != nullptr && this->next_task < this->batch_size) {
+            const size_t task_id = this->next_task++;
+            const std::function<void(size_t)>& task = *this->batch_task;
+            lock.unlock();
+            std::exception_ptr task_failure = nullptr;
+            try {
+                task(task_id);
+            } catch (...) {
+                task_failure = std::current_exception();
+            }
+            lock.lock();
+            if (task_failure != nullptr && task_id < this->failed_task) {
+                this->failed_task = task_id;
+                this->failure = task_failure;
+            }
+            if (++this->finished_tasks == this->batch_size) {
+                this->batch_finished.notify_all();
+            }
+        }
+    }
+}
@@ -0,0 +1,41 @@
+#pragma once
+
+#include <cstddef>
+#include <functional>
+#include <vector>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <exception>
+
+namespace tpool {
+    size_t resolve_thread_count(const size_t requested_threads); // 0 requests one thread per hardware thread
+
+    // Keeps its worker threads alive between batches of tasks, as the parser table generation runs one batch per state frontier
+    class ThreadPool {
+        public:
+            explicit ThreadPool(const size_t thread_count);
+            ThreadPool(const ThreadPool& other) = delete;
+            // runs task(0) to task(task_count - 1) on the workers and the calling thread and returns once all have finished.
+            // If tasks throw, the exception of the task with the lowest index is rethrown, so errors don't depend on the scheduling.
+            void run(const size_t task_count, const std::function<void(size_t)>& task);
+            size_t get_thread_count() const;
+            ~ThreadPool();
+        private:
+            void work();
+            void process_tasks();
+
+            std::vector<std::thread> workers;
+            std::mutex batch_mutex;
+            std::condition_variable batch_started;
+            std::condition_variable batch_finished;
+            const std::function<void(size_t)>* batch_task;
+            size_t batch_size;
+            size_t next_task;
+            size_t finished_tasks;
+            size_t batch_generation; // tells the workers apart which batches they already took part in
+            bool stopping;
+            size_t failed_task;
+            std::exception_ptr failure;
+    };
+}
@@ -9,6 +9,15 @@ function (create_lexer_test_dependencies TEST_NAME TEST_SRC PALEX_RULEFILE ADDIT
         ${CMAKE_CURRENT_BINARY_DIR}/${NAME}Token.h
         ${CMAKE_CURRENT_BINARY_DIR}/${NAME}Token.cpp
     )
+    list(FIND ADDITIONAL_FLAGS "-shards" SHARDS_FLAG_INDEX)
+    if(NOT SHARDS_FLAG_INDEX EQUAL -1)
+        math(EXPR SHARDS_FLAG_INDEX "${SHARDS_FLAG_INDEX} + 1")
+        list(GET ADDITIONAL_FLAGS ${SHARDS_FLAG_INDEX} SHARD_COUNT)
+        math(EXPR LAST_SHARD "${SHARD_COUNT} - 1")
+        foreach(SHARD RANGE ${LAST_SHARD})
+            list(APPEND LEXER_FILES ${CMAKE_CURRENT_BINARY_DIR}/${NAME}LexerStates${SHARD}.cpp)
+        endforeach()
+    endif()
     add_custom_command(
         OUTPUT ${LEXER_FILES}
         COMMAND ${CMAKE_BINARY_DIR}/lexergen ${PALEX_RULEFILE} -lang c++ -output-path ${CMAKE_CURRENT_BINARY_DIR} --lexer ${ADDITIONAL_FLAGS}
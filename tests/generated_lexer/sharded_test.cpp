@@ -0,0 +1,14 @@
+#include <iostream>
+#include <string_view>
+
+#include <ShardedTestLexer.h>
+
+int main() {
+    const std::string_view input = "0x1f 0x123456789 if iff 42 abcdef x 0xabcdef01 0x";
+    palex::ShardedTestLexer lexer(input);
+    do {
+        lexer.next_unignored_token();
+        std::cout << lexer.current_token() << std::endl;
+    } while (!lexer.end());
+    return 0;
+}
\ No newline at end of file
@@ -0,0 +1,34 @@
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include <NonassocTestParser.h>
+
+class ComparisonBuilder : public first::NonassocTestASTBuilderBase {
+    public:
+        std::vector<std::string> operands;
+
+        void shift_token(const first::NonassocTestToken to_shift) override {
+            if (to_shift.type == first::NonassocTestToken::TokenType::INT) {
+                this->operands.push_back(std::string(to_shift.identifier));
+            }
+        }
+        void reduce_expr_less(const size_t child_count) override {
+            const std::string right = this->operands.back();
+            this->operands.pop_back();
+            this->operands.back() = "(" + this->operands.back() + "<" + right + ")";
+        }
+        void reduce_expr_int(const size_t child_count) override {}
+};
+
+std::string parse_comparison(const std::string_view input) {
+    first::NonassocTestLexer lexer(input);
+    ComparisonBuilder builder;
+    first::NonassocTestBasicParser<first::NonassocTestLexer, first::NonassocTestASTBuilderBase> parser(
+        builder, 
+        lexer, 
+        first::make_default_parse_error_handler("input", input)
+    );
+    parser.parse();
+    return builder.operands.back();
+}
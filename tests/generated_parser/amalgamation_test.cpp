@@ -0,0 +1,55 @@
+#include <string>
+#include <string_view>
+#include <sstream>
+#include <stdexcept>
+
+// both amalgamated headers are included into the same file, the first one is also used in another translation unit
+#include <NonassocTestParser.h>
+#include <SumTestParser.h>
+
+#include "../test_utils.h"
+
+std::string parse_comparison(const std::string_view input); // amalgamation_second_unit.cpp
+
+class SumBuilder : public second::SumTestASTBuilderBase {
+    public:
+        size_t sum = 0;
+
+        void shift_token(const second::SumTestToken to_shift) override {
+            if (to_shift.type == second::SumTestToken::TokenType::INT) {
+                this->sum += std::stoul(std::string(to_shift.identifier));
+            }
+        }
+        void reduce_sum_add(const size_t child_count) override {}
+        void reduce_sum_int(const size_t child_count) override {}
+};
+
+size_t parse_sum(const std::string_view input) {
+    second::SumTestLexer lexer(input);
+    SumBuilder builder;
+    second::SumTestBasicParser<second::SumTestLexer, second::SumTestASTBuilderBase> parser(
+        builder, 
+        lexer, 
+        second::make_default_parse_error_handler("input", input)
+    );
+    parser.parse();
+    return builder.sum;
+}
+
+std::string lex_comparison(const std::string_view input) {
+    first::NonassocTestLexer lexer(input);
+    std::stringstream token_types;
+    while (lexer.next_unignored_token() != first::NonassocTestToken::TokenType::END_OF_FILE) {
+        token_types << lexer.current_token().type << " ";
+    }
+    return token_types.str();
+}
+
+int main() {
+    TEST_TRUE(parse_sum("1 + 2 + 3") == 6)
+    TEST_EXCEPT(parse_sum("1 +"), std::runtime_error)
+    TEST_TRUE(lex_comparison("1 < 2") == "INT LT INT ")
+    TEST_TRUE(parse_comparison("1<2") == "(1<2)")
+    TEST_EXCEPT(parse_comparison("1<2<3"), std::runtime_error)
+    return 0;
+}
@@ -0,0 +1,50 @@
+function (create_parser_test TEST_NAME TEST_SRC PALEX_RULEFILE ADDITIONAL_FLAGS)
+    get_filename_component(NAME ${PALEX_RULEFILE} NAME_WLE)
+    set(OUTPUT_PATH ${CMAKE_CURRENT_BINARY_DIR}/${TEST_NAME}) # each test gets its own folder, as the file names only depend on the rule file
+    set(PARSER_FILES
+        ${OUTPUT_PATH}/${NAME}Lexer.h
+        ${OUTPUT_PATH}/${NAME}Lexer.cpp
+        ${OUTPUT_PATH}/${NAME}Token.h
+        ${OUTPUT_PATH}/${NAME}Token.cpp
+        ${OUTPUT_PATH}/${NAME}Parser.h
+        ${OUTPUT_PATH}/${NAME}Parser.cpp
+        ${OUTPUT_PATH}/${NAME}ASTBuilderBase.h
+    )
+    add_custom_command(
+        OUTPUT ${PARSER_FILES}
+        COMMAND ${CMAKE_COMMAND} -E make_directory ${OUTPUT_PATH}
+        COMMAND ${CMAKE_BINARY_DIR}/palex ${PALEX_RULEFILE} -lang c++ -output-path ${OUTPUT_PATH} --lexer --parser ${ADDITIONAL_FLAGS}
+        WORKING_DIRECTORY ${CMAKE_CURRENT_BINARY_DIR}
+        COMMENT "Generating ${PARSER_FILES}"
+        DEPENDS ${PALEX_RULEFILE} ${CMAKE_BINARY_DIR}/palex
+    )
+    add_executable(${TEST_NAME} ${TEST_SRC} ${PARSER_FILES})
+    target_include_directories(${TEST_NAME} PRIVATE ${CMAKE_CURRENT_LIST_DIR} ${CMAKE_SOURCE_DIR}/src ${CMAKE_SOURCE_DIR}/src/util ${OUTPUT_PATH})
+    target_link_libraries(${TEST_NAME} palex_objects lexer_autogen)
+    add_test(NAME ${TEST_NAME} COMMAND ${TEST_NAME})
+endfunction()
+
+function (add_amalgamated_parser TEST_NAME PALEX_RULEFILE MODULE_NAME ADDITIONAL_FLAGS)
+    get_filename_component(NAME ${PALEX_RULEFILE} NAME_WLE)
+    set(OUTPUT_PATH ${CMAKE_CURRENT_BINARY_DIR}/${TEST_NAME}/${NAME})
+    set(PARSER_FILES ${OUTPUT_PATH}/${NAME}Lexer.h ${OUTPUT_PATH}/${NAME}Parser.h)
+    add_custom_command(
+        OUTPUT ${PARSER_FILES}
+        COMMAND ${CMAKE_COMMAND} -E make_directory ${OUTPUT_PATH}
+        COMMAND ${CMAKE_BINARY_DIR}/palex ${PALEX_RULEFILE} -lang c++ -output-path ${OUTPUT_PATH} -module-name ${MODULE_NAME} --lexer --parser --amalgamate ${ADDITIONAL_FLAGS}
+        WORKING_DIRECTORY ${CMAKE_CURRENT_BINARY_DIR}
+        COMMENT "Generating ${PARSER_FILES}"
+        DEPENDS ${PALEX_RULEFILE} ${CMAKE_BINARY_DIR}/palex
+    )
+    target_sources(${TEST_NAME} PRIVATE ${PARSER_FILES})
+    target_include_directories(${TEST_NAME} PRIVATE ${OUTPUT_PATH})
+endfunction()
+
+# the amalgamated headers are self-contained, so the test doesn't link against the utf8 library
+function (create_amalgamation_test TEST_NAME TEST_SRCS FIRST_RULEFILE SECOND_RULEFILE ADDITIONAL_FLAGS)
+    add_executable(${TEST_NAME} ${TEST_SRCS})
+    target_include_directories(${TEST_NAME} PRIVATE ${CMAKE_CURRENT_LIST_DIR})
+    add_amalgamated_parser(${TEST_NAME} ${FIRST_RULEFILE} first "${ADDITIONAL_FLAGS}")
+    add_amalgamated_parser(${TEST_NAME} ${SECOND_RULEFILE} second "${ADDITIONAL_FLAGS}")
+    add_test(NAME ${TEST_NAME} COMMAND ${TEST_NAME})
+endfunction()
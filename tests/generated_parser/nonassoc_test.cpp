@@ -0,0 +1,49 @@
+#include <string>
+#include <string_view>
+#include <vector>
+#include <stdexcept>
+
+#include <NonassocTestLexer.h>
+#include <NonassocTestParser.h>
+#include <NonassocTestASTBuilderBase.h>
+
+#include "../test_utils.h"
+
+class ExpressionBuilder : public palex::NonassocTestASTBuilderBase {
+    public:
+        std::vector<std::string> operands;
+
+        void shift_token(const palex::NonassocTestToken to_shift) override {
+            if (to_shift.type == palex::NonassocTestToken::TokenType::INT) {
+                this->operands.push_back(std::string(to_shift.identifier));
+            }
+        }
+        void reduce_expr_less(const size_t child_count) override { this->combine("<"); }
+        void reduce_expr_int(const size_t child_count) override {}
+    private:
+        void combine(const std::string& operator_token) {
+            const std::string right = this->operands.back();
+            this->operands.pop_back();
+            this->operands.back() = "(" + this->operands.back() + operator_token + right + ")";
+        }
+};
+
+std::string parse(const std::string_view input) {
+    palex::NonassocTestLexer lexer(input);
+    ExpressionBuilder builder;
+    palex::NonassocTestBasicParser<palex::NonassocTestLexer, palex::NonassocTestASTBuilderBase> parser(
+        builder, 
+        lexer, 
+        palex::make_default_parse_error_handler("input", input)
+    );
+    parser.parse();
+    return builder.operands.back();
+}
+
+int main() {
+    TEST_TRUE(parse("1<2") == "(1<2)")
+    // non-associative operators must not follow each other, even though the state could reduce without the lookahead
+    TEST_EXCEPT(parse("1<2<3"), std::runtime_error)
+    TEST_EXCEPT(parse("1<2<3<4"), std::runtime_error)
+    return 0;
+}
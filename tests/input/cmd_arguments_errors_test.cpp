@@ -10,6 +10,9 @@ int main() {
     const char* unknown_flag[] = {"palex", "--unknown-flag"};
     const char* invalid_module[] = {"palex", "-module-name", "99Invalid$Name"};
     const char* invalid_number[] = {"palex", "-lookahead", "ff6"};
+    const char* no_shards[] = {"palex", "-shards", "0"};
+    const char* no_stack_growth[] = {"palex", "-stack-growth", "1"};
+    const char* invalid_threads[] = {"palex", "-threads", "many"};
     const char* invalid_parser_type[] = {"palex", "--parser-type", "UNKNOWN"};
     const char* invalid_language[] = {"palex", "--lang", "UNKNOWN_LANG"};
     TEST_EXCEPT(input::parse_config_from_args(sizeof(unknown_option) / sizeof(const char*), unknown_option), palex_except::ParserError)
@@ -17,6 +20,9 @@ int main() {
     TEST_EXCEPT(input::parse_config_from_args(sizeof(unknown_flag) / sizeof(const char*), unknown_flag), palex_except::ParserError)
     TEST_EXCEPT(input::parse_config_from_args(sizeof(invalid_module) / sizeof(const char*), invalid_module), palex_except::ParserError)
     TEST_EXCEPT(input::parse_config_from_args(sizeof(invalid_number) / sizeof(const char*), invalid_number), palex_except::ParserError)
+    TEST_EXCEPT(input::parse_config_from_args(sizeof(no_shards) / sizeof(const char*), no_shards), palex_except::ParserError)
+    TEST_EXCEPT(input::parse_config_from_args(sizeof(no_stack_growth) / sizeof(const char*), no_stack_growth), palex_except::ParserError)
+    TEST_EXCEPT(input::parse_config_from_args(sizeof(invalid_threads) / sizeof(const char*), invalid_threads), palex_except::ParserError)
     TEST_EXCEPT(input::parse_config_from_args(sizeof(invalid_parser_type) / sizeof(const char*), invalid_parser_type), palex_except::ParserError)
     TEST_EXCEPT(input::parse_config_from_args(sizeof(invalid_language) / sizeof(const char*), invalid_language), palex_except::ParserError)
     return 0;
@@ -17,6 +17,14 @@ int main() {
         "../util",
         "-module-name",
         "a_module",
+        "-shards",
+        "4",
+        "-stack-capacity",
+        "0",
+        "-threads",
+        "3",
+        "-cache-path",
+        "palex_cache",
         "-output-path",
         ".",
         "-parser-type",
@@ -31,12 +39,29 @@ int main() {
     TEST_TRUE(config.output_path == ".")
     TEST_TRUE(config.util_output_path == "../util")
     TEST_TRUE(config.module_name == "a_module")
+    TEST_TRUE(config.cache_path == "palex_cache")
     TEST_TRUE(config.language == input::Language::CPP)
     TEST_TRUE(config.parser_type == input::ParserType::LALR)
     TEST_TRUE(config.lookahead == 0)
+    TEST_TRUE(config.shard_count == 4)
+    TEST_TRUE(config.stack_capacity == 0)
+    TEST_TRUE(config.stack_growth_factor == 2)
+    TEST_TRUE(config.thread_count == 3)
     TEST_TRUE(config.generate_lexer)
     TEST_FALSE(config.generate_util)
     TEST_TRUE(config.generate_parser)
     TEST_FALSE(config.lexer_fallback)
+    TEST_FALSE(config.lexer_counters)
+    TEST_FALSE(config.amalgamate)
+    TEST_FALSE(config.table_driven_parser)
+    TEST_FALSE(config.adaptive_lookahead)
+
+    const char* pgm_argv[] = {"palex", "-parser-type", "pgm"};
+    TEST_TRUE(input::parse_config_from_args(sizeof(pgm_argv) / sizeof(const char*), pgm_argv).parser_type == input::ParserType::PGM)
+
+    const char* adaptive_argv[] = {"palex", "-lookahead", "3", "--adaptive-lookahead"};
+    const input::PalexConfig adaptive_config = input::parse_config_from_args(sizeof(adaptive_argv) / sizeof(const char*), adaptive_argv);
+    TEST_TRUE(adaptive_config.adaptive_lookahead)
+    TEST_TRUE(adaptive_config.lookahead == 3)
     return 0;
 }
\ No newline at end of file
@@ -8,9 +8,11 @@ int main() {
     const char* input =
         "!WSPACE = \"\\s+\";\n"
         "<7>ANOTHER_1 = \"\";\n"
+        "%nonassoc ANOTHER_1;\n"
         "$S = some_prod;\n"
         "some_prod = ANOTHER_1 some_prod;\n"
         "some_prod#production_tag = ;\n"
+        "%transparent other_prod = some_prod;\n"
         ;
     bootstrap::BootstrapLexer lexer(input);
 
@@ -26,6 +28,11 @@ int main() {
     TEST_TRUE(lexer.next_unignored_token() == bootstrap::TokenInfo::TokenType::REGEX)
     TEST_TRUE(lexer.next_unignored_token() == bootstrap::TokenInfo::TokenType::EOL)
 
+    TEST_TRUE(lexer.next_unignored_token() == bootstrap::TokenInfo::TokenType::PRECEDENCE)
+    TEST_TRUE(lexer.get_token().identifier == "%nonassoc")
+    TEST_TRUE(lexer.next_unignored_token() == bootstrap::TokenInfo::TokenType::TOKEN)
+    TEST_TRUE(lexer.next_unignored_token() == bootstrap::TokenInfo::TokenType::EOL)
+
     TEST_TRUE(lexer.next_unignored_token() == bootstrap::TokenInfo::TokenType::ENTRY_PRODUCTION)
     TEST_TRUE(lexer.next_unignored_token() == bootstrap::TokenInfo::TokenType::EQ)
     TEST_TRUE(lexer.next_unignored_token() == bootstrap::TokenInfo::TokenType::PRODUCTION)
@@ -41,5 +48,11 @@ int main() {
     TEST_TRUE(lexer.next_unignored_token() == bootstrap::TokenInfo::TokenType::PRODUCTION_TAG)
     TEST_TRUE(lexer.next_unignored_token() == bootstrap::TokenInfo::TokenType::EQ)
     TEST_TRUE(lexer.next_unignored_token() == bootstrap::TokenInfo::TokenType::EOL)
+
+    TEST_TRUE(lexer.next_unignored_token() == bootstrap::TokenInfo::TokenType::TRANSPARENT)
+    TEST_TRUE(lexer.next_unignored_token() == bootstrap::TokenInfo::TokenType::PRODUCTION)
+    TEST_TRUE(lexer.next_unignored_token() == bootstrap::TokenInfo::TokenType::EQ)
+    TEST_TRUE(lexer.next_unignored_token() == bootstrap::TokenInfo::TokenType::PRODUCTION)
+    TEST_TRUE(lexer.next_unignored_token() == bootstrap::TokenInfo::TokenType::EOL)
     return 0;
 }
\ No newline at end of file
@@ -14,7 +14,10 @@ int main() {
     const std::vector<std::string> faulty_grammars = {
         "production = ; TOKEN = \"a\";",    // token after production
         "production = A",                   // missing ; at end of production
-        "AVv = \"f\";"                      // invalid token
+        "AVv = \"f\";",                     // invalid token
+        "production = ; %left A;",          // precedence declaration after production
+        "%left A; %right A;",               // token with two precedences
+        "%left ;"                           // precedence declaration without tokens
     };
 
     for (const std::string& faulty_grammar : faulty_grammars) {
@@ -26,5 +29,14 @@ int main() {
         std::cout << faulty_grammar << std::endl;
         TEST_EXCEPT(parser.parse_all_rules(), palex_except::ParserError)
     }
+
+    // a misspelled token in a precedence declaration would leave the conflicts of the actual token unresolved
+    const std::string undefined_precedence_token = "LT = \"<\"; %nonassoc LTX; $S = S LT S;";
+    bootstrap::BootstrapLexer lexer(undefined_precedence_token.c_str());
+    input::PalexRuleParser parser(
+        std::bind(&bootstrap::BootstrapLexer::next_unignored_token, &lexer),
+        std::bind(&bootstrap::BootstrapLexer::get_token, &lexer)
+    );
+    TEST_EXCEPT(parser.parse_all_rules(), palex_except::ValidationError)
     return 0;
 }
\ No newline at end of file
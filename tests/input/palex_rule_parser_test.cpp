@@ -10,9 +10,14 @@ int main() {
     const char* input = 
         "!WSPACE = \"\\s+\";\n"
         "!<7>ANOTHER_1 = \"a\";\n"
+        "ANOTHER_2 = \"b\";\n"
+        "ANOTHER_3 = \"c\";\n"
+        "%left ANOTHER_1 ANOTHER_2;\n"
+        "%right ANOTHER_3;\n"
         "$S = some_prod;\n"
         "some_prod = ANOTHER_1 some_prod;\n"
         "some_prod#production_tag = ;\n"
+        "%transparent other_prod = some_prod;\n"
     ;
     bootstrap::BootstrapLexer lexer(input);
     input::PalexRuleParser parser(
@@ -21,15 +26,21 @@ int main() {
     );
     const input::PalexRules palex_rules = parser.parse_all_rules();
     
-    TEST_TRUE(palex_rules.token_definitions.size() == 2)
+    TEST_TRUE(palex_rules.token_definitions.size() == 4)
     TEST_TRUE(palex_rules.token_definitions[0].ignore_token)
     TEST_TRUE(palex_rules.token_definitions[1].ignore_token)
+    TEST_FALSE(palex_rules.token_definitions[2].ignore_token)
     TEST_TRUE(palex_rules.token_definitions[0].name == "WSPACE")
     TEST_TRUE(palex_rules.token_definitions[1].name == "ANOTHER_1")
     TEST_TRUE(palex_rules.token_definitions[0].priority == palex_rules.token_definitions[0].token_regex->get_priority())
     TEST_TRUE(palex_rules.token_definitions[1].priority == 7)
 
-    TEST_TRUE(palex_rules.productions.size() == 3)
+    TEST_TRUE(palex_rules.precedence_table.size() == 3)
+    TEST_TRUE((palex_rules.precedence_table.at("ANOTHER_1") == parser_generator::OperatorPrecedence{0, parser_generator::Associativity::LEFT}))
+    TEST_TRUE((palex_rules.precedence_table.at("ANOTHER_2") == parser_generator::OperatorPrecedence{0, parser_generator::Associativity::LEFT}))
+    TEST_TRUE((palex_rules.precedence_table.at("ANOTHER_3") == parser_generator::OperatorPrecedence{1, parser_generator::Associativity::RIGHT}))
+
+    TEST_TRUE(palex_rules.productions.size() == 4)
     TEST_TRUE(palex_rules.productions[0].is_entry())
     TEST_TRUE(palex_rules.productions[0].symbols.size() == 1)
     TEST_TRUE(palex_rules.productions[1].name == "some_prod")
@@ -37,5 +48,8 @@ int main() {
     TEST_TRUE(palex_rules.productions[2].name == "some_prod")
     TEST_TRUE(palex_rules.productions[2].tag == "production_tag")
     TEST_TRUE(palex_rules.productions[2].symbols.empty())
+    TEST_FALSE(palex_rules.productions[2].transparent)
+    TEST_TRUE(palex_rules.productions[3].name == "other_prod")
+    TEST_TRUE(palex_rules.productions[3].transparent)
     return 0;
 }
\ No newline at end of file
@@ -0,0 +1,146 @@
+#include <string>
+#include <string_view>
+#include <vector>
+#include <functional>
+#include <optional>
+
+#include "lexer_generator/lexer_automaton.h"
+#include "lexer_generator/token_definition.h"
+
+#include "regex/RegexParser.h"
+
+#include "../test_utils.h"
+
+struct TestCase {
+    std::string_view regex;
+    size_t position_count;
+    bool nullable;
+    std::vector<std::string> inputs;
+};
+
+using lexer_generator::LexerAutomaton_t;
+
+std::string match(const LexerAutomaton_t& dfa, const std::string& input);
+LexerAutomaton_t to_dfa(const LexerAutomaton_t& nfa, const std::vector<lexer_generator::TokenDefinition>& rules);
+bool is_epsilon_free(const LexerAutomaton_t& nfa);
+
+std::string match(const LexerAutomaton_t& dfa, const std::string& input) {
+    LexerAutomaton_t::StateID_t state = 0;
+    for (const char curr : input) {
+        std::optional<LexerAutomaton_t::StateID_t> next_state = std::nullopt;
+        for (const LexerAutomaton_t::ConnectionID_t connection : dfa.get_outgoing_connection_ids(state)) {
+            for (const regex::CharRange& range : dfa.get_connection(connection).value.value().get_ranges()) {
+                if (range.start <= (utf8::Codepoint_t)curr && (utf8::Codepoint_t)curr <= range.end) {
+                    next_state = dfa.get_connection(connection).target;
+                }
+            }
+        }
+        if (!next_state.has_value()) {
+            return "";
+        }
+        state = next_state.value();
+    }
+    return dfa.get_state(state);
+}
+
+LexerAutomaton_t to_dfa(const LexerAutomaton_t& nfa, const std::vector<lexer_generator::TokenDefinition>& rules) {
+    using namespace std::placeholders;
+
+    return nfa.convert_to_dfa<std::string>(
+        0,
+        std::bind(lexer_generator::merge_states_by_priority, lexer_generator::get_token_priorities(rules), _1),
+        lexer_generator::resolve_connection_collisions
+    );
+}
+
+bool is_epsilon_free(const LexerAutomaton_t& nfa) {
+    for (const auto& [state_id, _] : nfa.get_states()) {
+        for (const LexerAutomaton_t::ConnectionID_t connection : nfa.get_outgoing_connection_ids(state_id)) {
+            if (nfa.get_connection(connection).type == LexerAutomaton_t::Connection::ConnectionType::EPSILON) {
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+int main() {
+    const std::vector<TestCase> TEST_CASES = {
+        {"abc", 3, false, {"", "a", "ab", "abc", "abcc", "b"}},
+        {"ab|c", 3, false, {"", "ab", "c", "a", "abc", "cc"}},
+        {"(ab)*", 2, true, {"", "ab", "abab", "aba", "b"}},
+        {"a+b?", 3, false, {"", "a", "aaa", "ab", "aab", "abb", "b"}},
+        {"(a|b?)c{2,4}", 6, false, {"cc", "acc", "bcccc", "ccccc", "c", "abcc", "bccc"}},
+        {"x{0,3}y", 4, false, {"y", "xy", "xxxy", "xxxxy", "x"}},
+        {"(a*b*)*c", 3, false, {"c", "abc", "bbac", "aabbaac", "ab", "ca"}},
+        {"[0-9]{2,}", 3, false, {"1", "12", "123456", "12a"}},
+        {"a*a*", 2, true, {"", "a", "aa", "aaa", "b"}},          // both positions are last positions of the rule
+        {"(ab|a)b?", 4, false, {"a", "ab", "abb", "abbb", "b"}}
+    };
+
+    for (const TestCase& test : TEST_CASES) {
+        std::vector<lexer_generator::TokenDefinition> rules;
+        rules.push_back(lexer_generator::TokenDefinition{false, 1, "TOKEN", regex::RegexParser(test.regex).parse_regex()});
+
+        LexerAutomaton_t position_nfa{};
+        const LexerAutomaton_t::StateID_t position_root = position_nfa.add_state("");
+        TEST_TRUE(lexer_generator::insert_rule_in_position_nfa(position_nfa, position_root, rules.front()) == test.nullable)
+        if (test.nullable) {
+            position_nfa.get_state(position_root) = "TOKEN";
+        }
+        TEST_TRUE(is_epsilon_free(position_nfa))
+        TEST_TRUE(position_nfa.get_states().size() == test.position_count + 1)
+
+        LexerAutomaton_t thompson_nfa{};
+        const LexerAutomaton_t::StateID_t thompson_root = thompson_nfa.add_state("");
+        lexer_generator::insert_rule_in_nfa(thompson_nfa, thompson_root, rules.front());
+
+        const LexerAutomaton_t position_dfa = to_dfa(position_nfa, rules);
+        const LexerAutomaton_t thompson_dfa = to_dfa(thompson_nfa, rules);
+        for (const std::string& input : test.inputs) {
+            TEST_TRUE(match(position_dfa, input) == match(thompson_dfa, input))
+        }
+    }
+
+    std::vector<lexer_generator::TokenDefinition> keyword_rules;
+    keyword_rules.push_back(lexer_generator::TokenDefinition{false, 3, "I", regex::RegexParser("i").parse_regex()});
+    keyword_rules.push_back(lexer_generator::TokenDefinition{false, 4, "IF", regex::RegexParser("if").parse_regex()});
+    keyword_rules.push_back(lexer_generator::TokenDefinition{false, 6, "INT", regex::RegexParser("int").parse_regex()});
+    keyword_rules.push_back(lexer_generator::TokenDefinition{false, 1, "IDENT", regex::RegexParser("i[a-z]*").parse_regex()});
+    keyword_rules.push_back(lexer_generator::TokenDefinition{false, 0, "EMPTY", regex::RegexParser("x?").parse_regex()});
+
+    LexerAutomaton_t shared_nfa{};
+    lexer_generator::insert_rules_in_position_nfa(shared_nfa, shared_nfa.add_state(""), keyword_rules);
+    TEST_TRUE(is_epsilon_free(shared_nfa))
+    TEST_TRUE(shared_nfa.get_states().size() == 7) // root, i, f, n, t, [a-z], x
+    TEST_TRUE(shared_nfa.get_state(0) == "EMPTY")
+
+    const LexerAutomaton_t shared_dfa = to_dfa(shared_nfa, keyword_rules);
+    const std::vector<std::pair<std::string, std::string>> KEYWORD_INPUTS = {
+        {"", "EMPTY"}, {"x", "EMPTY"}, {"i", "I"}, {"if", "IF"}, {"in", "IDENT"}, {"int", "INT"}, {"ifs", "IDENT"}, {"a", ""}
+    };
+    for (const auto& [input, expected] : KEYWORD_INPUTS) {
+        TEST_TRUE(match(shared_dfa, input) == expected)
+    }
+
+    std::vector<lexer_generator::TokenDefinition> repetition_rules;
+    repetition_rules.push_back(lexer_generator::TokenDefinition{false, 1, "HEX", regex::RegexParser("[0-9a-f]{1,64}").parse_regex()});
+    repetition_rules.push_back(lexer_generator::TokenDefinition{false, 2, "PAIR", regex::RegexParser("xc|yc").parse_regex()});
+
+    LexerAutomaton_t repetition_nfa{};
+    lexer_generator::insert_rules_in_position_nfa(repetition_nfa, repetition_nfa.add_state(""), repetition_rules);
+    const LexerAutomaton_t repetition_dfa = to_dfa(repetition_nfa, repetition_rules);
+    const LexerAutomaton_t minimized_dfa = lexer_generator::minimize_dfa(repetition_dfa);
+    TEST_TRUE(repetition_dfa.get_states().size() == 69)
+    TEST_TRUE(minimized_dfa.get_states().size() == 67)
+    for (const std::string& input : std::vector<std::string>{"", "0", "af09", std::string(64, 'f'), std::string(65, 'f'), "xc", "yc", "x"}) {
+        TEST_TRUE(match(minimized_dfa, input) == match(repetition_dfa, input))
+    }
+
+    const lexer_generator::CountedRepetitions_t repetitions = lexer_generator::find_counted_repetitions(minimized_dfa);
+    TEST_TRUE(repetitions.size() == 1)
+    TEST_TRUE(repetitions.begin()->second.states.size() == 64)
+    TEST_TRUE(match(minimized_dfa, "0") == minimized_dfa.get_state(repetitions.begin()->first))
+
+    return 0;
+}
@@ -9,6 +9,7 @@
 #include "input/PalexRuleParser.h"
 
 #include "parser_generator/validation.h"
+#include "parser_generator/symbol_table.h"
 
 #include "parser_generator/shift_reduce_parsers/parser_table_generation.h"
 #include "parser_generator/shift_reduce_parsers/parser_state.h"
@@ -27,5 +28,11 @@ int main() {
     parser_generator::validate_productions(productions);
 
     TEST_EXCEPT(parser_generator::shift_reduce_parsers::generate_first_set(std::set(productions.begin(), productions.end()), 1), palex_except::ValidationError);
+    TEST_EXCEPT(
+        parser_generator::shift_reduce_parsers::generate_terminal_first_set(
+            parser_generator::SymbolTable(std::set(productions.begin(), productions.end()))
+        ),
+        palex_except::ValidationError
+    );
     return 0;
 }
\ No newline at end of file
@@ -7,6 +7,7 @@
 
 #include "input/PalexRuleParser.h"
 #include "parser_generator/validation.h"
+#include "parser_generator/symbol_table.h"
 
 #include "parser_generator/shift_reduce_parsers/parser_table_generation.h"
 #include "parser_generator/shift_reduce_parsers/parser_state.h"
@@ -64,5 +65,57 @@ int main() {
 
     const parser_generator::shift_reduce_parsers::FirstSet_t first_set = parser_generator::shift_reduce_parsers::generate_first_set(productions_set, 3);
     TEST_TRUE(first_set == FIRST_SET_3);
+
+    // the bitset first set for a single terminal has to agree with the general one
+    const parser_generator::SymbolTable symbol_table(productions_set);
+    const parser_generator::shift_reduce_parsers::FirstSet_t first_set_1 = parser_generator::shift_reduce_parsers::generate_first_set(productions_set, 1);
+    const parser_generator::shift_reduce_parsers::TerminalFirstSet terminal_first_set = parser_generator::shift_reduce_parsers::generate_terminal_first_set(symbol_table);
+    for (const auto& [nonterminal, first_terminals] : first_set_1) {
+        const parser_generator::SymbolID_t nonterminal_id = symbol_table.get_symbol_id(
+            parser_generator::Symbol{parser_generator::Symbol::SymbolType::NONTERMINAL, nonterminal}
+        );
+        TEST_FALSE(terminal_first_set.nullable[nonterminal_id]);
+        for (parser_generator::SymbolID_t terminal_id = 0; terminal_id < symbol_table.get_terminal_count(); terminal_id++) {
+            TEST_TRUE(
+                parser_generator::shift_reduce_parsers::contains_terminal(terminal_first_set.first_terminals[nonterminal_id], terminal_id)
+                == (first_terminals.find(Lookahead_t{symbol_table.get_symbol(terminal_id)}) != first_terminals.end())
+            );
+        }
+    }
+
+    const char* nullable_input =
+        "list = ;"
+        "list = list item;"
+        "item = INT;"
+        "item = LP list RP;"
+        "$S = list;"
+    ;
+    bootstrap::BootstrapLexer nullable_lexer(nullable_input);
+    input::PalexRuleParser nullable_parser(
+        std::bind(&bootstrap::BootstrapLexer::next_unignored_token, &nullable_lexer),
+        std::bind(&bootstrap::BootstrapLexer::get_token, &nullable_lexer)
+    );
+    std::vector<parser_generator::Production> nullable_productions = nullable_parser.parse_all_productions();
+    parser_generator::validate_productions(nullable_productions);
+    const parser_generator::SymbolTable nullable_symbol_table(std::set<parser_generator::Production>(nullable_productions.begin(), nullable_productions.end()));
+    const parser_generator::shift_reduce_parsers::TerminalFirstSet nullable_first_set = parser_generator::shift_reduce_parsers::generate_terminal_first_set(
+        nullable_symbol_table
+    );
+    const parser_generator::SymbolID_t list_id = nullable_symbol_table.get_symbol_id(
+        parser_generator::Symbol{parser_generator::Symbol::SymbolType::NONTERMINAL, "list"}
+    );
+    const parser_generator::SymbolID_t item_id = nullable_symbol_table.get_symbol_id(
+        parser_generator::Symbol{parser_generator::Symbol::SymbolType::NONTERMINAL, "item"}
+    );
+    TEST_TRUE(nullable_first_set.nullable[list_id]);
+    TEST_FALSE(nullable_first_set.nullable[item_id]);
+    TEST_TRUE(parser_generator::shift_reduce_parsers::contains_terminal(
+        nullable_first_set.first_terminals[list_id],
+        nullable_symbol_table.get_symbol_id(TERMINAL("LP"))
+    ));
+    TEST_FALSE(parser_generator::shift_reduce_parsers::contains_terminal(
+        nullable_first_set.first_terminals[list_id],
+        nullable_symbol_table.get_symbol_id(TERMINAL("RP"))
+    ));
     return 0;
 }
\ No newline at end of file
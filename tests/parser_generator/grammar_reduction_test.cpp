@@ -0,0 +1,145 @@
+#include <functional>
+#include <cstddef>
+#include <set>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "util/palex_except.h"
+
+#include "bootstrap/BootstrapLexer.h"
+
+#include "input/PalexRuleParser.h"
+
+#include "parser_generator/validation.h"
+#include "parser_generator/production_definition.h"
+#include "parser_generator/grammar_reduction.h"
+
+#include "parser_generator/shift_reduce_parsers/parser_table_generation.h"
+#include "parser_generator/shift_reduce_parsers/parser_state_comparators.h"
+
+#include "../test_utils.h"
+
+std::vector<parser_generator::Production> parse_productions(const char* input) {
+    bootstrap::BootstrapLexer lexer(input);
+    input::PalexRuleParser parser(
+        std::bind(&bootstrap::BootstrapLexer::next_unignored_token, &lexer),
+        std::bind(&bootstrap::BootstrapLexer::get_token, &lexer)
+    );
+    const std::vector<parser_generator::Production> productions = parser.parse_all_productions();
+    parser_generator::validate_productions(productions);
+    return productions;
+}
+
+std::set<std::string> collect_names(const std::vector<parser_generator::Production>& productions) {
+    std::set<std::string> names;
+    for (const parser_generator::Production& production : productions) {
+        names.insert(production.name);
+    }
+    return names;
+}
+
+int main() {
+    using parser_generator::shift_reduce_parsers::DebugParseTree;
+    using parser_generator::shift_reduce_parsers::ParserTable;
+    using parser_generator::shift_reduce_parsers::lalr_state_compare;
+
+    const std::vector<parser_generator::Production> productions = parse_productions(
+        "$S = statement;"
+        "statement = IF condition THEN statement;"
+        "statement = value;"
+        "%transparent condition = conjunction;"
+        "conjunction = conjunction AND value;"
+        "conjunction = value;"
+        "value = INT;"
+        "loop = loop statement;"     // unproductive, the recursion never ends
+        "broken = loop INT;"         // unproductive, as it uses an unproductive nonterminal
+        "unused = value ADD value;"  // unreachable
+        "unused_part = INT;"         // only reachable from the unreachable nonterminal
+        "unused = unused_part;"
+    );
+    const parser_generator::GrammarReduction reduction = parser_generator::reduce_grammar(productions);
+    const std::set<std::string> unproductive = {"broken", "loop"};
+    const std::set<std::string> unreachable = {"unused", "unused_part"};
+    const std::set<std::string> inlined = {"condition"};
+    const std::set<std::string> remaining = {"$S", "statement", "conjunction", "value"};
+    TEST_TRUE(reduction.unproductive_nonterminals == unproductive)
+    TEST_TRUE(reduction.unreachable_nonterminals == unreachable)
+    TEST_TRUE(reduction.inlined_nonterminals == inlined)
+    TEST_TRUE(collect_names(reduction.productions) == remaining)
+    TEST_TRUE(reduction.productions.size() == 6)
+    TEST_TRUE(reduction.productions[1].symbols[1].identifier == "conjunction") // the user keeps its position
+    parser_generator::validate_productions(reduction.productions);
+
+    std::stringstream report;
+    report << reduction;
+    TEST_TRUE(report.str() ==
+        "Removed the unproductive nonterminal 'broken'\n"
+        "Removed the unproductive nonterminal 'loop'\n"
+        "Removed the unreachable nonterminal 'unused'\n"
+        "Removed the unreachable nonterminal 'unused_part'\n"
+        "Inlined the nonterminal 'condition'\n"
+    )
+
+    // the table generation rejects the unproductive nonterminals, without them the inlined nonterminal still saves a state
+    const std::set<parser_generator::Production> productions_set(productions.begin(), productions.end());
+    TEST_EXCEPT(ParserTable::generate_lalr_1(productions_set, lalr_state_compare), palex_except::ValidationError)
+    const std::vector<parser_generator::Production> productive_productions = parse_productions(
+        "$S = statement;"
+        "statement = IF condition THEN statement;"
+        "statement = value;"
+        "%transparent condition = conjunction;"
+        "conjunction = conjunction AND value;"
+        "conjunction = value;"
+        "value = INT;"
+        "unused = value ADD value;"
+    );
+    const std::set<parser_generator::Production> productive_set(productive_productions.begin(), productive_productions.end());
+    const std::set<parser_generator::Production> reduced_set(reduction.productions.begin(), reduction.productions.end());
+    const ParserTable parser_table = ParserTable::generate_lalr_1(productive_set, lalr_state_compare);
+    const ParserTable reduced_table = ParserTable::generate_lalr_1(reduced_set, lalr_state_compare);
+    const std::vector<std::string> token_names = {"IF", "INT", "AND", "INT", "THEN", "INT"};
+    const DebugParseTree value{"value", {DebugParseTree{"INT"}}};
+    const DebugParseTree conjunction{"conjunction", {DebugParseTree{"conjunction", {value}}, DebugParseTree{"AND"}, value}};
+    const DebugParseTree reduced_tree{"$S", {DebugParseTree{"statement", {
+        DebugParseTree{"IF"}, conjunction, DebugParseTree{"THEN"}, DebugParseTree{"statement", {value}}
+    }}}};
+    TEST_TRUE(reduced_table.debug_parse(token_names) == reduced_tree)
+    TEST_TRUE(reduced_table.get_states().size() < parser_table.get_states().size())
+
+    // observed, repeatedly used and recursive nonterminals stay
+    const std::vector<parser_generator::Production> minimal_productions = parse_productions(
+        "$S = list;"
+        "list = list item;"
+        "list = item;"
+        "%transparent item = value;"
+        "%transparent item = pair;"
+        "pair = LP value value RP;"
+        "value = INT;"
+    );
+    const parser_generator::GrammarReduction minimal_reduction = parser_generator::reduce_grammar(minimal_productions);
+    TEST_TRUE(minimal_reduction.productions == minimal_productions)
+    TEST_TRUE(minimal_reduction.unproductive_nonterminals.empty())
+    TEST_TRUE(minimal_reduction.unreachable_nonterminals.empty())
+    TEST_TRUE(minimal_reduction.inlined_nonterminals.empty())
+
+    // chains of single-use nonterminals get inlined completely
+    const std::vector<parser_generator::Production> chain_productions = parse_productions(
+        "$S = block;"
+        "block = LB content RB;"
+        "%transparent content = entries;"
+        "%transparent entries = pair;"
+        "%transparent entries = int_value;"
+        "pair = KEY COLON INT;"
+        "int_value = INT;"
+    );
+    const parser_generator::GrammarReduction chain_reduction = parser_generator::reduce_grammar(chain_productions);
+    const std::set<std::string> chain_inlined = {"content", "entries"};
+    TEST_TRUE(chain_reduction.inlined_nonterminals == chain_inlined)
+    TEST_TRUE(chain_reduction.productions.size() == 5)
+    TEST_TRUE(chain_reduction.productions[1].symbols[1].identifier == "pair")
+    TEST_TRUE(chain_reduction.productions[2].symbols[1].identifier == "int_value")
+
+    TEST_EXCEPT(parser_generator::reduce_grammar(parse_productions("$S = loop; loop = loop INT;")), palex_except::ValidationError)
+    return 0;
+}
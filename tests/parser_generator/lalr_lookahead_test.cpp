@@ -0,0 +1,164 @@
+#include <functional>
+#include <cstddef>
+#include <stdexcept>
+#include <map>
+#include <queue>
+#include <variant>
+#include <optional>
+#include <algorithm>
+
+#include "bootstrap/BootstrapLexer.h"
+
+#include "input/PalexRuleParser.h"
+
+#include "parser_generator/validation.h"
+#include "parser_generator/production_definition.h"
+
+#include "parser_generator/shift_reduce_parsers/parser_table_generation.h"
+#include "parser_generator/shift_reduce_parsers/parser_state_comparators.h"
+
+#include "../test_utils.h"
+
+using parser_generator::shift_reduce_parsers::Action;
+using parser_generator::shift_reduce_parsers::ParserTable;
+using parser_generator::shift_reduce_parsers::ParserStateID_t;
+
+std::set<parser_generator::Production> parse_productions(const char* input);
+bool matches_action(const Action& first, const Action& second);
+std::optional<ParserStateID_t> get_next_state(const Action& action);
+bool are_equivalent_tables(const ParserTable& first, const ParserTable& second);
+
+std::set<parser_generator::Production> parse_productions(const char* input) {
+    bootstrap::BootstrapLexer lexer(input);
+    input::PalexRuleParser parser(
+        std::bind(&bootstrap::BootstrapLexer::next_unignored_token, &lexer),
+        std::bind(&bootstrap::BootstrapLexer::get_token, &lexer)
+    );
+    const std::vector<parser_generator::Production> productions = parser.parse_all_rules().productions;
+    parser_generator::validate_productions(productions);
+    return std::set<parser_generator::Production>(productions.begin(), productions.end());
+}
+
+bool matches_action(const Action& first, const Action& second) { // equal apart from the target state
+    if (first.parameters.index() != second.parameters.index()) {
+        return false;
+    }
+    if (std::holds_alternative<Action::GotoParameters>(first.parameters)) {
+        return std::get<Action::GotoParameters>(first.parameters).reduced_symbol == std::get<Action::GotoParameters>(second.parameters).reduced_symbol;
+    }
+    if (std::holds_alternative<Action::ShiftParameters>(first.parameters)) {
+        return std::get<Action::ShiftParameters>(first.parameters).lookahead == std::get<Action::ShiftParameters>(second.parameters).lookahead;
+    }
+    return first == second;
+}
+
+std::optional<ParserStateID_t> get_next_state(const Action& action) {
+    if (std::holds_alternative<Action::GotoParameters>(action.parameters)) {
+        return std::get<Action::GotoParameters>(action.parameters).next_state;
+    }
+    if (std::holds_alternative<Action::ShiftParameters>(action.parameters)) {
+        return std::get<Action::ShiftParameters>(action.parameters).next_state;
+    }
+    return std::nullopt;
+}
+
+bool are_equivalent_tables(const ParserTable& first, const ParserTable& second) { // the same states, up to their numbering
+    if (first.get_states().size() != second.get_states().size()) {
+        return false;
+    }
+    std::map<ParserStateID_t, ParserStateID_t> state_mapping{{0, 0}};
+    std::queue<ParserStateID_t> to_check;
+    to_check.push(0);
+    while (!to_check.empty()) {
+        const ParserStateID_t first_id = to_check.front();
+        to_check.pop();
+        const ParserStateID_t second_id = state_mapping.at(first_id);
+        const auto& first_state = first.get_states()[first_id];
+        const auto& second_state = second.get_states()[second_id];
+        if (first_state.get_production_states() != second_state.get_production_states()) {
+            return false;
+        }
+        if (first_state.get_actions().size() != second_state.get_actions().size()) {
+            return false;
+        }
+        for (const Action& action : first_state.get_actions()) {
+            const auto match = std::find_if(
+                second_state.get_actions().begin(),
+                second_state.get_actions().end(),
+                std::bind(matches_action, action, std::placeholders::_1)
+            );
+            if (match == second_state.get_actions().end()) {
+                return false;
+            }
+            const std::optional<ParserStateID_t> next_state = get_next_state(action);
+            if (!next_state.has_value()) {
+                continue;
+            }
+            const auto [mapped_state, inserted] = state_mapping.insert(std::make_pair(next_state.value(), get_next_state(*match).value()));
+            if (inserted) {
+                to_check.push(next_state.value());
+            } else if (mapped_state->second != get_next_state(*match).value()) {
+                return false;
+            }
+        }
+    }
+    return state_mapping.size() == first.get_states().size();
+}
+
+int main() {
+    const std::vector<const char*> TEST_GRAMMARS = {
+        "$S = addition;\n"
+        "addition = addition ADD multiplication;\n"
+        "addition = multiplication;\n"
+        "multiplication = multiplication MUL number;\n"
+        "multiplication = number;\n"
+        "number = INT;\n",
+
+        "$S = program;\n" // nullable productions
+        "program = program statement;\n"
+        "program = ;\n"
+        "statement = IDENTIFIER EQ expression EOL;\n"
+        "expression = expression ADD value;\n"
+        "expression = value;\n"
+        "value = PARENTHESIS_OPEN expression PARENTHESIS_CLOSE;\n"
+        "value = INT;\n"
+        "value = IDENTIFIER;\n",
+
+        "$S = s;\n" // LALR(1), but not SLR(1)
+        "s = l EQ r;\n"
+        "s = r;\n"
+        "l = STAR r;\n"
+        "l = ID;\n"
+        "r = l;\n",
+
+        "$S = s;\n" // lookaheads that are only read through nullable nonterminals
+        "s = a b C;\n"
+        "s = D b;\n"
+        "a = ;\n"
+        "a = A;\n"
+        "b = ;\n"
+        "b = B a;\n"
+    };
+
+    for (const char* grammar : TEST_GRAMMARS) {
+        const std::set<parser_generator::Production> productions = parse_productions(grammar);
+        const ParserTable canonical_table = ParserTable::generate(productions, parser_generator::shift_reduce_parsers::lalr_state_compare, 1);
+        const ParserTable lalr_table = ParserTable::generate_lalr_1(productions, parser_generator::shift_reduce_parsers::lalr_state_compare);
+        TEST_TRUE(are_equivalent_tables(lalr_table, canonical_table))
+    }
+
+    const std::set<parser_generator::Production> conflicting_productions = parse_productions(
+        "$S = s;\n" // LR(1), but not LALR(1)
+        "s = A e C;\n"
+        "s = A f D;\n"
+        "s = B f C;\n"
+        "s = B e D;\n"
+        "e = E;\n"
+        "f = E;\n"
+    );
+    TEST_EXCEPT(
+        ParserTable::generate_lalr_1(conflicting_productions, parser_generator::shift_reduce_parsers::lalr_state_compare),
+        std::runtime_error
+    )
+    return 0;
+}
@@ -0,0 +1,66 @@
+#include <functional>
+#include <cstddef>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "util/palex_except.h"
+
+#include "bootstrap/BootstrapLexer.h"
+
+#include "input/PalexRuleParser.h"
+
+#include "parser_generator/validation.h"
+#include "parser_generator/production_definition.h"
+
+#include "parser_generator/shift_reduce_parsers/parser_table_generation.h"
+#include "parser_generator/shift_reduce_parsers/parser_state_comparators.h"
+
+#include "../test_utils.h"
+
+int main() {
+    using parser_generator::shift_reduce_parsers::ParserTable;
+    using parser_generator::shift_reduce_parsers::lalr_state_compare;
+    using parser_generator::shift_reduce_parsers::lalr_state_hash;
+
+    // only the reduction after ID needs a second token to tell a from b
+    const char* input =
+        "$S = list;"
+        "list = list s SEMI;"
+        "list = ;"
+        "s = a X Y;"
+        "s = b X Z;"
+        "a = ID;"
+        "b = ID;"
+    ;
+    bootstrap::BootstrapLexer lexer(input);
+    input::PalexRuleParser parser(
+        std::bind(&bootstrap::BootstrapLexer::next_unignored_token, &lexer),
+        std::bind(&bootstrap::BootstrapLexer::get_token, &lexer)
+    );
+    const std::vector<parser_generator::Production> productions = parser.parse_all_productions();
+    parser_generator::validate_productions(productions);
+    const std::set<parser_generator::Production> productions_set(productions.begin(), productions.end());
+
+    TEST_EXCEPT(ParserTable::generate(productions_set, lalr_state_compare, 1, lalr_state_hash), std::runtime_error)
+    // the adaptive lookahead only retries on conflicts, so they need their own error type
+    TEST_EXCEPT(ParserTable::generate(productions_set, lalr_state_compare, 1, lalr_state_hash), palex_except::GrammarConflictError)
+    const ParserTable parser_table = ParserTable::generate(productions_set, lalr_state_compare, 2, lalr_state_hash);
+    const ParserTable minimal_table = parser_table.with_minimal_lookaheads();
+    TEST_TRUE(parser_table.get_max_lookahead_depth() == 2)
+    TEST_TRUE(minimal_table.get_max_lookahead_depth() == 2)
+    TEST_TRUE(minimal_table.get_states().size() == parser_table.get_states().size())
+    size_t deep_state_count = 0;
+    for (size_t state_id = 0; state_id < minimal_table.get_states().size(); state_id++) {
+        TEST_TRUE(minimal_table.get_lookahead_depth(state_id) <= parser_table.get_lookahead_depth(state_id))
+        deep_state_count += minimal_table.get_lookahead_depth(state_id) == 2;
+    }
+    TEST_TRUE(deep_state_count == 1)
+
+    const std::vector<std::string> valid_input = {"ID", "X", "Y", "SEMI", "ID", "X", "Z", "SEMI"};
+    TEST_TRUE(minimal_table.debug_parse(valid_input) == parser_table.debug_parse(valid_input))
+    // the error is only detected later, but still before anything invalid gets shifted
+    const std::vector<std::string> invalid_input = {"ID", "X", "SEMI"};
+    TEST_EXCEPT(minimal_table.debug_parse(invalid_input), palex_except::ParserError)
+    return 0;
+}
@@ -0,0 +1,95 @@
+#include <functional>
+#include <cstddef>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "util/palex_except.h"
+
+#include "bootstrap/BootstrapLexer.h"
+
+#include "input/PalexRuleParser.h"
+
+#include "parser_generator/validation.h"
+#include "parser_generator/production_definition.h"
+#include "parser_generator/operator_precedence.h"
+
+#include "parser_generator/shift_reduce_parsers/parser_table_generation.h"
+#include "parser_generator/shift_reduce_parsers/parser_state_comparators.h"
+
+#include "../test_utils.h"
+
+using parser_generator::shift_reduce_parsers::DebugParseTree;
+
+DebugParseTree binary(const std::string& left, const std::string& operator_token, const DebugParseTree& right) {
+    return DebugParseTree{"expr", {DebugParseTree{"expr", {DebugParseTree{left}}}, DebugParseTree{operator_token}, right}};
+}
+
+DebugParseTree binary(const DebugParseTree& left, const std::string& operator_token, const std::string& right) {
+    return DebugParseTree{"expr", {left, DebugParseTree{operator_token}, DebugParseTree{"expr", {DebugParseTree{right}}}}};
+}
+
+int main() {
+    using parser_generator::shift_reduce_parsers::ParserTable;
+    using parser_generator::shift_reduce_parsers::lalr_state_compare;
+    using parser_generator::shift_reduce_parsers::lr_state_compare;
+    using parser_generator::shift_reduce_parsers::lr_state_hash;
+
+    const char* input =
+        "INT = \"\\d+\";"
+        "EQ = \"=\";"
+        "ADD = \"\\+\";"
+        "MUL = \"\\*\";"
+        "POW = \"\\^\";"
+        "%nonassoc EQ;"
+        "%left ADD;"
+        "%left MUL;"
+        "%right POW;"
+        "$S = expr;"
+        "expr = expr EQ expr;"
+        "expr = expr ADD expr;"
+        "expr = expr MUL expr;"
+        "expr = expr POW expr;"
+        "expr = INT;"
+    ;
+    bootstrap::BootstrapLexer lexer(input);
+    input::PalexRuleParser parser(
+        std::bind(&bootstrap::BootstrapLexer::next_unignored_token, &lexer),
+        std::bind(&bootstrap::BootstrapLexer::get_token, &lexer)
+    );
+    const input::PalexRules rules = parser.parse_all_rules();
+    parser_generator::validate_productions(rules.productions);
+    const std::set<parser_generator::Production> productions(rules.productions.begin(), rules.productions.end());
+
+    // the flat grammar is ambiguous, so it only has a table once the precedence resolves the conflicts
+    TEST_EXCEPT(ParserTable::generate_lalr_1(productions, lalr_state_compare), std::runtime_error)
+    const std::vector<ParserTable> parser_tables = {
+        ParserTable::generate_lalr_1(productions, lalr_state_compare, rules.precedence_table),
+        ParserTable::generate(productions, lr_state_compare, 1, lr_state_hash, 1, rules.precedence_table),
+        ParserTable::generate(productions, lr_state_compare, 2, lr_state_hash, 1, rules.precedence_table)
+    };
+    const std::vector<std::string> mixed_input = {"INT", "ADD", "INT", "MUL", "INT", "ADD", "INT"};
+    const DebugParseTree mixed_tree{"$S", {binary(
+        DebugParseTree{"expr", {
+            DebugParseTree{"expr", {DebugParseTree{"INT"}}}, 
+            DebugParseTree{"ADD"}, 
+            binary("INT", "MUL", DebugParseTree{"expr", {DebugParseTree{"INT"}}})
+        }},
+        "ADD",
+        "INT"
+    )}};
+    const std::vector<std::string> power_input = {"INT", "POW", "INT", "POW", "INT"};
+    const DebugParseTree power_tree{"$S", {binary("INT", "POW", binary("INT", "POW", DebugParseTree{"expr", {DebugParseTree{"INT"}}}))}};
+    const std::vector<std::string> comparison_input = {"INT", "EQ", "INT", "EQ", "INT"};
+    for (const ParserTable& parser_table : parser_tables) {
+        TEST_TRUE(parser_table.debug_parse(mixed_input) == mixed_tree)
+        TEST_TRUE(parser_table.debug_parse(power_input) == power_tree)
+        TEST_EXCEPT(parser_table.debug_parse(comparison_input), palex_except::ParserError) // non-associative
+    }
+
+    // conflicts of tokens without precedence are still errors
+    parser_generator::PrecedenceTable_t partial_precedence = rules.precedence_table;
+    partial_precedence.erase("POW");
+    TEST_EXCEPT(ParserTable::generate_lalr_1(productions, lalr_state_compare, partial_precedence), std::runtime_error)
+    return 0;
+}
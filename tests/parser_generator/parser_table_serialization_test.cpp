@@ -0,0 +1,66 @@
+#include <functional>
+#include <cstddef>
+#include <stdexcept>
+#include <sstream>
+#include <set>
+
+#include "bootstrap/BootstrapLexer.h"
+
+#include "input/PalexRuleParser.h"
+
+#include "parser_generator/validation.h"
+#include "parser_generator/production_definition.h"
+
+#include "parser_generator/shift_reduce_parsers/parser_table_generation.h"
+#include "parser_generator/shift_reduce_parsers/parser_table_serialization.h"
+#include "parser_generator/shift_reduce_parsers/parser_state_comparators.h"
+
+#include "../test_utils.h"
+
+int main() {
+    using namespace parser_generator::shift_reduce_parsers;
+
+    constexpr size_t LOOKAHEAD = 1;
+    const char* input =
+        "$S = addition;\n"
+        "addition#add = addition ADD multiplication;\n"
+        "addition = multiplication;\n"
+        "multiplication = multiplication MUL number;\n"
+        "%transparent multiplication = number;\n"
+        "number = INT;\n"
+    ;
+    bootstrap::BootstrapLexer lexer(input);
+    input::PalexRuleParser parser(
+        std::bind(&bootstrap::BootstrapLexer::next_unignored_token, &lexer),
+        std::bind(&bootstrap::BootstrapLexer::get_token, &lexer)
+    ); 
+    const std::vector<parser_generator::Production> productions = parser.parse_all_rules().productions;
+    parser_generator::validate_productions(productions);
+    const ParserTable parser_table = ParserTable::generate(
+        std::set<parser_generator::Production>(productions.begin(), productions.end()),
+        lr_state_compare,
+        LOOKAHEAD
+    );
+
+    std::stringstream serialized_table;
+    write_parser_table(serialized_table, parser_table);
+    const std::string serialized = serialized_table.str();
+    const ParserTable read_table = read_parser_table(serialized_table, lr_state_compare);
+
+    TEST_TRUE(read_table.get_states() == parser_table.get_states())
+    const std::vector<std::string> tokens = {"INT", "ADD", "INT", "MUL", "INT", "END_OF_FILE"};
+    TEST_TRUE(read_table.debug_parse(tokens) == parser_table.debug_parse(tokens))
+
+    for (const parser_generator::Production& production : productions) {
+        std::stringstream serialized_production;
+        write_production(serialized_production, production);
+        const parser_generator::Production read = read_production(serialized_production);
+        TEST_TRUE(read == production)
+        TEST_TRUE(read.transparent == production.transparent)
+    }
+
+    std::stringstream truncated_table(serialized.substr(0, serialized.size() / 2));
+    TEST_EXCEPT(read_parser_table(truncated_table, lr_state_compare), std::runtime_error)
+
+    return 0;
+}
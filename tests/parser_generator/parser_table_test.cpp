@@ -101,5 +101,63 @@ int main() {
         std::cout << test_case.formatted_output;
         TEST_TRUE(output.str() == test_case.formatted_output)
     }
+
+    using parser_generator::shift_reduce_parsers::Action;
+    const parser_generator::shift_reduce_parsers::ParserTable lookahead_table = parser_generator::shift_reduce_parsers::ParserTable::generate(
+            productions_set,
+            parser_generator::shift_reduce_parsers::lalr_state_compare,
+            1
+    );
+    size_t default_reduction_count = 0;
+    for (size_t state = 0; state < lookahead_table.get_states().size(); state++) {
+        const std::optional<parser_generator::Production> default_reduction = lookahead_table.get_default_reduction(state);
+        if (!default_reduction.has_value()) {
+            continue;
+        }
+        default_reduction_count++;
+        TEST_FALSE(default_reduction.value().is_entry())
+        for (const Action& action : lookahead_table.get_states()[state].get_actions()) {
+            TEST_FALSE(std::holds_alternative<Action::ShiftParameters>(action.parameters))
+            if (std::holds_alternative<Action::ReduceParameters>(action.parameters)) {
+                TEST_TRUE(std::get<Action::ReduceParameters>(action.parameters).to_reduce == default_reduction.value())
+            }
+        }
+    }
+    TEST_TRUE(default_reduction_count == 3) // number = INT; multiplication = number; multiplication = multiplication MUL number
+
+    // the states and their ids mustn't depend on the number of threads generating them
+    for (const size_t lookahead : std::vector<size_t>{1, 2}) {
+        std::stringstream single_threaded_lalr, multi_threaded_lalr, single_threaded_lr, multi_threaded_lr;
+        single_threaded_lalr << parser_generator::shift_reduce_parsers::ParserTable::generate(
+            productions_set,
+            parser_generator::shift_reduce_parsers::lalr_state_compare,
+            lookahead,
+            parser_generator::shift_reduce_parsers::lalr_state_hash,
+            1
+        );
+        multi_threaded_lalr << parser_generator::shift_reduce_parsers::ParserTable::generate(
+            productions_set,
+            parser_generator::shift_reduce_parsers::lalr_state_compare,
+            lookahead,
+            parser_generator::shift_reduce_parsers::lalr_state_hash,
+            4
+        );
+        single_threaded_lr << parser_generator::shift_reduce_parsers::ParserTable::generate(
+            productions_set,
+            parser_generator::shift_reduce_parsers::lr_state_compare,
+            lookahead,
+            parser_generator::shift_reduce_parsers::lr_state_hash,
+            1
+        );
+        multi_threaded_lr << parser_generator::shift_reduce_parsers::ParserTable::generate(
+            productions_set,
+            parser_generator::shift_reduce_parsers::lr_state_compare,
+            lookahead,
+            parser_generator::shift_reduce_parsers::lr_state_hash,
+            4
+        );
+        TEST_TRUE(single_threaded_lalr.str() == multi_threaded_lalr.str())
+        TEST_TRUE(single_threaded_lr.str() == multi_threaded_lr.str())
+    }
     return 0;
 }
\ No newline at end of file
@@ -0,0 +1,75 @@
+#include <functional>
+#include <cstddef>
+#include <stdexcept>
+
+#include "bootstrap/BootstrapLexer.h"
+
+#include "input/PalexRuleParser.h"
+
+#include "parser_generator/validation.h"
+#include "parser_generator/production_definition.h"
+
+#include "parser_generator/shift_reduce_parsers/parser_table_generation.h"
+#include "parser_generator/shift_reduce_parsers/parser_state_comparators.h"
+
+#include "../test_utils.h"
+
+std::set<parser_generator::Production> parse_productions(const char* input) {
+    bootstrap::BootstrapLexer lexer(input);
+    input::PalexRuleParser parser(
+        std::bind(&bootstrap::BootstrapLexer::next_unignored_token, &lexer),
+        std::bind(&bootstrap::BootstrapLexer::get_token, &lexer)
+    );
+    const std::vector<parser_generator::Production> productions = parser.parse_all_rules().productions;
+    parser_generator::validate_productions(productions);
+    return std::set<parser_generator::Production>(productions.begin(), productions.end());
+}
+
+size_t count_states(const std::set<parser_generator::Production>& productions, const parser_generator::shift_reduce_parsers::ParserStateComparator_t& state_comparator) {
+    return parser_generator::shift_reduce_parsers::ParserTable::generate(
+        productions,
+        state_comparator,
+        1,
+        parser_generator::shift_reduce_parsers::lalr_state_hash
+    ).get_states().size();
+}
+
+int main() {
+    using parser_generator::shift_reduce_parsers::lalr_state_compare;
+    using parser_generator::shift_reduce_parsers::lr_state_compare;
+    using parser_generator::shift_reduce_parsers::pgm_state_compare;
+
+    // LR(1), but merging the states after 'A E' and 'B E' creates a reduce/reduce conflict between e and f
+    const std::set<parser_generator::Production> not_lalr_productions = parse_productions(
+        "$S = s;\n"
+        "s = A e C;\n"
+        "s = A f D;\n"
+        "s = B f C;\n"
+        "s = B e D;\n"
+        "s = LB list RB;\n"
+        "list = list COMMA item;\n"
+        "list = item;\n"
+        "item = ID;\n"
+        "item = LP list RP;\n"
+        "e = E;\n"
+        "f = E;\n"
+    );
+    TEST_EXCEPT(count_states(not_lalr_productions, lalr_state_compare), std::runtime_error)
+    const size_t lr_state_count = count_states(not_lalr_productions, lr_state_compare);
+    const size_t pgm_state_count = count_states(not_lalr_productions, pgm_state_compare);
+    TEST_TRUE(pgm_state_count < lr_state_count) // the lists inside brackets and parentheses still share their states
+
+    // on LALR(1) grammars, the canonical states with the same core are weakly compatible and get merged like in LALR
+    const std::set<parser_generator::Production> expression_productions = parse_productions(
+        "$S = addition;\n"
+        "addition = addition ADD multiplication;\n"
+        "addition = multiplication;\n"
+        "multiplication = multiplication MUL number;\n"
+        "multiplication = number;\n"
+        "number = INT;\n"
+        "number = LP addition RP;\n"
+    );
+    TEST_TRUE(count_states(expression_productions, pgm_state_compare) == count_states(expression_productions, lalr_state_compare))
+    TEST_TRUE(count_states(expression_productions, pgm_state_compare) < count_states(expression_productions, lr_state_compare))
+    return 0;
+}
@@ -22,7 +22,12 @@ int main() {
         {"addition = addition ADD number; number = INT;", true},
         {"$S = addition; addition = addition ADD unknown; number = INT;", true},
         {"$S = addition; addition = addition ADD number; number = INT; number = INT;", true},
-        {"$S = addition; add#ition = addition ADD number; addtion = number;", true}
+        {"$S = addition; add#ition = addition ADD number; addtion = number;", true},
+        {"$S = addition; addition = addition ADD number; %transparent addition = number; number = INT;", false},
+        {"$S = addition; %transparent addition = addition ADD number; number = INT;", true},   // more than one symbol
+        {"$S = addition; addition = addition ADD number; %transparent addition = INT;", true}, // forwards a token
+        {"$S = addition; addition = number; %transparent addition#tagged = number; number = INT;", true},
+        {"%transparent $S = addition; addition = INT;", true}
     };
 
     for (const TestCase& test : TEST_CASES) {
@@ -0,0 +1,38 @@
+#include <vector>
+#include <cstddef>
+
+#include "../test_utils.h"
+
+#include "parser_generator/shift_reduce_parsers/table_compression.h"
+
+int main() {
+    using namespace parser_generator::shift_reduce_parsers;
+
+    const size_t COLUMN_COUNT = 6;
+    const std::vector<TableRow_t> rows = {
+        {{0, 1}, {1, 2}, {2, 3}},
+        {{3, 4}, {5, 5}},
+        {},
+        {{0, 6}, {4, 7}},
+        {{1, 8}, {2, 9}, {3, 10}, {4, 11}}
+    };
+    const CompressedTable compressed = compress_table(rows, COLUMN_COUNT);
+
+    TEST_TRUE(compressed.row_offsets.size() == rows.size())
+    TEST_TRUE(compressed.values.size() == compressed.checks.size())
+    TEST_TRUE(compressed.values.size() < rows.size() * COLUMN_COUNT)
+    for (size_t row = 0; row < rows.size(); row++) {
+        TEST_TRUE(compressed.row_offsets[row] + COLUMN_COUNT <= compressed.checks.size())
+        for (size_t column = 0; column < COLUMN_COUNT; column++) {
+            const auto entry = rows[row].find(column);
+            const std::optional<size_t> value = lookup_compressed_entry(compressed, row, column);
+            TEST_TRUE(value.has_value() == (entry != rows[row].end()))
+            TEST_TRUE(!value.has_value() || value.value() == entry->second)
+        }
+    }
+
+    const CompressedTable empty = compress_table({}, 0);
+    TEST_TRUE(empty.row_offsets.empty())
+    TEST_TRUE(empty.values.size() == 1 && empty.checks.size() == 1)
+    return 0;
+}
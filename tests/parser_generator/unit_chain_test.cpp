@@ -0,0 +1,103 @@
+#include <functional>
+#include <cstddef>
+#include <string>
+#include <vector>
+
+#include "util/palex_except.h"
+
+#include "bootstrap/BootstrapLexer.h"
+
+#include "input/PalexRuleParser.h"
+
+#include "parser_generator/validation.h"
+#include "parser_generator/production_definition.h"
+
+#include "parser_generator/shift_reduce_parsers/parser_table_generation.h"
+#include "parser_generator/shift_reduce_parsers/parser_state_comparators.h"
+
+#include "../test_utils.h"
+
+std::set<parser_generator::Production> parse_productions(const char* input) {
+    bootstrap::BootstrapLexer lexer(input);
+    input::PalexRuleParser parser(
+        std::bind(&bootstrap::BootstrapLexer::next_unignored_token, &lexer),
+        std::bind(&bootstrap::BootstrapLexer::get_token, &lexer)
+    );
+    const std::vector<parser_generator::Production> productions = parser.parse_all_productions();
+    parser_generator::validate_productions(productions);
+    return std::set<parser_generator::Production>(productions.begin(), productions.end());
+}
+
+int main() {
+    using parser_generator::shift_reduce_parsers::DebugParseTree;
+    using parser_generator::shift_reduce_parsers::ParserTable;
+    using parser_generator::shift_reduce_parsers::lalr_state_compare;
+    using parser_generator::shift_reduce_parsers::lalr_state_hash;
+    using parser_generator::shift_reduce_parsers::lr_state_compare;
+    using parser_generator::shift_reduce_parsers::lr_state_hash;
+
+    const std::set<parser_generator::Production> chain_productions = parse_productions(
+        "$S = expression;"
+        "expression = addition;"
+        "addition = addition ADD multiplication;"
+        "addition = multiplication;"
+        "multiplication = multiplication MUL number;"
+        "multiplication = number;"
+        "number = INT;"
+    );
+    const std::set<parser_generator::Production> transparent_productions = parse_productions(
+        "$S = expression;"
+        "%transparent expression = addition;"
+        "addition = addition ADD multiplication;"
+        "%transparent addition = multiplication;"
+        "multiplication = multiplication MUL number;"
+        "%transparent multiplication = number;"
+        "number = INT;"
+    );
+
+    const std::vector<std::string> token_names = {"INT", "ADD", "INT", "MUL", "INT"};
+    const ParserTable chain_table = ParserTable::generate_lalr_1(chain_productions, lalr_state_compare);
+    const std::vector<ParserTable> transparent_tables = {
+        ParserTable::generate_lalr_1(transparent_productions, lalr_state_compare),
+        ParserTable::generate(transparent_productions, lalr_state_compare, 1, lalr_state_hash),
+        ParserTable::generate(transparent_productions, lr_state_compare, 1, lr_state_hash),
+        ParserTable::generate(transparent_productions, lr_state_compare, 2, lr_state_hash)
+    };
+    // only the reductions that don't depend on the lookahead are skipped, the others still produce a node
+    const DebugParseTree transparent_tree{"$S", {DebugParseTree{"expression", {DebugParseTree{"addition", {
+        DebugParseTree{"addition", {DebugParseTree{"number", {DebugParseTree{"INT"}}}}},
+        DebugParseTree{"ADD"},
+        DebugParseTree{"multiplication", {
+            DebugParseTree{"number", {DebugParseTree{"INT"}}},
+            DebugParseTree{"MUL"},
+            DebugParseTree{"number", {DebugParseTree{"INT"}}}
+        }}
+    }}}}}};
+    for (const ParserTable& transparent_table : transparent_tables) {
+        TEST_TRUE(transparent_table.debug_parse(token_names) == transparent_tree)
+        TEST_EXCEPT(transparent_table.debug_parse(std::vector<std::string>{"INT", "ADD"}), palex_except::ParserError)
+    }
+    TEST_TRUE(transparent_tables[0].get_states().size() < chain_table.get_states().size())
+    TEST_TRUE(transparent_tables[0].get_states().size() == transparent_tables[1].get_states().size())
+
+    // without transparent productions the table stays the same
+    TEST_TRUE(chain_table.with_bypassed_unit_reductions().get_states() == chain_table.get_states())
+    TEST_FALSE(chain_table.debug_parse(token_names) == transparent_tree)
+
+    // chains of transparent productions are skipped as a whole
+    const std::set<parser_generator::Production> nested_productions = parse_productions(
+        "$S = list;"
+        "list = list item;"
+        "list = item;"
+        "%transparent item = value;"
+        "%transparent value = literal;"
+        "literal = INT;"
+    );
+    const ParserTable nested_table = ParserTable::generate_lalr_1(nested_productions, lalr_state_compare);
+    const DebugParseTree nested_tree{"$S", {DebugParseTree{"list", {
+        DebugParseTree{"list", {DebugParseTree{"literal", {DebugParseTree{"INT"}}}}},
+        DebugParseTree{"literal", {DebugParseTree{"INT"}}}
+    }}}};
+    TEST_TRUE(nested_table.debug_parse(std::vector<std::string>{"INT", "INT"}) == nested_tree)
+    return 0;
+}
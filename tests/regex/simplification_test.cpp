@@ -0,0 +1,46 @@
+#include <vector>
+#include <string_view>
+#include <sstream>
+#include <memory>
+
+#include "regex/RegexParser.h"
+#include "regex/regex_simplification.h"
+
+#include "../test_utils.h"
+
+std::string debug_string(const regex::RegexBase* const regex);
+
+std::string debug_string(const regex::RegexBase* const regex) {
+    std::stringstream output;
+    regex->debug(output);
+    return output.str();
+}
+
+int main() {
+    const std::vector<std::pair<std::string_view, std::string_view>> TEST_CASES = {
+        {"abc", "abc"},
+        {"(ab)(c)", "abc"},
+        {"a|b|[c-e]", "[a-e]"},
+        {"(a|b)|c", "[a-c]"},
+        {"ab|(c|d)", "[cd]|ab"},
+        {"(a*)*", "a*"},
+        {"(a+)+", "a+"},
+        {"(a?)?", "a?"},
+        {"(a+)*", "a*"},
+        {"(a*)?", "a*"},
+        {"(a?)+", "a*"},
+        {"a{1}", "a"},
+        {"(ab){1,1}c", "abc"},
+        {"(a{2,3})*", "(a{2,3})*"}
+    };
+
+    for (const std::pair<std::string_view, std::string_view>& test : TEST_CASES) {
+        const std::unique_ptr<regex::RegexBase> simplified = regex::simplify_regex(regex::RegexParser(test.first).parse_regex().get());
+        TEST_TRUE(debug_string(simplified.get()) == debug_string(regex::RegexParser(test.second).parse_regex().get()))
+    }
+
+    TEST_TRUE(regex::is_empty_sequence(regex::simplify_regex(regex::RegexParser("a{0}").parse_regex().get()).get()))
+    TEST_FALSE(regex::is_empty_sequence(regex::simplify_regex(regex::RegexParser("a{0,1}").parse_regex().get()).get()))
+    
+    return 0;
+}
@@ -0,0 +1,18 @@
+#include <string>
+
+#include "templates/amalgamation.h"
+
+#include "../test_utils.h"
+
+int main() {
+    const std::string amalgamation = templates::amalgamate_sources(
+        {
+            "#pragma once\n#include <string>\n#include \"utf8.h\"\nint a();",
+            "#include \"Test.h\"\n#include \"Other.h\"\nint a() { return 0; }"
+        },
+        {{"utf8.h", ""}, {"Test.h", ""}, {"Other.h", "TestLexer.h"}}
+    );
+    TEST_TRUE(amalgamation == "#pragma once\n\n#include <string>\nint a();\n\n#include \"TestLexer.h\"\nint a() { return 0; }\n")
+    TEST_TRUE(templates::amalgamate_sources({}, {}) == "#pragma once\n")
+    return 0;
+}
@@ -0,0 +1,38 @@
+#include <sstream>
+#include <stdexcept>
+
+#include "templates/template_completion.h"
+
+#include "../test_utils.h"
+
+int main() {
+    const templates::CompiledTemplate compiled("a b %NAME% c %NAME%%OTHER% %%");
+    const templates::TemplateView view = compiled;
+
+    TEST_TRUE(view.tag_count == 2)
+    TEST_TRUE(view.tags[0] == "NAME" && view.tags[1] == "OTHER")
+    TEST_TRUE(view.segment_count == 6)
+    TEST_TRUE(view.segments[0].content == "a b " && view.segments[0].tag_index == templates::TEXT_SEGMENT)
+    TEST_TRUE(view.segments[1].tag_index == 0)
+    TEST_TRUE(view.segments[2].content == " c " && view.segments[2].tag_index == templates::TEXT_SEGMENT)
+    TEST_TRUE(view.segments[3].tag_index == 0)
+    TEST_TRUE(view.segments[4].tag_index == 1)
+
+    std::stringstream output;
+    templates::write_template_to_stream(
+        compiled,
+        output,
+        std::map<std::string_view, templates::TemplateCompleter_t>{
+            {"NAME", templates::constant_completer("x")},
+            {"OTHER", templates::constant_completer("y")}
+        }
+    );
+    TEST_TRUE(output.str() == "a b x c xy %")
+
+    TEST_EXCEPT(templates::write_template_to_stream(compiled, output, {{"NAME", templates::EMPTY_COMPLETER}}), std::runtime_error)
+
+    const templates::CompiledTemplate empty("");
+    TEST_TRUE(static_cast<templates::TemplateView>(empty).segment_count == 0)
+
+    return 0;
+}
@@ -0,0 +1,58 @@
+#include <string>
+#include <fstream>
+#include <sstream>
+#include <filesystem>
+#include <chrono>
+#include <iterator>
+
+#include "templates/template_completion.h"
+
+#include "util/stream_format.h"
+
+#include "../test_utils.h"
+
+std::string read_file(const std::filesystem::path& path);
+
+std::string read_file(const std::filesystem::path& path) {
+    std::ifstream input(path);
+    std::stringstream content;
+    content << input.rdbuf();
+    return content.str();
+}
+
+int main() {
+    const std::filesystem::path output_directory = std::filesystem::temp_directory_path() / "palex_template_file_output_test";
+    const std::filesystem::path output_path = output_directory / "output.txt";
+    const std::map<std::string_view, templates::TemplateCompleter_t> completers = {
+        {
+            "BODY", 
+            [](std::ostream& output) { 
+                output << sfmt::Indentation{1} << "indented\nlines" << sfmt::Indentation{-1}; 
+            }
+        }
+    };
+    std::filesystem::remove_all(output_directory);
+    std::filesystem::create_directories(output_directory);
+
+    templates::write_template_to_file("begin\n%BODY%\nend %%", output_path.string(), completers);
+    TEST_TRUE(read_file(output_path) == "begin\n    indented\n    lines\nend %")
+
+    // rewriting the same content mustn't touch the file
+    const std::filesystem::file_time_type old_time = std::filesystem::last_write_time(output_path) - std::chrono::hours(1);
+    std::filesystem::last_write_time(output_path, old_time);
+    templates::write_template_to_file("begin\n%BODY%\nend %%", output_path.string(), completers);
+    TEST_TRUE(std::filesystem::last_write_time(output_path) == old_time)
+
+    templates::write_template_to_file("changed %BODY%", output_path.string(), completers);
+    TEST_TRUE(read_file(output_path) == "changed indented\n    lines")
+    TEST_TRUE(std::distance(std::filesystem::directory_iterator(output_directory), std::filesystem::directory_iterator()) == 1)
+
+    // the temporary file is removed, even if it can't replace the output
+    std::filesystem::remove(output_path);
+    std::filesystem::create_directories(output_path / "blocking");
+    TEST_EXCEPT(templates::write_string_to_file("content", output_path.string()), std::filesystem::filesystem_error)
+    TEST_TRUE(std::distance(std::filesystem::directory_iterator(output_directory), std::filesystem::directory_iterator()) == 1)
+
+    std::filesystem::remove_all(output_directory);
+    return 0;
+}
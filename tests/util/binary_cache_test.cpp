@@ -0,0 +1,59 @@
+#include <sstream>
+#include <string>
+#include <filesystem>
+#include <fstream>
+#include <stdexcept>
+#include <vector>
+#include <iterator>
+
+#include "util/binary_cache.h"
+
+#include "../test_utils.h"
+
+int main() {
+    std::stringstream serialized;
+    bcache::write_uint(serialized, 0);
+    bcache::write_uint(serialized, 0x0123456789abcdef);
+    bcache::write_string(serialized, "");
+    bcache::write_string(serialized, std::string("with\0zero", 9));
+    TEST_TRUE(serialized.str().size() == 4 * 8 + 9)
+    TEST_TRUE(bcache::read_uint(serialized) == 0)
+    TEST_TRUE(bcache::read_uint(serialized) == 0x0123456789abcdef)
+    TEST_TRUE(bcache::read_string(serialized).empty())
+    TEST_TRUE(bcache::read_string(serialized) == std::string("with\0zero", 9))
+    TEST_EXCEPT(bcache::read_uint(serialized), std::runtime_error)
+
+    TEST_TRUE(bcache::hash_content("") == 0xcbf29ce484222325)
+    TEST_TRUE(bcache::hash_content("a") == 0xaf63dc4c8601ec8c)
+
+    const std::filesystem::path cache_path = std::filesystem::temp_directory_path() / "palex_binary_cache_test";
+    std::filesystem::remove_all(cache_path);
+
+    TEST_FALSE(bcache::load_entry(cache_path.string(), "test", "key").has_value())
+    bcache::store_entry(cache_path.string(), "test", "key", "data");
+    TEST_TRUE(bcache::load_entry(cache_path.string(), "test", "key") == "data")
+    TEST_FALSE(bcache::load_entry(cache_path.string(), "other", "key").has_value())
+    bcache::store_entry(cache_path.string(), "test", "key", "new data");
+    TEST_TRUE(bcache::load_entry(cache_path.string(), "test", "key") == "new data")
+
+    // the temporary files are removed, even if the entry can't replace the existing one
+    std::vector<std::filesystem::path> entry_paths;
+    for (const std::filesystem::directory_entry& entry : std::filesystem::directory_iterator(cache_path)) {
+        entry_paths.push_back(entry.path());
+    }
+    TEST_TRUE(entry_paths.size() == 1)
+    std::filesystem::remove(entry_paths.front());
+    std::filesystem::create_directories(entry_paths.front() / "blocking");
+    TEST_EXCEPT(bcache::store_entry(cache_path.string(), "test", "key", "data"), std::filesystem::filesystem_error)
+    TEST_TRUE(std::distance(std::filesystem::directory_iterator(cache_path), std::filesystem::directory_iterator()) == 1)
+    std::filesystem::remove_all(entry_paths.front());
+    bcache::store_entry(cache_path.string(), "test", "key", "new data");
+
+    for (const std::filesystem::directory_entry& entry : std::filesystem::directory_iterator(cache_path)) {
+        std::filesystem::resize_file(entry.path(), 12); // damaged entries are ignored
+    }
+    TEST_FALSE(bcache::load_entry(cache_path.string(), "test", "key").has_value())
+
+    std::filesystem::remove_all(cache_path);
+    return 0;
+}
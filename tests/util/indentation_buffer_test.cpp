@@ -0,0 +1,37 @@
+#include <sstream>
+#include <string>
+
+#include "util/stream_format.h"
+
+#include "../test_utils.h"
+
+int main() {
+    const std::string text = "first line\n\nsecond line\nthird";
+
+    std::stringstream bulk_output;
+    {
+        sfmt::IndentationStreamBuffer indentation_buffer(bulk_output);
+        bulk_output << sfmt::Indentation{2} << text << sfmt::Indentation{-1} << "\nlast\n";
+    }
+    TEST_TRUE(bulk_output.str() == "        first line\n\n        second line\n        third\n    last\n")
+
+    std::stringstream char_output;
+    {
+        sfmt::IndentationStreamBuffer indentation_buffer(char_output);
+        char_output << sfmt::Indentation{2};
+        for (const char curr : text) {
+            char_output.put(curr);
+        }
+        char_output << sfmt::Indentation{-1} << "\nlast\n";
+    }
+    TEST_TRUE(char_output.str() == bulk_output.str())
+
+    std::stringstream wide_output;
+    {
+        sfmt::IndentationStreamBuffer indentation_buffer(wide_output, 10);
+        wide_output << sfmt::Indentation{10} << "x";
+    }
+    TEST_TRUE(wide_output.str() == std::string(100, ' ') + "x")
+
+    return 0;
+}
@@ -0,0 +1,46 @@
+#include <cstddef>
+#include <vector>
+#include <atomic>
+#include <stdexcept>
+#include <string>
+
+#include "util/thread_pool.h"
+
+#include "../test_utils.h"
+
+int main() {
+    TEST_TRUE(tpool::resolve_thread_count(3) == 3)
+    TEST_TRUE(tpool::resolve_thread_count(0) >= 1)
+
+    for (const size_t thread_count : std::vector<size_t>{1, 4}) {
+        tpool::ThreadPool thread_pool(thread_count);
+        TEST_TRUE(thread_pool.get_thread_count() == thread_count)
+        for (size_t batch = 0; batch < 8; batch++) { // the workers have to pick up every batch, not only the first one
+            std::vector<size_t> results(100, 0);
+            std::atomic<size_t> executed_tasks = 0;
+            thread_pool.run(results.size(), [&](const size_t task_id) -> void {
+                results[task_id] = task_id * task_id;
+                executed_tasks++;
+            });
+            TEST_TRUE(executed_tasks == results.size())
+            for (size_t task_id = 0; task_id < results.size(); task_id++) {
+                TEST_TRUE(results[task_id] == task_id * task_id)
+            }
+        }
+        thread_pool.run(0, [](const size_t) -> void {});
+
+        // the failure of the first failing task is reported, no matter which task failed first in time
+        std::string failure;
+        try {
+            thread_pool.run(50, [](const size_t task_id) -> void {
+                if (task_id % 10 == 7) {
+                    throw std::runtime_error(std::to_string(task_id));
+                }
+            });
+        } catch (const std::runtime_error& err) {
+            failure = err.what();
+        }
+        TEST_TRUE(failure == "7")
+    }
+    return 0;
+}